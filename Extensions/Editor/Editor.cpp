@@ -491,8 +491,7 @@ void Editor::ProjectLoaded()
 
   SafeDelete(mProjectDirectoryWatcher);
   mProjectDirectoryWatcher = new EventDirectoryWatcher(mProjectLibrary->SourcePath);
-  ConnectThisTo(mProjectDirectoryWatcher, Events::FileModified, OnProjectFileModified);
-  ConnectThisTo(mProjectDirectoryWatcher, Events::FileRenamed, OnProjectFileModified);
+  ConnectThisTo(mProjectDirectoryWatcher, Events::FilesChanged, OnProjectFilesChanged);
 
   ObjectEvent event(projectCog);
   this->DispatchEvent(Events::ProjectLoaded, &event);
@@ -739,7 +738,7 @@ EditorMode::Enum Editor::GetEditMode()
   return cameraController->GetEditMode();
 }
 
-void Editor::OnProjectFileModified(FileEditEvent* e)
+void Editor::OnProjectFilesChanged(FileBatchEvent* e)
 {
   EditorSettings* settings = Z::gEngine->GetConfigCog()->has(EditorSettings);
   if(!settings->mAutoUpdateContentChanges)
@@ -748,18 +747,25 @@ void Editor::OnProjectFileModified(FileEditEvent* e)
   if(mProjectLibrary == nullptr)
     return;
 
-  // Walk through each content item in the loaded library and find any
-  // files we need to reload
-  forRange(ContentItem* contentItem, mProjectLibrary->GetContentItems())
+  // Only modified and renamed files can change existing content items
+  Array<String> changedFiles;
+  forRange(DirectoryWatcher::FileOperationInfo& info, e->Operations.All())
   {
-    if(contentItem->Filename == e->FileName)
-    {
-      String filePath = contentItem->GetFullPath();
+    if(info.Operation == DirectoryWatcher::Modified || info.Operation == DirectoryWatcher::Renamed)
+      changedFiles.PushBack(info.FileName);
+  }
 
-      // Don't reload it if we were the one that modified it
-      if(!FileModifiedState::HasModifiedSinceTime(filePath, e->TimeStamp))
-        ReloadContentItem(contentItem);
-    }
+  // Rebuild only the content items touched by this change set
+  ContentItemArray changedItems;
+  Z::gContentSystem->FindChangedContentItems(mProjectLibrary, changedFiles, changedItems);
+
+  forRange(ContentItem* contentItem, changedItems.All())
+  {
+    String filePath = contentItem->GetFullPath();
+
+    // Don't reload it if we were the one that modified it
+    if(!FileModifiedState::HasModifiedSinceTime(filePath, e->TimeStamp))
+      ReloadContentItem(contentItem);
   }
 }
 
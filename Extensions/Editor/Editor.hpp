@@ -37,6 +37,7 @@ class ZilchCompiledEvent;
 class CogCommandManager;
 class EventDirectoryWatcher;
 class FileEditEvent;
+class FileBatchEvent;
 class CodeTranslatorListener;
 class WebBrowserWidget;
 class CameraViewport;
@@ -106,7 +107,7 @@ public:
   /// Gets the edit mode for the current levels editor camera controller
   EditorMode::Enum GetEditMode();
 
-  void OnProjectFileModified(FileEditEvent* e);
+  void OnProjectFilesChanged(FileBatchEvent* e);
 
   OsWindow* mOsWindow;
   MainWindow* mMainWindow;
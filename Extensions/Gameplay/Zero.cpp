@@ -211,7 +211,7 @@ ZilchScriptConnection::~ZilchScriptConnection()
   // connection to be the only thing keeping an object alive. Cannot destruct the object during the
   // event connection destruction because it will also invoke destruction of the event connection
   // being destructed right now.
-  sDelayDestructDelegates.PushBack(mDelegate);
+  AddDelayDestructDelegate(mDelegate);
 }
 
 //**************************************************************************************************
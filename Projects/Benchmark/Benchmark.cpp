@@ -0,0 +1,362 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file Benchmark.cpp
+/// Implementation of the benchmark suite.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+#include "Support/ProfileCounter.hpp"
+
+// Results are written as:
+//   {"Version":1,"Warmups":<runs>,"Samples":<runs>,"Scenarios":[
+//     {"Name":"<area>.<scenario>","Seed":<seed>,"Skipped":false,"MinMs":..,"MedianMs":..,
+//      "MeanMs":..,"MaxMs":..,"Counters":{"<counter>":<average per sample>},
+//      "BaselineMs":..,"ChangePercent":..,"Regressed":false}]}
+// The baseline fields are only there when a baseline was given. Any results file
+// can be used as the baseline of a later run, only the names and medians are read.
+
+namespace Zero
+{
+
+// Fixed step used by every scenario that steps a space
+const float cBenchmarkDt = 1.0f / 60.0f;
+
+// Created the first time a scenario needs a space
+GameSession* gBenchmarkGame = nullptr;
+
+//------------------------------------------------------------ Benchmark Scenario
+BenchmarkScenario::BenchmarkScenario(StringParam name, uint seed)
+{
+  mName = name;
+  mSeed = seed;
+  mRandom.SetSeed(seed);
+}
+
+Space* CreateBenchmarkSpace()
+{
+  if(gBenchmarkGame == nullptr)
+  {
+    gBenchmarkGame = Z::gEngine->CreateGameSession();
+    gBenchmarkGame->SetInEditor(false);
+  }
+
+  return gBenchmarkGame->CreateSpace(ArchetypeManager::Find(CoreArchetypes::Space));
+}
+
+void DestroyBenchmarkSpace(Space* space)
+{
+  space->Destroy();
+  Z::gTracker->ClearDeletedObjects();
+}
+
+void StepBenchmarkSpace(Space* space, uint frames)
+{
+  TimeSpace* timeSpace = space->has(TimeSpace);
+  for(uint i = 0; i < frames; ++i)
+    timeSpace->Update(cBenchmarkDt);
+}
+
+//-------------------------------------------------------------- Benchmark Result
+BenchmarkResult::BenchmarkResult()
+{
+  Seed = 0;
+  Skipped = false;
+  Samples = 0;
+  MinMs = 0.0;
+  MedianMs = 0.0;
+  MeanMs = 0.0;
+  MaxMs = 0.0;
+  HasBaseline = false;
+  BaselineMs = 0.0;
+  ChangePercent = 0.0;
+  Regressed = false;
+}
+
+//--------------------------------------------------------------- Benchmark Suite
+struct BenchmarkCounterSorter
+{
+  bool operator()(const BenchmarkCounter& lhs, const BenchmarkCounter& rhs)
+  {
+    return lhs.Name < rhs.Name;
+  }
+};
+
+BenchmarkSuite::BenchmarkSuite()
+{
+  mWarmups = cDefaultBenchmarkWarmups;
+  mSamples = cDefaultBenchmarkSamples;
+}
+
+BenchmarkSuite::~BenchmarkSuite()
+{
+  DeleteObjectsInContainer(mScenarios);
+}
+
+void BenchmarkSuite::Add(BenchmarkScenario* scenario)
+{
+  mScenarios.PushBack(scenario);
+}
+
+void BenchmarkSuite::Run(StringParam filter, bool contentLoaded)
+{
+  mResults.Clear();
+
+  forRange(BenchmarkScenario* scenario, mScenarios.All())
+  {
+    if(!filter.Empty() && !scenario->mName.Contains(filter))
+      continue;
+
+    BenchmarkResult& result = mResults.PushBack();
+    result.Name = scenario->mName;
+    result.Seed = scenario->mSeed;
+
+    if(scenario->RequiresContent() && !contentLoaded)
+    {
+      ZPrint("Skipping %s (needs the ZeroCore content, see -data).\n", scenario->mName.c_str());
+      result.Skipped = true;
+      continue;
+    }
+
+    ZPrint("Running %s...\n", scenario->mName.c_str());
+    RunScenario(scenario, result);
+  }
+}
+
+void BenchmarkSuite::RunScenario(BenchmarkScenario* scenario, BenchmarkResult& result)
+{
+  // Same random sequence no matter what ran before
+  scenario->mRandom.SetSeed(scenario->mSeed);
+  scenario->Setup();
+
+  for(uint i = 0; i < mWarmups; ++i)
+    scenario->Run();
+
+  // Counters are latched around each sample so they only count the scenario
+  HashMap<String, double> counterTotals;
+  Array<double> samples;
+  Timer timer;
+
+  for(uint i = 0; i < mSamples; ++i)
+  {
+    Profile::EndCounterFrame();
+
+    timer.Reset();
+    scenario->Run();
+    samples.PushBack(timer.UpdateAndGetTime() * 1000.0);
+
+    Profile::EndCounterFrame();
+    for(Profile::CounterRecord* counter = Profile::GetFirstCounter(); counter != nullptr; counter = counter->GetNext())
+    {
+      if(counter->GetFrameValue() != 0)
+        counterTotals[counter->GetName()] += double(counter->GetFrameValue());
+    }
+  }
+
+  scenario->Teardown();
+
+  if(samples.Empty())
+    return;
+
+  Sort(samples.All());
+  result.Samples = samples.Size();
+  result.MinMs = samples.Front();
+  result.MaxMs = samples.Back();
+  result.MedianMs = samples[samples.Size() / 2];
+
+  double total = 0.0;
+  forRange(double sample, samples.All())
+    total += sample;
+  result.MeanMs = total / double(samples.Size());
+
+  forRange(auto& entry, counterTotals.All())
+  {
+    BenchmarkCounter& counter = result.Counters.PushBack();
+    counter.Name = entry.first;
+    counter.Value = entry.second / double(samples.Size());
+  }
+  Sort(result.Counters.All(), BenchmarkCounterSorter());
+}
+
+bool BenchmarkSuite::CompareToBaseline(StringParam baselineFile, float tolerancePercent)
+{
+  Zilch::CompilationErrors errors;
+  Zilch::JsonValue* root = Zilch::JsonReader::ReadIntoTreeFromFile(errors, baselineFile, nullptr);
+  if(root == nullptr)
+  {
+    ZPrint("Failed to read the baseline '%s'.\n", baselineFile.c_str());
+    return false;
+  }
+
+  Zilch::JsonValue* scenarios = root->GetMember("Scenarios", Zilch::JsonErrorMode::DefaultValue);
+  if(scenarios == nullptr)
+  {
+    ZPrint("The baseline '%s' has no scenarios.\n", baselineFile.c_str());
+    delete root;
+    return false;
+  }
+
+  HashMap<String, double> baselineMedians;
+  Array<String> baselineOrder;
+  forRange(Zilch::JsonValue* scenario, scenarios->ArrayElements.All())
+  {
+    if(scenario->MemberAsBool("Skipped", false, Zilch::JsonErrorMode::DefaultValue))
+      continue;
+
+    String name = scenario->MemberAsString("Name", String(), Zilch::JsonErrorMode::DefaultValue);
+    baselineMedians[name] = scenario->MemberAsDouble("MedianMs", 0.0, Zilch::JsonErrorMode::DefaultValue);
+    baselineOrder.PushBack(name);
+  }
+  delete root;
+
+  // A scenario the baseline timed that this run did not would otherwise pass silently
+  mMissingScenarios.Clear();
+  forRange(String& name, baselineOrder.All())
+  {
+    BenchmarkResult* result = nullptr;
+    forRange(BenchmarkResult& current, mResults.All())
+    {
+      if(current.Name == name)
+        result = &current;
+    }
+
+    bool exists = false;
+    forRange(BenchmarkScenario* scenario, mScenarios.All())
+    {
+      if(scenario->mName == name)
+        exists = true;
+    }
+
+    // Left out by the filter
+    if(exists && result == nullptr)
+      continue;
+
+    if(!exists || result->Skipped)
+      mMissingScenarios.PushBack(name);
+  }
+
+  forRange(BenchmarkResult& result, mResults.All())
+  {
+    double* baselineMs = baselineMedians.FindPointer(result.Name);
+    if(result.Skipped || baselineMs == nullptr || *baselineMs <= 0.0)
+      continue;
+
+    result.HasBaseline = true;
+    result.BaselineMs = *baselineMs;
+    result.ChangePercent = (result.MedianMs - result.BaselineMs) / result.BaselineMs * 100.0;
+    result.Regressed = result.ChangePercent > tolerancePercent;
+  }
+
+  return true;
+}
+
+uint BenchmarkSuite::GetRegressionCount()
+{
+  uint count = 0;
+  forRange(BenchmarkResult& result, mResults.All())
+  {
+    if(result.Regressed)
+      ++count;
+  }
+  return count;
+}
+
+String BenchmarkSuite::ToJson()
+{
+  Zilch::JsonBuilder builder;
+  builder.Begin(Zilch::JsonType::Object);
+  builder.Key("Version");
+  builder.Value(1);
+  builder.Key("Warmups");
+  builder.Value(mWarmups);
+  builder.Key("Samples");
+  builder.Value(mSamples);
+
+  builder.Key("Scenarios");
+  builder.Begin(Zilch::JsonType::ArrayMultiLine);
+  forRange(BenchmarkResult& result, mResults.All())
+  {
+    builder.Begin(Zilch::JsonType::Object);
+    builder.Key("Name");
+    builder.Value(result.Name);
+    builder.Key("Seed");
+    builder.Value(result.Seed);
+    builder.Key("Skipped");
+    builder.Value(result.Skipped);
+
+    if(!result.Skipped)
+    {
+      builder.Key("MinMs");
+      builder.Value(result.MinMs);
+      builder.Key("MedianMs");
+      builder.Value(result.MedianMs);
+      builder.Key("MeanMs");
+      builder.Value(result.MeanMs);
+      builder.Key("MaxMs");
+      builder.Value(result.MaxMs);
+
+      builder.Key("Counters");
+      builder.Begin(Zilch::JsonType::Object);
+      forRange(BenchmarkCounter& counter, result.Counters.All())
+      {
+        builder.Key(counter.Name);
+        builder.Value(counter.Value);
+      }
+      builder.End();
+    }
+
+    if(result.HasBaseline)
+    {
+      builder.Key("BaselineMs");
+      builder.Value(result.BaselineMs);
+      builder.Key("ChangePercent");
+      builder.Value(result.ChangePercent);
+      builder.Key("Regressed");
+      builder.Value(result.Regressed);
+    }
+    builder.End();
+  }
+  builder.End();
+
+  builder.End();
+  return builder.ToString();
+}
+
+bool BenchmarkSuite::WriteResults(StringParam fileName)
+{
+  String json = ToJson();
+
+  File file;
+  if(!file.Open(fileName, FileMode::Write, FileAccessPattern::Sequential))
+  {
+    ZPrint("Failed to write the results to '%s'.\n", fileName.c_str());
+    return false;
+  }
+
+  file.Write((byte*)json.Data(), json.SizeInBytes());
+  file.Close();
+  return true;
+}
+
+void BenchmarkSuite::PrintResults()
+{
+  ZPrint("\n%-32s %10s %10s %10s %10s\n", "Scenario", "Median ms", "Min ms", "Max ms", "Change");
+  forRange(BenchmarkResult& result, mResults.All())
+  {
+    if(result.Skipped)
+    {
+      ZPrint("%-32s %10s\n", result.Name.c_str(), "skipped");
+      continue;
+    }
+
+    String change = "-";
+    if(result.HasBaseline)
+      change = String::Format("%+.1f%%%s", result.ChangePercent, result.Regressed ? " !" : "");
+
+    ZPrint("%-32s %10.3f %10.3f %10.3f %10s\n", result.Name.c_str(), result.MedianMs, result.MinMs,
+           result.MaxMs, change.c_str());
+  }
+  ZPrint("\n");
+}
+
+}//namespace Zero
@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file Benchmark.hpp
+/// Declaration of the benchmark scenarios and the suite that runs them.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace Zero
+{
+
+/// Samples taken of each scenario when no count is given.
+const uint cDefaultBenchmarkSamples = 15;
+/// Runs made (and thrown away) before the samples are taken.
+const uint cDefaultBenchmarkWarmups = 3;
+/// How much slower (in percent) a median can be than the baseline before it's a regression.
+const float cDefaultBenchmarkTolerance = 10.0f;
+
+//------------------------------------------------------------ Benchmark Scenario
+/// A repeatable piece of work that is timed. Setup builds the scenario from the
+/// seed, every call to Run is one timed sample and Teardown cleans up. Anything
+/// random must come from mRandom so every run of the suite does the same work.
+class BenchmarkScenario
+{
+public:
+  BenchmarkScenario(StringParam name, uint seed);
+  virtual ~BenchmarkScenario() {}
+
+  /// Scenarios that create cogs need the ZeroCore content (archetypes, physics
+  /// materials...) and are skipped when it wasn't loaded.
+  virtual bool RequiresContent() { return false; }
+
+  virtual void Setup() {}
+  virtual void Run() = 0;
+  virtual void Teardown() {}
+
+  String mName;
+  uint mSeed;
+  Math::Random mRandom;
+};
+
+/// Creates a space in the benchmark game session (content must be loaded).
+Space* CreateBenchmarkSpace();
+/// Destroys the space and everything in it right away.
+void DestroyBenchmarkSpace(Space* space);
+/// Steps the space's time space a fixed 60hz frame.
+void StepBenchmarkSpace(Space* space, uint frames);
+
+//-------------------------------------------------------------- Benchmark Result
+struct BenchmarkCounter
+{
+  String Name;
+  // Average value per sample
+  double Value;
+};
+
+struct BenchmarkResult
+{
+  BenchmarkResult();
+
+  String Name;
+  uint Seed;
+  bool Skipped;
+  uint Samples;
+  double MinMs;
+  double MedianMs;
+  double MeanMs;
+  double MaxMs;
+  Array<BenchmarkCounter> Counters;
+
+  // Set when the baseline had the scenario
+  bool HasBaseline;
+  double BaselineMs;
+  double ChangePercent;
+  bool Regressed;
+};
+
+//--------------------------------------------------------------- Benchmark Suite
+class BenchmarkSuite
+{
+public:
+  BenchmarkSuite();
+  ~BenchmarkSuite();
+
+  /// The suite owns the scenario.
+  void Add(BenchmarkScenario* scenario);
+
+  /// Runs every scenario whose name contains the filter (all of them if it's empty).
+  void Run(StringParam filter, bool contentLoaded);
+
+  /// Compares the medians against a results file written by an earlier run.
+  /// Returns false if the baseline couldn't be read.
+  bool CompareToBaseline(StringParam baselineFile, float tolerancePercent);
+  /// Number of scenarios that were slower than the baseline by more than the tolerance.
+  uint GetRegressionCount();
+
+  String ToJson();
+  bool WriteResults(StringParam fileName);
+  void PrintResults();
+
+  uint mWarmups;
+  uint mSamples;
+  Array<BenchmarkScenario*> mScenarios;
+  Array<BenchmarkResult> mResults;
+  /// Scenarios the baseline ran that were skipped by this run or no longer exist
+  /// (scenarios left out by the filter are not included). Set by CompareToBaseline.
+  Array<String> mMissingScenarios;
+
+private:
+  void RunScenario(BenchmarkScenario* scenario, BenchmarkResult& result);
+};
+
+// Each area adds its scenarios to the suite
+void AddPhysicsBenchmarks(BenchmarkSuite& suite);
+void AddBroadPhaseBenchmarks(BenchmarkSuite& suite);
+void AddZilchBenchmarks(BenchmarkSuite& suite);
+void AddSerializationBenchmarks(BenchmarkSuite& suite);
+void AddEventBenchmarks(BenchmarkSuite& suite);
+void AddReplicationBenchmarks(BenchmarkSuite& suite);
+
+}//namespace Zero
@@ -0,0 +1,110 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file BroadPhaseBenchmarks.cpp
+/// Proxy churn scenario for the dynamic aabb tree broadphase.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace Zero
+{
+
+//------------------------------------------------------ BroadPhase Churn Benchmark
+// A large world of mostly separated proxies where every run moves some of them,
+// replaces a few with new ones and then finds all of the overlapping pairs
+// (what the physics space does each frame, without the narrow phase).
+class BroadPhaseChurnBenchmark : public BenchmarkScenario
+{
+public:
+  BroadPhaseChurnBenchmark()
+    : BenchmarkScenario("BroadPhase.Churn", 2001), mBroadPhase(nullptr)
+  {
+    mProxyCount = 100000;
+    mMovedPerRun = mProxyCount / 10;
+    mReplacedPerRun = mProxyCount / 100;
+    mWorldExtent = 500.0f;
+  }
+
+  void Setup() override
+  {
+    mBroadPhase = new DynamicAabbTreeBroadPhase();
+    mProxies.Resize(mProxyCount);
+    mData.Resize(mProxyCount);
+
+    for(uint i = 0; i < mProxyCount; ++i)
+    {
+      BroadPhaseData& data = mData[i];
+      data.mClientData = (void*)(size_t)(i + 1);
+      PlaceProxy(data);
+      mBroadPhase->CreateProxy(mProxies[i], data);
+    }
+  }
+
+  void Run() override
+  {
+    for(uint i = 0; i < mMovedPerRun; ++i)
+    {
+      uint index = (uint)mRandom.IntRangeInEx(0, (int)mProxyCount);
+      BroadPhaseData& data = mData[index];
+
+      Vec3 offset(mRandom.FloatRange(-2.0f, 2.0f), mRandom.FloatRange(-2.0f, 2.0f), mRandom.FloatRange(-2.0f, 2.0f));
+      Vec3 center = data.mAabb.GetCenter() + offset;
+      SetBounds(data, center, data.mAabb.GetHalfExtents());
+      mBroadPhase->UpdateProxy(mProxies[index], data);
+    }
+
+    for(uint i = 0; i < mReplacedPerRun; ++i)
+    {
+      uint index = (uint)mRandom.IntRangeInEx(0, (int)mProxyCount);
+      mBroadPhase->RemoveProxy(mProxies[index]);
+
+      BroadPhaseData& data = mData[index];
+      PlaceProxy(data);
+      mBroadPhase->CreateProxy(mProxies[index], data);
+    }
+
+    mPairs.Clear();
+    mBroadPhase->SelfQuery(mPairs);
+    ProfileCounter("Benchmark.BroadPhasePairs", mPairs.Size());
+  }
+
+  void Teardown() override
+  {
+    SafeDelete(mBroadPhase);
+    mProxies.Clear();
+    mData.Clear();
+    mPairs.Clear();
+  }
+
+  void PlaceProxy(BroadPhaseData& data)
+  {
+    Vec3 center(mRandom.FloatRange(-mWorldExtent, mWorldExtent), mRandom.FloatRange(-mWorldExtent, mWorldExtent),
+                mRandom.FloatRange(-mWorldExtent, mWorldExtent));
+    Vec3 halfExtents(mRandom.FloatRange(0.5f, 2.0f), mRandom.FloatRange(0.5f, 2.0f), mRandom.FloatRange(0.5f, 2.0f));
+    SetBounds(data, center, halfExtents);
+  }
+
+  void SetBounds(BroadPhaseData& data, Vec3Param center, Vec3Param halfExtents)
+  {
+    data.mAabb = Aabb(center, halfExtents);
+    data.mBoundingSphere = Sphere(center, Math::Length(halfExtents));
+  }
+
+  uint mProxyCount;
+  uint mMovedPerRun;
+  uint mReplacedPerRun;
+  float mWorldExtent;
+
+  IBroadPhase* mBroadPhase;
+  Array<BroadPhaseProxy> mProxies;
+  Array<BroadPhaseData> mData;
+  ClientPairArray mPairs;
+};
+
+void AddBroadPhaseBenchmarks(BenchmarkSuite& suite)
+{
+  suite.Add(new BroadPhaseChurnBenchmark());
+}
+
+}//namespace Zero
@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file EventBenchmarks.cpp
+/// Event dispatch storm scenario.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace Zero
+{
+
+namespace Events
+{
+const String BenchmarkStorm = "BenchmarkStorm";
+const String BenchmarkCalm = "BenchmarkCalm";
+}//namespace Events
+
+//---------------------------------------------------------------- Storm Listener
+class StormListener : public EventObject
+{
+public:
+  typedef StormListener ZilchSelf;
+
+  StormListener() : mReceived(0) {}
+
+  void OnStorm(ObjectEvent* event)
+  {
+    ++mReceived;
+  }
+
+  uint mReceived;
+};
+
+//---------------------------------------------------------- Event Storm Benchmark
+// Many listeners on a single source with a stream of events sent to them. Some
+// listeners are disconnected and connected again every run so the connection
+// lists don't stay in the order they were built in.
+class EventStormBenchmark : public BenchmarkScenario
+{
+public:
+  EventStormBenchmark()
+    : BenchmarkScenario("Events.Storm", 5001), mSource(nullptr)
+  {
+    mListenerCount = 1000;
+    mDispatchesPerRun = 200;
+    mReconnectsPerRun = 50;
+  }
+
+  void Setup() override
+  {
+    mSource = new EventObject();
+
+    for(uint i = 0; i < mListenerCount; ++i)
+    {
+      StormListener* listener = new StormListener();
+      ConnectListener(listener);
+      mListeners.PushBack(listener);
+    }
+  }
+
+  void Run() override
+  {
+    for(uint i = 0; i < mReconnectsPerRun; ++i)
+    {
+      StormListener* listener = mListeners[mRandom.IntRangeInEx(0, (int)mListeners.Size())];
+      mSource->GetDispatcher()->Disconnect(listener);
+      ConnectListener(listener);
+    }
+
+    ObjectEvent event(mSource);
+    for(uint i = 0; i < mDispatchesPerRun; ++i)
+    {
+      // Most of the storm is one event, the rest goes to the smaller group
+      if(i % 4 == 0)
+        mSource->DispatchEvent(Events::BenchmarkCalm, &event);
+      else
+        mSource->DispatchEvent(Events::BenchmarkStorm, &event);
+    }
+  }
+
+  void Teardown() override
+  {
+    // Listeners disconnect themselves as they are destroyed
+    DeleteObjectsInContainer(mListeners);
+    SafeDelete(mSource);
+  }
+
+  void ConnectListener(StormListener* listener)
+  {
+    Zero::Connect(mSource, Events::BenchmarkStorm, listener, &StormListener::OnStorm);
+    if(mRandom.IntRangeInEx(0, 4) == 0)
+      Zero::Connect(mSource, Events::BenchmarkCalm, listener, &StormListener::OnStorm);
+  }
+
+  uint mListenerCount;
+  uint mDispatchesPerRun;
+  uint mReconnectsPerRun;
+  EventObject* mSource;
+  Array<StormListener*> mListeners;
+};
+
+void AddEventBenchmarks(BenchmarkSuite& suite)
+{
+  suite.Add(new EventStormBenchmark());
+}
+
+}//namespace Zero
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file Main.cpp
+/// Entry point of the headless benchmark runner.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+#include "Platform/CommandLineSupport.hpp"
+#include "Support/StringMap.hpp"
+
+namespace Zero
+{
+
+System* CreateTimeSystem();
+System* CreatePhysicsSystem();
+
+// Loads the ZeroCore content package (archetypes, physics materials...) from <dataDirectory>/ZeroCore
+bool LoadBenchmarkContent(StringParam dataDirectory)
+{
+  String path = FilePath::Combine(dataDirectory, "ZeroCore");
+  String packageFile = FilePath::Combine(path, "ZeroCore.pack");
+
+  if(!FileExists(packageFile))
+  {
+    ZPrint("Failed to find content package '%s'.\n", packageFile.c_str());
+    return false;
+  }
+
+  ResourcePackage* package = new ResourcePackage();
+  package->Load(packageFile);
+  package->Location = path;
+
+  Status status;
+  Z::gResources->LoadPackage(status, package);
+  if(status.Failed())
+  {
+    ZPrint("Failed to load content package 'ZeroCore'. %s\n", status.Message.c_str());
+    return false;
+  }
+  return true;
+}
+
+void InitializeBenchmarkSystems(Engine* engine)
+{
+  // No os shell, sound or graphics system
+  engine->AddSystem(CreateTimeSystem());
+  engine->AddSystem(CreatePhysicsSystem());
+
+  SystemInitializer initializer;
+  initializer.mEngine = engine;
+  initializer.Config = Z::gEngine->GetConfigCog();
+
+  engine->Initialize(initializer);
+}
+
+}//namespace Zero
+
+using namespace Zero;
+
+// Arguments:
+//   -output <file>      Where the json results are written (BenchmarkResults.json)
+//   -baseline <file>    Results of an earlier run to compare the medians against
+//   -tolerance <%>      How much slower than the baseline is a regression (10)
+//   -filter <text>      Only runs scenarios with the text in their name
+//   -data <directory>   Directory containing ZeroCore/ZeroCore.pack, scenarios
+//                       that create cogs are skipped without it
+//   -samples <count>    Timed runs of each scenario (15)
+//   -warmups <count>    Runs before the timed runs (3)
+// Returns 1 if any scenario regressed against the baseline or a scenario the
+// baseline timed was not run, and 2 if the baseline couldn't be read.
+int main(int argc, char** argv)
+{
+  StdOutListener stdoutListener;
+  Zero::Console::Add(&stdoutListener);
+
+  Array<String> commandLineArray;
+  CommandLineToStringArray(commandLineArray, (cstr*)argv, argc);
+
+  Environment* environment = Environment::GetInstance();
+  environment->ParseCommandArgs(commandLineArray);
+  StringMap& arguments = environment->mParsedCommandLineArguments;
+
+  String outputFile = GetStringValue<String>(arguments, "output", String("BenchmarkResults.json"));
+  String baselineFile = GetStringValue<String>(arguments, "baseline", String());
+  float tolerance = GetStringValue<float>(arguments, "tolerance", cDefaultBenchmarkTolerance);
+  String filter = GetStringValue<String>(arguments, "filter", String());
+  String dataDirectory = GetStringValue<String>(arguments, "data", String());
+
+  ZeroStartupSettings settings;
+  HeadlessStartup startup;
+  Engine* engine = startup.Initialize(settings);
+  InitializeBenchmarkSystems(engine);
+
+  bool contentLoaded = false;
+  if(!dataDirectory.Empty())
+    contentLoaded = LoadBenchmarkContent(dataDirectory);
+
+  int result = 0;
+  {
+    BenchmarkSuite suite;
+    suite.mSamples = Math::Max(GetStringValue<uint>(arguments, "samples", cDefaultBenchmarkSamples), 1u);
+    suite.mWarmups = GetStringValue<uint>(arguments, "warmups", cDefaultBenchmarkWarmups);
+
+    AddPhysicsBenchmarks(suite);
+    AddBroadPhaseBenchmarks(suite);
+    AddZilchBenchmarks(suite);
+    AddSerializationBenchmarks(suite);
+    AddEventBenchmarks(suite);
+    AddReplicationBenchmarks(suite);
+
+    suite.Run(filter, contentLoaded);
+
+    if(!baselineFile.Empty())
+    {
+      if(suite.CompareToBaseline(baselineFile, tolerance))
+      {
+        uint regressions = suite.GetRegressionCount();
+        if(regressions != 0)
+        {
+          ZPrint("%u scenario(s) are more than %.1f%% slower than the baseline.\n", regressions, tolerance);
+          result = 1;
+        }
+
+        forRange(String& name, suite.mMissingScenarios.All())
+        {
+          ZPrint("%s was timed by the baseline but not by this run.\n", name.c_str());
+          result = 1;
+        }
+      }
+      else
+      {
+        result = 2;
+      }
+    }
+
+    suite.PrintResults();
+    if(suite.WriteResults(outputFile))
+      ZPrint("Wrote results to '%s'.\n", outputFile.c_str());
+  }
+
+  startup.Shutdown();
+  return result;
+}
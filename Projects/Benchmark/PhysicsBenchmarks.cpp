@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file PhysicsBenchmarks.cpp
+/// Box stacking and pile scenarios stepped through a physics space.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace Zero
+{
+
+// Frames the space is stepped in each run
+const uint cPhysicsFramesPerRun = 10;
+
+//------------------------------------------------------------- Physics Benchmark
+// Builds a static floor and the scenario's bodies in a new space, every run steps the space
+class PhysicsBenchmark : public BenchmarkScenario
+{
+public:
+  PhysicsBenchmark(StringParam name, uint seed)
+    : BenchmarkScenario(name, seed), mSpace(nullptr)
+  {
+  }
+
+  bool RequiresContent() override { return true; }
+
+  void Setup() override
+  {
+    mSpace = CreateBenchmarkSpace();
+    CreateBox(Vec3(0, -0.5f, 0), Vec3(200, 1, 200), false);
+    CreateBodies();
+  }
+
+  void Run() override
+  {
+    StepBenchmarkSpace(mSpace, cPhysicsFramesPerRun);
+  }
+
+  void Teardown() override
+  {
+    DestroyBenchmarkSpace(mSpace);
+    mSpace = nullptr;
+  }
+
+  virtual void CreateBodies() = 0;
+
+  Cog* CreateBox(Vec3Param position, Vec3Param size, bool dynamic)
+  {
+    Cog* cog = mSpace->CreateNamed(CoreArchetypes::Transform);
+    Transform* transform = cog->has(Transform);
+    transform->SetTranslation(position);
+    transform->SetScale(size);
+
+    cog->AddComponentByName("BoxCollider");
+    if(dynamic)
+      cog->AddComponentByName("RigidBody");
+    return cog;
+  }
+
+  Space* mSpace;
+};
+
+//----------------------------------------------------------- Box Stack Benchmark
+// Tall stacks of unit boxes, mostly resting contacts that the solver has to keep stable
+class BoxStackBenchmark : public PhysicsBenchmark
+{
+public:
+  BoxStackBenchmark() : PhysicsBenchmark("Physics.BoxStack", 1001) {}
+
+  void CreateBodies() override
+  {
+    const uint stacks = 10;
+    const uint height = 20;
+
+    for(uint stack = 0; stack < stacks; ++stack)
+    {
+      float x = (float(stack) - float(stacks) * 0.5f) * 3.0f;
+      for(uint level = 0; level < height; ++level)
+      {
+        // A little offset so the stacks aren't perfectly balanced
+        Vec3 jitter(mRandom.FloatRange(-0.05f, 0.05f), 0, mRandom.FloatRange(-0.05f, 0.05f));
+        CreateBox(Vec3(x, 0.5f + float(level), 0) + jitter, Vec3(1, 1, 1), true);
+      }
+    }
+  }
+};
+
+//---------------------------------------------------------------- Pile Benchmark
+// Boxes of different sizes dropped on top of each other into a large pile
+class PileBenchmark : public PhysicsBenchmark
+{
+public:
+  PileBenchmark() : PhysicsBenchmark("Physics.Pile", 1002) {}
+
+  void CreateBodies() override
+  {
+    const uint boxes = 2000;
+
+    for(uint i = 0; i < boxes; ++i)
+    {
+      Vec3 position(mRandom.FloatRange(-15.0f, 15.0f), mRandom.FloatRange(1.0f, 60.0f),
+                    mRandom.FloatRange(-15.0f, 15.0f));
+      Vec3 size(mRandom.FloatRange(0.5f, 1.5f), mRandom.FloatRange(0.5f, 1.5f), mRandom.FloatRange(0.5f, 1.5f));
+      CreateBox(position, size, true);
+    }
+  }
+};
+
+void AddPhysicsBenchmarks(BenchmarkSuite& suite)
+{
+  suite.Add(new BoxStackBenchmark());
+  suite.Add(new PileBenchmark());
+}
+
+}//namespace Zero
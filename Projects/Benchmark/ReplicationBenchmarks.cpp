@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file ReplicationBenchmarks.cpp
+/// Change detection and serialization scenario for replicated objects.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace Zero
+{
+
+// Range and precision positions are quantized to (the same as a net property
+// with quantization on the default world bounds)
+const float cReplicationWorldExtent = 1000.0f;
+const float cReplicationQuantum = 0.001f;
+// Changes are written into messages of about this size before they are "sent"
+const Bytes cReplicationMessageBytes = 1200;
+
+struct BenchmarkNetObject
+{
+  // Server side
+  Vec3 Position;
+  uint Health;
+  // What the client last received
+  Vec3 SentPosition;
+  uint SentHealth;
+  // Client side
+  Vec3 ClientPosition;
+  uint ClientHealth;
+};
+
+//-------------------------------------------------------- Replication Benchmark
+// The per object work of replicating net objects, without sockets or peers:
+// every run moves some of the objects, finds the properties that changed since
+// they were last sent, writes them quantized into message sized bit streams and
+// reads each message back into the client side copies.
+class ReplicationBenchmark : public BenchmarkScenario
+{
+public:
+  ReplicationBenchmark()
+    : BenchmarkScenario("Replication.NetObjects", 6001)
+  {
+    mObjectCount = 10000;
+    mMovedPerRun = mObjectCount / 4;
+    mDamagedPerRun = mObjectCount / 50;
+  }
+
+  void Setup() override
+  {
+    mObjects.Resize(mObjectCount);
+    forRange(BenchmarkNetObject& object, mObjects.All())
+    {
+      object.Position = Vec3(mRandom.FloatRange(-100.0f, 100.0f), 0, mRandom.FloatRange(-100.0f, 100.0f));
+      object.Health = 100;
+      object.SentPosition = object.ClientPosition = object.Position;
+      object.SentHealth = object.ClientHealth = object.Health;
+    }
+
+    mMessage.Reserve(cReplicationMessageBytes * 2);
+  }
+
+  void Run() override
+  {
+    for(uint i = 0; i < mMovedPerRun; ++i)
+    {
+      BenchmarkNetObject& object = mObjects[mRandom.IntRangeInEx(0, (int)mObjectCount)];
+      object.Position += Vec3(mRandom.FloatRange(-1.0f, 1.0f), 0, mRandom.FloatRange(-1.0f, 1.0f));
+    }
+
+    for(uint i = 0; i < mDamagedPerRun; ++i)
+    {
+      BenchmarkNetObject& object = mObjects[mRandom.IntRangeInEx(0, (int)mObjectCount)];
+      object.Health = object.Health > 10 ? object.Health - 10 : 100;
+    }
+
+    s64 bytes = 0;
+    s64 changes = 0;
+    mMessage.Clear(false);
+
+    for(uint id = 0; id < mObjectCount; ++id)
+    {
+      BenchmarkNetObject& object = mObjects[id];
+      bool moved = Math::LengthSq(object.Position - object.SentPosition) > cReplicationQuantum * cReplicationQuantum;
+      bool damaged = object.Health != object.SentHealth;
+      if(!moved && !damaged)
+        continue;
+
+      mMessage.WriteQuantized(id, 0u, mObjectCount - 1);
+      mMessage.Write(moved);
+      if(moved)
+      {
+        for(uint axis = 0; axis < 3; ++axis)
+          mMessage.WriteQuantized(object.Position[axis], -cReplicationWorldExtent, cReplicationWorldExtent, cReplicationQuantum);
+        object.SentPosition = object.Position;
+      }
+      mMessage.Write(damaged);
+      if(damaged)
+      {
+        mMessage.WriteQuantized(object.Health, 0u, 100u);
+        object.SentHealth = object.Health;
+      }
+      ++changes;
+
+      if(mMessage.GetBytesWritten() >= cReplicationMessageBytes)
+        bytes += SendMessage();
+    }
+
+    if(!mMessage.IsEmpty())
+      bytes += SendMessage();
+
+    ProfileCounter("Benchmark.ReplicatedBytes", bytes);
+    ProfileCounter("Benchmark.ReplicatedChanges", changes);
+  }
+
+  void Teardown() override
+  {
+    mObjects.Clear();
+    mMessage.Clear(true);
+  }
+
+  // Reads the message into the client side objects, returns the size of the message
+  Bytes SendMessage()
+  {
+    Bytes size = mMessage.GetBytesWritten();
+
+    mMessage.ClearBitsRead();
+    while(mMessage.GetBitsUnread() > 0)
+    {
+      uint id = 0;
+      bool moved = false;
+      bool damaged = false;
+      if(!mMessage.ReadQuantized(id, 0u, mObjectCount - 1))
+        break;
+
+      BenchmarkNetObject& object = mObjects[id];
+      mMessage.Read(moved);
+      if(moved)
+      {
+        for(uint axis = 0; axis < 3; ++axis)
+          mMessage.ReadQuantized(object.ClientPosition[axis], -cReplicationWorldExtent, cReplicationWorldExtent, cReplicationQuantum);
+      }
+      mMessage.Read(damaged);
+      if(damaged)
+        mMessage.ReadQuantized(object.ClientHealth, 0u, 100u);
+    }
+
+    mMessage.Clear(false);
+    return size;
+  }
+
+  uint mObjectCount;
+  uint mMovedPerRun;
+  uint mDamagedPerRun;
+  Array<BenchmarkNetObject> mObjects;
+  BitStream mMessage;
+};
+
+void AddReplicationBenchmarks(BenchmarkSuite& suite)
+{
+  suite.Add(new ReplicationBenchmark());
+}
+
+}//namespace Zero
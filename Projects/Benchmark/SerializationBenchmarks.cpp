@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file SerializationBenchmarks.cpp
+/// Cog save and load round-trips through the data tree and binary formats.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace Zero
+{
+
+DeclareEnum2(BenchmarkFormat, DataTree, Binary);
+
+//------------------------------------------------------- Serialization Benchmark
+// Every run saves each source cog and creates a copy of it from the saved data
+// (the same path as cloning and spawning replicated objects)
+class SerializationBenchmark : public BenchmarkScenario
+{
+public:
+  SerializationBenchmark(StringParam name, uint seed, BenchmarkFormat::Enum format)
+    : BenchmarkScenario(name, seed), mFormat(format), mSpace(nullptr)
+  {
+    mCogCount = 200;
+  }
+
+  bool RequiresContent() override { return true; }
+
+  void Setup() override
+  {
+    mSpace = CreateBenchmarkSpace();
+
+    for(uint i = 0; i < mCogCount; ++i)
+    {
+      Cog* cog = mSpace->CreateNamed(CoreArchetypes::Transform, String::Format("Object%u", i));
+      Transform* transform = cog->has(Transform);
+      transform->SetTranslation(Vec3(mRandom.FloatRange(-50.0f, 50.0f), mRandom.FloatRange(0.0f, 20.0f),
+                                     mRandom.FloatRange(-50.0f, 50.0f)));
+      transform->SetRotation(mRandom.RotationQuaternion());
+      transform->SetScale(Vec3(mRandom.FloatRange(0.5f, 2.0f)));
+
+      cog->AddComponentByName("BoxCollider");
+      cog->AddComponentByName("RigidBody");
+      mCogs.PushBack(cog);
+    }
+  }
+
+  void Run() override
+  {
+    s64 bytes = 0;
+
+    forRange(Cog* cog, mCogs.All())
+    {
+      Cog* copy = nullptr;
+      if(mFormat == BenchmarkFormat::DataTree)
+      {
+        String data = CogSerialization::SaveToStringForCopy(cog);
+        bytes += data.SizeInBytes();
+        copy = Cog::CreateFromString(mSpace, data);
+      }
+      else
+      {
+        DataBlock block = Cog::SaveToDataBlock(cog);
+        bytes += block.Size;
+        copy = Cog::CreateFromDataBlock(mSpace, block);
+        FreeBlock(block);
+      }
+
+      ErrorIf(copy == nullptr, "Failed to load a saved cog");
+      if(copy)
+        copy->Destroy();
+    }
+
+    Z::gTracker->ClearDeletedObjects();
+    ProfileCounter("Benchmark.SerializedBytes", bytes);
+  }
+
+  void Teardown() override
+  {
+    mCogs.Clear();
+    DestroyBenchmarkSpace(mSpace);
+    mSpace = nullptr;
+  }
+
+  BenchmarkFormat::Enum mFormat;
+  uint mCogCount;
+  Space* mSpace;
+  Array<Cog*> mCogs;
+};
+
+void AddSerializationBenchmarks(BenchmarkSuite& suite)
+{
+  suite.Add(new SerializationBenchmark("Serialization.DataTree", 4001, BenchmarkFormat::DataTree));
+  suite.Add(new SerializationBenchmark("Serialization.Binary", 4002, BenchmarkFormat::Binary));
+}
+
+}//namespace Zero
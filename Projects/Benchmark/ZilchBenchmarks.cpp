@@ -0,0 +1,126 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file ZilchBenchmarks.cpp
+/// Arithmetic and allocation scenarios run in the Zilch virtual machine.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Benchmark.hpp"
+
+namespace Zero
+{
+
+// Compiled on its own (only against the core library) so the scenarios don't
+// depend on the engine's script libraries
+const cstr cZilchBenchmarkCode =
+  "class ZilchBenchmark\n"
+  "{\n"
+  "  [Static]\n"
+  "  function Arithmetic(count : Integer) : Real\n"
+  "  {\n"
+  "    var total = 0.0;\n"
+  "    var step = 1;\n"
+  "    for(var i = 0; i < count; ++i)\n"
+  "    {\n"
+  "      step = (step * 75 + 74) % 65537;\n"
+  "      total = total * 0.999 + (step as Real) * 0.5 - ((i % 7) as Real);\n"
+  "    }\n"
+  "    return total;\n"
+  "  }\n"
+  "\n"
+  "  [Static]\n"
+  "  function Allocation(count : Integer) : Real\n"
+  "  {\n"
+  "    var total = 0.0;\n"
+  "    var previous : ZilchBenchmarkNode = null;\n"
+  "    for(var i = 0; i < count; ++i)\n"
+  "    {\n"
+  "      var node = new ZilchBenchmarkNode();\n"
+  "      node.Position = Real3(i as Real, 1.0, 2.0);\n"
+  "      node.Next = previous;\n"
+  "      total += node.Position.X;\n"
+  "      // Keep a short chain alive so objects are released in a different order than allocated\n"
+  "      if(i % 8 == 0)\n"
+  "      {\n"
+  "        previous = null;\n"
+  "      }\n"
+  "      else\n"
+  "      {\n"
+  "        previous = node;\n"
+  "      }\n"
+  "    }\n"
+  "    return total;\n"
+  "  }\n"
+  "}\n"
+  "\n"
+  "class ZilchBenchmarkNode\n"
+  "{\n"
+  "  var Position : Real3 = Real3();\n"
+  "  var Next : ZilchBenchmarkNode = null;\n"
+  "}\n";
+
+//--------------------------------------------------------------- Zilch Benchmark
+// Calls a static function of the benchmark script with a fixed count each run
+class ZilchBenchmark : public BenchmarkScenario
+{
+public:
+  ZilchBenchmark(StringParam name, uint seed, StringParam functionName, int count)
+    : BenchmarkScenario(name, seed), mFunctionName(functionName), mCount(count), mState(nullptr), mFunction(nullptr)
+  {
+  }
+
+  void Setup() override
+  {
+    Zilch::Project project;
+    EventConnect(&project, Zilch::Events::CompilationError, Zilch::DefaultErrorCallback);
+    project.AddCodeFromString(cZilchBenchmarkCode, "ZilchBenchmark");
+
+    Zilch::Module dependencies;
+    Zilch::LibraryRef library = project.Compile("ZilchBenchmark", dependencies, Zilch::EvaluationMode::Project);
+    ReturnIf(library == nullptr, , "Failed to compile the Zilch benchmark script");
+
+    dependencies.PushBack(library);
+    mState = dependencies.Link();
+
+    Zilch::Core& core = Zilch::Core::GetInstance();
+    Zilch::BoundType* type = library->BoundTypes.FindValue("ZilchBenchmark", nullptr);
+    Array<Zilch::Type*> parameters(ZeroInit, core.IntegerType);
+    mFunction = type->FindFunction(mFunctionName, parameters, core.RealType, Zilch::FindMemberOptions::Static);
+    ErrorIf(mFunction == nullptr, "The Zilch benchmark script has no function '%s'", mFunctionName.c_str());
+  }
+
+  void Run() override
+  {
+    if(mFunction == nullptr)
+      return;
+
+    size_t allocations = mState->HeapAllocationCount;
+
+    Zilch::ExceptionReport report;
+    Zilch::Call call(mFunction, mState);
+    call.Set(0, mCount);
+    call.Invoke(report);
+    ErrorIf(report.HasThrownExceptions(), "The Zilch benchmark '%s' threw an exception", mFunctionName.c_str());
+
+    ProfileCounter("Benchmark.ZilchAllocations", mState->HeapAllocationCount - allocations);
+  }
+
+  void Teardown() override
+  {
+    mFunction = nullptr;
+    SafeDelete(mState);
+  }
+
+  String mFunctionName;
+  int mCount;
+  Zilch::ExecutableState* mState;
+  Zilch::Function* mFunction;
+};
+
+void AddZilchBenchmarks(BenchmarkSuite& suite)
+{
+  suite.Add(new ZilchBenchmark("Zilch.Arithmetic", 3001, "Arithmetic", 1000000));
+  suite.Add(new ZilchBenchmark("Zilch.Allocation", 3002, "Allocation", 100000));
+}
+
+}//namespace Zero
@@ -0,0 +1,271 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file Main.cpp
+/// Entry point of the headless dedicated server.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Platform/CommandLineSupport.hpp"
+#include "Support/StringMap.hpp"
+#include <signal.h>
+
+namespace Zero
+{
+
+System* CreateTimeSystem();
+System* CreatePhysicsSystem();
+System* CreateActionSystem();
+
+// Simulation rate used when the tickrate argument is not given
+const uint cDefaultServerTickRate = 60;
+
+// Set by the signal handler, the engine is terminated on its next update
+volatile sig_atomic_t gServerTerminateRequested = 0;
+
+void OnServerTerminateSignal(int signalNumber)
+{
+  gServerTerminateRequested = 1;
+}
+
+// Set by the signal handler, a profile trace is started or stopped on the next update
+volatile sig_atomic_t gServerTraceToggleRequested = 0;
+// Scopes each thread can record per frame in traces started by the signal
+uint gServerTraceEventsPerThread = Profile::cDefaultTraceEventsPerThread;
+
+void OnServerTraceSignal(int signalNumber)
+{
+  gServerTraceToggleRequested = 1;
+}
+
+// Starts a new trace file (ServerTrace<n>.json in the working directory) or stops the current one
+void ToggleServerTrace()
+{
+  static uint traceCount = 0;
+
+  if(Profile::IsTraceActive())
+  {
+    Profile::StopTrace();
+    ZPrint("Profile trace stopped.\n");
+    return;
+  }
+
+  String traceFile = String::Format("ServerTrace%u.json", traceCount++);
+  if(Profile::StartTrace(traceFile, gServerTraceEventsPerThread))
+    ZPrint("Writing profile trace to '%s'.\n", traceFile.c_str());
+}
+
+//-------------------------------------------------------- Server Terminate Listener
+// Terminates the engine from the main thread once a terminate signal has arrived
+class ServerTerminateListener : public EventObject
+{
+public:
+  typedef ServerTerminateListener ZilchSelf;
+
+  void OnEngineUpdate(UpdateEvent* event)
+  {
+    if(gServerTerminateRequested)
+      Z::gEngine->Terminate();
+
+    if(gServerTraceToggleRequested)
+    {
+      gServerTraceToggleRequested = 0;
+      ToggleServerTrace();
+    }
+  }
+};
+
+bool LoadServerPackage(StringParam projectDirectory, StringParam libraryName)
+{
+  String path = FilePath::Combine(projectDirectory, libraryName);
+  String packageFile = FilePath::Combine(path, BuildString(libraryName, ".pack"));
+
+  if(!FileExists(packageFile))
+  {
+    ZPrint("Failed to find content package '%s'.\n", packageFile.c_str());
+    return false;
+  }
+
+  ResourcePackage* package = new ResourcePackage();
+  package->Load(packageFile);
+  package->Location = path;
+
+  Status status;
+  Z::gResources->LoadPackage(status, package);
+  if(status.Failed())
+    ZPrint("Failed to load content package '%s'. %s\n", libraryName.c_str(), status.Message.c_str());
+  return true;
+}
+
+bool ServerStartup(Engine* engine, StringMap& arguments)
+{
+  TimerBlock startUp("Server Startup");
+
+  String projectFile = GetStringValue<String>(arguments, "file", String());
+  String levelName = GetStringValue<String>(arguments, "level", String());
+  uint tickRate = GetStringValue<uint>(arguments, "tickrate", cDefaultServerTickRate);
+  String allocationProfile = GetStringValue<String>(arguments, "allocationprofile", String());
+  uint sampleInterval = GetStringValue<uint>(arguments, "allocationsampleinterval", Profile::cDefaultAllocationSampleInterval);
+  bool transformStore = GetStringValue<bool>(arguments, "transformstore", false);
+  String traceFile = GetStringValue<String>(arguments, "trace", String());
+  gServerTraceEventsPerThread = GetStringValue<uint>(arguments, "traceevents", Profile::cDefaultTraceEventsPerThread);
+  float spikeBudgetMs = GetStringValue<float>(arguments, "spikebudget", 0.0f);
+  String spikeDirectory = GetStringValue<String>(arguments, "spikedirectory", String("Spikes"));
+  uint spikeHistory = GetStringValue<uint>(arguments, "spikehistory", Profile::cDefaultFrameHistorySize);
+
+  if(projectFile.Empty() || !FileExists(projectFile))
+  {
+    ZPrint("A project must be given with -file <Project.zeroproj>.\n");
+    return false;
+  }
+
+  Cog* configCog = Z::gEngine->GetConfigCog();
+
+  {
+    TimerBlock block("Initializing core systems.");
+
+    // No os shell, sound or graphics system
+    engine->AddSystem(CreateTimeSystem());
+    engine->AddSystem(CreatePhysicsSystem());
+    engine->AddSystem(CreateActionSystem());
+
+    SystemInitializer initializer;
+    initializer.mEngine = engine;
+    initializer.Config = configCog;
+
+    engine->Initialize(initializer);
+  }
+
+  engine->has(TimeSystem)->SetFixedTickRate(tickRate);
+  ZPrint("Server ticking at %u hz.\n", tickRate);
+
+  // Must be set before the level is loaded, only transforms created afterwards use the store
+  if(transformStore)
+  {
+    Transform::sUseTransformStore = true;
+    ZPrint("Batching world matrices in transform stores.\n");
+  }
+
+  // Sampling is cheap enough to leave on for long soak runs
+  if(!allocationProfile.Empty() && Profile::StartAllocationProfiler(allocationProfile, sampleInterval))
+    ZPrint("Writing allocation profile to '%s'.\n", allocationProfile.c_str());
+
+  // Traces can also be started and stopped while running with SIGUSR1
+  if(!traceFile.Empty() && Profile::StartTrace(traceFile, gServerTraceEventsPerThread))
+    ZPrint("Writing profile trace to '%s'.\n", traceFile.c_str());
+
+  // Ticks that go over the budget are written out with the ticks around them
+  if(spikeBudgetMs > 0.0f)
+  {
+    Profile::StartFrameHistory(spikeDirectory, spikeBudgetMs / 1000.0f, spikeHistory);
+    ZPrint("Writing ticks over %.2fms to '%s'.\n", spikeBudgetMs, spikeDirectory.c_str());
+  }
+
+  Cog* projectCog = Z::gFactory->Create(Z::gEngine->GetEngineSpace(), projectFile, 0, nullptr);
+  if(projectCog == nullptr)
+  {
+    ZPrint("Failed to load project '%s'.\n", projectFile.c_str());
+    return false;
+  }
+
+  ProjectSettings* project = projectCog->has(ProjectSettings);
+  String projectDirectory = FilePath::GetDirectoryPath(projectFile);
+
+  // Resources of types from libraries that were not initialized (meshes, textures,
+  // sounds...) have no loader and are skipped
+  ZPrint("Loading resource packages...\n");
+  if(!LoadServerPackage(projectDirectory, "ZeroCore"))
+    return false;
+
+  if(SharedContent* sharedContent = projectCog->has(SharedContent))
+  {
+    forRange(ContentLibraryReference libraryRef, sharedContent->ExtraContentLibraries.All())
+      LoadServerPackage(projectDirectory, libraryRef.mContentLibraryName);
+  }
+
+  ObjectStore::GetInstance()->SetStoreName(project->ProjectName);
+
+  if(!LoadServerPackage(projectDirectory, project->ProjectName))
+    return false;
+
+  ZilchManager::GetInstance()->TriggerCompileExternally();
+
+  ObjectEvent event(projectCog);
+  Z::gEngine->DispatchEvent(Events::ProjectLoaded, &event);
+
+  ZPrint("Creating game...\n");
+
+  GameSession* game = Z::gEngine->CreateGameSession();
+  game->SetInEditor(false);
+
+  // The game setup component lives in the Gameplay library, so the
+  // starting space and level are created here instead
+  Level* level = levelName.Empty() ? LevelManager::GetDefault() : LevelManager::FindOrNull(levelName);
+  if(level == nullptr)
+  {
+    ZPrint("Failed to find level '%s'.\n", levelName.c_str());
+    return false;
+  }
+
+  Space* space = game->CreateSpace(ArchetypeManager::Find(CoreArchetypes::Space));
+  space->SetName(SpecialCogNames::Main);
+  space->LoadLevel(level);
+
+  game->Start();
+  return true;
+}
+
+}//namespace Zero
+
+using namespace Zero;
+
+int main(int argc, char** argv)
+{
+  // Servers are run by a process manager, everything is logged to stdout
+  StdOutListener stdoutListener;
+  Zero::Console::Add(&stdoutListener);
+
+  Array<String> commandLineArray;
+  CommandLineToStringArray(commandLineArray, (cstr*)argv, argc);
+
+  Environment* environment = Environment::GetInstance();
+  environment->ParseCommandArgs(commandLineArray);
+
+  Zero::Status socketLibraryInitStatus;
+  Zero::Socket::InitializeSocketLibrary(socketLibraryInitStatus);
+  if(socketLibraryInitStatus.Failed())
+  {
+    ZPrint("Failed to initialize the socket library. %s\n", socketLibraryInitStatus.Message.c_str());
+    return 1;
+  }
+
+  ZeroStartupSettings settings;
+  HeadlessStartup startup;
+  Engine* engine = startup.Initialize(settings);
+
+  if(!ServerStartup(engine, environment->mParsedCommandLineArguments))
+    return 1;
+
+  signal(SIGINT, OnServerTerminateSignal);
+  signal(SIGTERM, OnServerTerminateSignal);
+#ifdef SIGUSR1
+  signal(SIGUSR1, OnServerTraceSignal);
+#endif
+
+  ServerTerminateListener terminateListener;
+  Zero::Connect(Z::gEngine, Events::EngineUpdate, &terminateListener, &ServerTerminateListener::OnEngineUpdate);
+
+  //Run engine until termination
+  engine->Run();
+
+  Profile::StopAllocationProfiler();
+  Profile::StopTrace();
+  Profile::StopFrameHistory();
+  startup.Shutdown();
+
+  Zero::Status socketLibraryUninitStatus;
+  Zero::Socket::UninitializeSocketLibrary(socketLibraryUninitStatus);
+
+  ZPrint("Terminated\n");
+
+  return 0;
+}
@@ -0,0 +1,7 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file Precompiled.cpp
+/// Generates the precompiled header file.
+/// 
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
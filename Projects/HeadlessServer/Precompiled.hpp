@@ -0,0 +1,9 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file Precompiled.hpp
+/// Precompiled Header Class
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Startup/StartupStandard.hpp"
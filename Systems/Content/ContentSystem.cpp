@@ -673,6 +673,27 @@ ContentItem* ContentSystem::FindContentItemByFileName(StringParam filename)
   return nullptr;
 }
 
+void ContentSystem::FindChangedContentItems(ContentLibrary* library, Array<String>& changedFiles, ContentItemArray& changedItems)
+{
+  HashSet<ContentItem*> found;
+  forRange(String& fileName, changedFiles.All())
+  {
+    // Editing the meta file changes the content item as well. Only the extension is
+    // stripped so meta files in sub directories keep their path.
+    String contentFileName = fileName;
+    StringRange extension = FilePath::GetExtension(fileName);
+    if(extension == "meta")
+      contentFileName = fileName.SubStringFromByteIndices(0, fileName.SizeInBytes() - extension.SizeInBytes() - 1);
+
+    ContentItem* contentItem = library->FindContentItemByFileName(contentFileName);
+    if(contentItem == nullptr || found.Contains(contentItem))
+      continue;
+
+    found.Insert(contentItem);
+    changedItems.PushBack(contentItem);
+  }
+}
+
 ContentItem* ContentSystem::CreateFromName(StringRange name)
 {
   ContentCreatorMapType::range r = Creators.Find(name);
@@ -163,6 +163,12 @@ public:
   // Find a content item by file name (Not the full path).
   ContentItem* FindContentItemByFileName(StringParam filename);
 
+  /// Find the content items in the library affected by a set of changed files
+  /// (names relative to the library). Changes to meta files map to their content
+  /// item and each content item is only added once, so a batch of changes only
+  /// rebuilds what was touched.
+  void FindChangedContentItems(ContentLibrary* library, Array<String>& changedFiles, ContentItemArray& changedItems);
+
 //Internals
   ContentItem* CreateFromName(StringRange name);
   void SetupOptions(ContentLibrary* library, BuildOptions& buildOptions);
@@ -120,9 +120,8 @@ void AnimationGraph::Update(float dt)
 {
   if (mActiveNode)
   {
-    // Static so we can re-use memory and avoid extra allocations
-    static Array<AnimationGraphEvent*> eventsToSend;
-    eventsToSend.Clear();
+    // Not static, spaces may be updated in parallel
+    Array<AnimationGraphEvent*> eventsToSend;
 
     // Update the root node
     mActiveNode = mActiveNode->Update(this, dt, mFrameId++, eventsToSend);
@@ -202,13 +201,15 @@ void AnimationGraph::ForceUpdate()
   {
     AnimationFrame frame;
 
-    // Static so we can re-use memory and avoid extra allocations
-    static Array<AnimationGraphEvent*> eventsToSend;
-    eventsToSend.Clear();
+    // Not static, spaces may be updated in parallel
+    Array<AnimationGraphEvent*> eventsToSend;
 
     mActiveNode = mActiveNode->Update(this, 0.0f, mFrameId++, eventsToSend);
     if(mActiveNode)
       ApplyFrame(mActiveNode->mFrameData);
+
+    // Events are not sent when forcing an update
+    DeleteObjectsInContainer(eventsToSend);
   }
 }
 
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AsyncFile.cpp
+/// Engine side of the asynchronous file io service.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+namespace Events
+{
+  DefineEvent(AsyncFileCompleted);
+}
+
+namespace Z
+{
+  AsyncFileIo* gFileIo = nullptr;
+}
+
+//------------------------------------------------------------- Async File Event
+ZilchDefineType(AsyncFileEvent, builder, type)
+{
+}
+
+AsyncFileEvent::AsyncFileEvent(AsyncFileBatch* batch)
+  : Batch(batch)
+{
+}
+
+AsyncFileEvent::~AsyncFileEvent()
+{
+  SafeDelete(Batch);
+}
+
+//------------------------------------------------------------------------------
+// Who to notify once a batch completes
+struct AsyncFileTarget
+{
+  Handle Object;
+  EventDispatcher* Dispatcher;
+};
+
+// Called on a file io thread
+void OnAsyncFileBatchCompleted(AsyncFileBatch* batch, void* userData)
+{
+  AsyncFileTarget* target = (AsyncFileTarget*)userData;
+  Z::gDispatch->DispatchOn(target->Object, target->Dispatcher, Events::AsyncFileCompleted, new AsyncFileEvent(batch));
+  delete target;
+}
+
+void SubmitAsyncFileBatch(AsyncFileBatch* batch, HandleParam object, EventDispatcher* dispatcher)
+{
+  AsyncFileTarget* target = new AsyncFileTarget();
+  target->Object = object;
+  target->Dispatcher = dispatcher;
+  Z::gFileIo->Submit(batch, OnAsyncFileBatchCompleted, target);
+}
+
+}//namespace Zero
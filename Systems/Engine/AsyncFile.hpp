@@ -0,0 +1,47 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AsyncFile.hpp
+/// Engine side of the asynchronous file io service.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace Zero
+{
+
+namespace Events
+{
+  DeclareEvent(AsyncFileCompleted);
+}
+
+//------------------------------------------------------------- Async File Event
+/// Sent on the main thread once every request of a batch has completed.
+/// The event owns the batch, take the data out of the requests to keep it.
+class AsyncFileEvent : public Event
+{
+public:
+  ZilchDeclareType(TypeCopyMode::ReferenceType);
+
+  AsyncFileEvent(AsyncFileBatch* batch = nullptr);
+  ~AsyncFileEvent();
+
+  AsyncFileBatch* Batch;
+};
+
+namespace Z
+{
+  extern AsyncFileIo* gFileIo;
+}
+
+/// Submits the batch to the file io service. Once every request has completed
+/// Events::AsyncFileCompleted is sent to the object on the main thread (through
+/// ThreadDispatch) and the batch is deleted along with the event.
+void SubmitAsyncFileBatch(AsyncFileBatch* batch, HandleParam object, EventDispatcher* dispatcher);
+
+template<typename type>
+void SubmitAsyncFileBatch(AsyncFileBatch* batch, type* object)
+{
+  SubmitAsyncFileBatch(batch, object, object->GetDispatcher());
+}
+
+}//namespace Zero
@@ -17,8 +17,9 @@ bool CogIsModifiedFromArchetype(Cog* cog, bool ignoreOverrideProperties);
 void ClearCogModifications(Cog* rootCog, Cog* cog, ObjectState::ModifiedProperties& cachedMemory,
                            bool retainOverrideProperties, bool retainChildArchetypeModifications);
 void ClearCogModifications(Cog* root, bool retainChildArchetypeModifications);
-template<typename type>
-void eraseEqualValues(Array<type>& mArray, type value);
+template<typename arrayType, typename type>
+void eraseEqualValues(arrayType& mArray, type value);
+u64 GetComponentSlotBit(BoundType* componentType);
 
 //------------------------------------------------------------------------------------------- Events
 namespace Events
@@ -196,6 +197,7 @@ Cog::Cog()
   mHierarchyParent = nullptr;
   mSubContextId = 0;
   mChildId = PolymorphicNode::cInvalidUniqueNodeId;
+  mComponentSlotMask = 0;
 }
 
 //**************************************************************************************************
@@ -677,6 +679,19 @@ bool Cog::AddComponentByName(StringParam name)
 //**************************************************************************************************
 Component * Cog::QueryComponentType(BoundType* componentType)
 {
+  if (componentType == nullptr)
+    return nullptr;
+
+  // Every type in the component map has its bit set
+  u64 bit = GetComponentSlotBit(componentType);
+  if ((mComponentSlotMask & bit) == 0)
+    return nullptr;
+
+  ComponentSlot& slot = mComponentSlots[CountSetBits(mComponentSlotMask & (bit - 1))];
+  if (slot.mType == componentType)
+    return slot.mComponent;
+
+  // Another type on this cog shares the bit
   return mComponentMap.FindValue(componentType, nullptr);
 }
 
@@ -712,6 +727,14 @@ size_t Cog::GetComponentCount()
 //**************************************************************************************************
 uint Cog::GetComponentIndex(BoundType* componentType)
 {
+  Component* found = QueryComponentType(componentType);
+  if (found == nullptr)
+    return uint(-1);
+
+  // The component found for the type is usually the one we want, unless the type is an interface
+  if (ZilchVirtualTypeId(found) == componentType)
+    return (uint)mComponents.FindIndex(found);
+
   for (uint i = 0; i < mComponents.Size(); ++i)
   {
     Component* component = mComponents[i];
@@ -844,6 +867,7 @@ void Cog::MoveComponentBefore(uint componentToMove, uint destination)
 void Cog::AddComponentInterface(BoundType* alternateType, Component* component)
 {
   mComponentMap.Insert(alternateType, component);
+  AddComponentSlot(alternateType, component);
 
   // DO NOT add it the component list as it's just for looking it up by type
 }
@@ -858,6 +882,7 @@ void Cog::AddComponentInternal(BoundType* typeId, Component* component, int inde
     mComponents.InsertAt(index, component);
 
   mComponentMap.Insert(typeId, component);
+  AddComponentSlot(typeId, component);
   component->mOwner = this;
 
   BoundType* componentType = ZilchVirtualTypeId(component);
@@ -883,12 +908,54 @@ void Cog::RemoveComponentInternal(Component* component)
 {
   // Un map the component
   mComponentMap.EraseEqualValues(component);
+  RebuildComponentSlots();
   eraseEqualValues(mComponents, component);
 
   // Delete the component
   component->Delete();
 }
 
+//**************************************************************************************************
+// Component types are numbered the first time they're added to any cog. Zero is never
+// assigned so it shares the bit of every type that hasn't been added yet.
+static SpinLock sComponentTypeIndexLock;
+static size_t sComponentTypeCount = 0;
+
+u64 GetComponentSlotBit(BoundType* componentType)
+{
+  return u64(1) << (componentType->RuntimeIndex & 63);
+}
+
+//**************************************************************************************************
+void Cog::AddComponentSlot(BoundType* componentType, Component* component)
+{
+  if (componentType->RuntimeIndex == 0)
+  {
+    sComponentTypeIndexLock.Lock();
+    if (componentType->RuntimeIndex == 0)
+      componentType->RuntimeIndex = ++sComponentTypeCount;
+    sComponentTypeIndexLock.Unlock();
+  }
+
+  u64 bit = GetComponentSlotBit(componentType);
+  if (mComponentSlotMask & bit)
+    return;
+
+  ComponentSlot slot = { componentType, component };
+  mComponentSlots.InsertAt(CountSetBits(mComponentSlotMask & (bit - 1)), slot);
+  mComponentSlotMask |= bit;
+}
+
+//**************************************************************************************************
+void Cog::RebuildComponentSlots()
+{
+  mComponentSlotMask = 0;
+  mComponentSlots.Clear();
+
+  forRange(ComponentMap::value_type& entry, mComponentMap.All())
+    AddComponentSlot(entry.first, entry.second);
+}
+
 //**************************************************************************************************
 bool CheckForAddition(Cog* cog, BoundType* componentMeta, AddInfo& info)
 {
@@ -962,6 +1029,8 @@ void Cog::DeleteComponents()
   //Clear all components
   mComponents.Clear();
   mComponentMap.Clear();
+  mComponentSlots.Clear();
+  mComponentSlotMask = 0;
 
   if (mHierarchyParent)
   {
@@ -1975,7 +2044,7 @@ void Cog::DispatchDown(StringParam eventId, Event* event)
   if (hierarchy)
   {
     // Hierarchy can be modified during any event, copy the list of children before dispatching.
-    Array<Cog*> children;
+    InlineArray<Cog*, 16> children;
     forRange(HierarchyList::sub_reference child, hierarchy->GetChildren())
       children.PushBack(&child);
 
@@ -2374,8 +2443,8 @@ void ClearCogModifications(Cog* root, bool retainChildArchetypeModifications)
 }
 
 //**************************************************************************************************
-template<typename type>
-void eraseEqualValues(Array<type>& mArray, type value)
+template<typename arrayType, typename type>
+void eraseEqualValues(arrayType& mArray, type value)
 {
   uint index = 0;
   for(uint i = 0; i < mArray.Size();)
@@ -137,8 +137,8 @@ public:
   bool IsInitialized() const;
 
   //-------------------------------------------------------------------------------- Components
-  /// Typedefs.
-  typedef Array<Component*> ComponentArray;
+  /// Typedefs. Almost every cog has only a few components so they are stored inline.
+  typedef InlineArray<Component*, 8> ComponentArray;
   typedef ComponentArray::range ComponentRange;
   typedef ArrayMultiMap<BoundType*, Component*> ComponentMap;
   typedef ComponentMap::valueRange ComponentMapRange;
@@ -198,6 +198,10 @@ public:
   void AddComponentInternal(BoundType* typeId, Component* component, int index = -1);
   /// Removes the component from the internal map and deletes the component.
   void RemoveComponentInternal(Component* component);
+  /// Adds the type to the slot table unless its bit is already taken.
+  void AddComponentSlot(BoundType* componentType, Component* component);
+  /// Rebuilds the slot table from the component map.
+  void RebuildComponentSlots();
   /// Checks for 
   bool CheckForAddition(BoundType* componentType);
   /// Helper to check for dependencies with component addition and DoNotify if it won't
@@ -212,6 +216,18 @@ public:
   /// The map of the component's name to their instance for fast lookup.
   ComponentMap mComponentMap;
 
+  /// Every component type is given a dense runtime index when it is first added to a Cog.
+  /// The index selects one bit of the slot mask and each set bit has one entry in the packed
+  /// slot array (ordered by bit), so a query is a bit test and a count of the lower bits.
+  /// Types whose bit is already used by another type are only found through the component map.
+  struct ComponentSlot
+  {
+    BoundType* mType;
+    Component* mComponent;
+  };
+  u64 mComponentSlotMask;
+  InlineArray<ComponentSlot, 8> mComponentSlots;
+
   //---------------------------------------------------------------------------------- Children
   /// Get the parent of this object in the Hierarchy.
   Cog* GetParent();
@@ -149,6 +149,12 @@ void Engine::Update()
 {
   ProfileScope("Engine");
 
+  // Scratch memory from two frames ago is reused from here on
+  Memory::AdvanceFrameArenas();
+  Profile::EndAllocationProfilerFrame();
+  Profile::EndCounterFrame();
+  Profile::EndTraceFrame();
+
   Z::gTracker->ClearDeletedObjects();
 
   Z::gDispatch->DispatchEvents();
@@ -446,8 +452,10 @@ void FatalEngineError(cstr format, ...)
   String finalMessage = BuildString(message, " The engine will now exit. If this issue persists please" 
                                               " reinstall Zero Engine or contact support.");
 
+  // There is no shell to show the message on when running headless
   OsShell* shell = Z::gEngine->has(OsShell);
-  shell->ShowMessageBox("Core Engine Error", finalMessage);
+  if(shell != nullptr)
+    shell->ShowMessageBox("Core Engine Error", finalMessage);
 
   //Terminate
   CrashHandler::FatalError(1);
@@ -195,6 +195,8 @@ ZilchDefineStaticLibrary(EngineLibrary)
   ZilchInitializeType(AnimationGraphEvent);
   ZilchInitializeType(KeyboardEvent);
   ZilchInitializeType(FileEditEvent);
+  ZilchInitializeType(FileBatchEvent);
+  ZilchInitializeType(AsyncFileEvent);
   ZilchInitializeType(KeyboardTextEvent);
   ZilchInitializeType(OsMouseEvent);
   ZilchInitializeType(HierarchyEvent);
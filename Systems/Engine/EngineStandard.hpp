@@ -25,6 +25,7 @@ class Space;
 class GameSession;
 class GameWidget;
 class Transform;
+class TransformStore;
 class ContentLibrary;
 class ResourcePackage;
 class ResourceLibrary;
@@ -89,9 +90,11 @@ private:
 #include "JobSystem.hpp"
 #include "EngineEvents.hpp"
 #include "System.hpp"
+#include "UpdateRegistry.hpp"
 #include "Time.hpp"
 #include "Engine.hpp"
 #include "ThreadDispatch.hpp"
+#include "AsyncFile.hpp"
 #include "Game.hpp"
 #include "Factory.hpp"
 #include "ArchetypeRebuilder.hpp"
@@ -101,6 +104,7 @@ private:
 #include "Tracker.hpp"
 #include "Hierarchy.hpp"
 #include "TransformSupport.hpp"
+#include "TransformStore.hpp"
 #include "Transform.hpp"
 #include "Action/Action.hpp"
 #include "Action/ActionSystem.hpp"
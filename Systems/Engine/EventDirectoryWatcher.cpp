@@ -14,6 +14,7 @@ namespace Events
   DefineEvent(FileCreated);
   DefineEvent(FileDeleted);
   DefineEvent(FileRenamed);
+  DefineEvent(FilesChanged);
 }
 
 ZilchDefineType(EventDirectoryWatcher, builder, type)
@@ -25,8 +26,12 @@ ZilchDefineType(FileEditEvent, builder, type)
 {
 }
 
+ZilchDefineType(FileBatchEvent, builder, type)
+{
+}
+
 EventDirectoryWatcher::EventDirectoryWatcher(StringParam directory)
-  :mWatcher(directory.c_str(), DirectoryWatcher::CallBackCreator<EventDirectoryWatcher, &EventDirectoryWatcher::FileCallBack>, this)
+  :mWatcher(directory.c_str(), DirectoryWatcher::BatchCallBackCreator<EventDirectoryWatcher, &EventDirectoryWatcher::FileBatchCallBack>, this)
 {
 }
 
@@ -49,4 +54,17 @@ OsInt EventDirectoryWatcher::FileCallBack(DirectoryWatcher::FileOperationInfo& i
   return 0;
 }
 
+OsInt EventDirectoryWatcher::FileBatchCallBack(Array<DirectoryWatcher::FileOperationInfo>& operations)
+{
+  // Per file events for existing listeners
+  forRange(DirectoryWatcher::FileOperationInfo& info, operations.All())
+    FileCallBack(info);
+
+  FileBatchEvent* event = new FileBatchEvent();
+  event->Operations = operations;
+  event->TimeStamp = Time::Clock();
+  Z::gDispatch->DispatchOn(this, this->GetDispatcher(), Events::FilesChanged, event);
+  return 0;
+}
+
 }
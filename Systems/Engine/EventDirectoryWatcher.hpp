@@ -15,6 +15,7 @@ namespace Events
   DeclareEvent(FileCreated);
   DeclareEvent(FileDeleted);
   DeclareEvent(FileRenamed);
+  DeclareEvent(FilesChanged);
 }
 
 class FileEditEvent : public Event
@@ -29,6 +30,18 @@ public:
   TimeType TimeStamp;
 };
 
+/// Sent once per coalesced change set, after the individual file events.
+class FileBatchEvent : public Event
+{
+public:
+  ZilchDeclareType(TypeCopyMode::ReferenceType);
+  /// Net operation of every file in the change set (each file appears once).
+  Array<DirectoryWatcher::FileOperationInfo> Operations;
+
+  /// The time at which the change set was reported.
+  TimeType TimeStamp;
+};
+
 // Watches a directory and sends out events on the main thread.
 class EventDirectoryWatcher : public EventObject
 {
@@ -38,6 +51,7 @@ public:
   EventDirectoryWatcher(StringParam directory);
 
   OsInt FileCallBack(DirectoryWatcher::FileOperationInfo& info);
+  OsInt FileBatchCallBack(Array<DirectoryWatcher::FileOperationInfo>& operations);
   DirectoryWatcher mWatcher;
 };
 
@@ -1,7 +1,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \file JobSystem.cpp
-/// 
+///
 ///
 /// Authors: Chris Peters
 /// Copyright 2010-2011, DigiPen Institute of Technology
@@ -20,6 +20,8 @@ Job::Job()
 {
   mDeletedOnCompletion = true;
   mOsEvent = nullptr;
+  mUnfinishedJobs = 1;
+  mParent = nullptr;
 }
 
 Job::~Job()
@@ -35,22 +37,148 @@ OsEvent* Job::InitializeOsEvent()
   return mOsEvent;
 }
 
+bool Job::IsCompleted()
+{
+  return mUnfinishedJobs == 0;
+}
+
+//------------------------------------------------------------------- Job Worker
+/// Fixed size Chase-Lev work stealing deque. The owning thread pushes and pops
+/// at the bottom, any other thread may steal from the top.
+class JobWorker
+{
+public:
+  // Must be a power of two
+  static const s64 cCapacity = 4096;
+  static const s64 cMask = cCapacity - 1;
+
+  JobWorker(JobSystem* system)
+    : mSystem(system), mTop(0), mBottom(0), mCurrentJob(nullptr), mRandomState(0x9E3779B9)
+  {
+    memset((void*)mJobs, 0, sizeof(mJobs));
+  }
+
+  // Owner only. Returns false if the deque is full.
+  bool Push(Job* job)
+  {
+    s64 bottom = mBottom.Load();
+    s64 top = mTop.Load();
+    if(bottom - top >= cCapacity)
+      return false;
+
+    AtomicStore(&mJobs[bottom & cMask], (void*)job);
+    mBottom.Store(bottom + 1);
+    return true;
+  }
+
+  // Owner only.
+  Job* Pop()
+  {
+    s64 bottom = mBottom.Load() - 1;
+    // The store is a full barrier so thieves see the reservation before we read the top
+    mBottom.Store(bottom);
+    s64 top = mTop.Load();
+
+    if(top > bottom)
+    {
+      // Empty
+      mBottom.Store(bottom + 1);
+      return nullptr;
+    }
+
+    Job* job = (Job*)AtomicLoad(&mJobs[bottom & cMask]);
+    if(top == bottom)
+    {
+      // Last job, race any thieves for it
+      if(!mTop.CompareExchangeBool(top + 1, top))
+        job = nullptr;
+      mBottom.Store(bottom + 1);
+    }
+    return job;
+  }
+
+  // Any thread. Returns null if empty or if another thread won the race.
+  Job* Steal()
+  {
+    s64 top = mTop.Load();
+    s64 bottom = mBottom.Load();
+    if(top >= bottom)
+      return nullptr;
+
+    Job* job = (Job*)AtomicLoad(&mJobs[top & cMask]);
+    if(!mTop.CompareExchangeBool(top + 1, top))
+      return nullptr;
+    return job;
+  }
+
+  bool IsEmpty()
+  {
+    return mTop.Load() >= mBottom.Load();
+  }
+
+  // Only used by the owner to pick steal victims
+  uint NextRandom()
+  {
+    // Xorshift
+    mRandomState ^= mRandomState << 13;
+    mRandomState ^= mRandomState >> 17;
+    mRandomState ^= mRandomState << 5;
+    return mRandomState;
+  }
+
+  JobSystem* mSystem;
+  Atomic<s64> mTop;
+  Atomic<s64> mBottom;
+  void* volatile mJobs[cCapacity];
+
+  // The job currently executing on the owning thread (so it can be canceled on shutdown)
+  SpinLock mCurrentJobLock;
+  Job* mCurrentJob;
+  u32 mRandomState;
+};
+
+// The deque owned by the calling thread (null for threads that do not own one)
+ZeroThreadLocal JobWorker* sCurrentWorker = nullptr;
+
+OsInt JobWorkerThreadEntry(void* instance)
+{
+  JobWorker* worker = (JobWorker*)instance;
+  return worker->mSystem->WorkerThreadEntry(worker);
+}
+
 //-----------------------------------------------------------------------------
 namespace Z
 {
   JobSystem* gJobs = nullptr;
 }
 
+// Jobs are also used for long blocking background tasks (web requests, content
+// builds, exports) so keep a few workers even on machines with few cores
+const uint cMinimumWorkerThreads = 4;
+
 JobSystem::JobSystem()
 {
   mWorkerThreadsActive = true;
-  Workers.Resize(10);
+  mPendingCount = 0;
+  mBlockedWaiters = 0;
 
-  for(uint i=0;i<Workers.Size();++i)
+  uint processorCount = Os::GetProcessorCount();
+  // Leave a processor for the thread that owns the job system
+  uint workerThreadCount = Math::Max(processorCount - 1, cMinimumWorkerThreads);
+
+  // One deque per worker thread plus one for the creating thread
+  mWorkerQueues.Resize(workerThreadCount + 1);
+  for(uint i = 0; i < mWorkerQueues.Size(); ++i)
+    mWorkerQueues[i] = new JobWorker(this);
+  sCurrentWorker = mWorkerQueues.Back();
+
+  Workers.Resize(workerThreadCount);
+  for(uint i = 0; i < Workers.Size(); ++i)
   {
     Workers[i] = new Thread();
     Thread& thread = *Workers[i];
-    thread.Initialize(&Thread::ObjectEntryCreator<JobSystem,&JobSystem::WorkerThreadEntry>, this, "Background");
+    mWorkerQueues[i]->mRandomState += i * 0x6D2B79F5;
+    thread.Initialize(JobWorkerThreadEntry, mWorkerQueues[i], String::Format("JobWorker%u", i));
     thread.Resume();
   }
 }
@@ -59,29 +187,19 @@ JobSystem::~JobSystem()
 {
   mWorkerThreadsActive = false;
 
-  mLock.Lock();
-
-  //Cancel all active Jobs
+  // Threads blocked in WaitForJob stop blocking once workers are shutting down
+  WakeWaiters();
 
-  //Active job range is safe because of the lock.
-  forRange(Job& job, ActiveJobs.All())
-    job.Cancel();
-
-  // Delete all pending jobs that we own. 
-  // if a job is marked to not be deleted on completion then it's likely a background task. 
-  // Leave this to the background task manager to delete otherwise a double deletion will happen.
-  while(!PendingJobs.Empty())
+  // Cancel all active Jobs
+  for(uint i = 0; i < mWorkerQueues.Size(); ++i)
   {
-    Job* job = &PendingJobs.Front();
-    PendingJobs.PopFront();
-    if(job->mDeletedOnCompletion)
-    {
-      SafeDelete(job);
-    }
+    JobWorker* worker = mWorkerQueues[i];
+    worker->mCurrentJobLock.Lock();
+    if(worker->mCurrentJob)
+      worker->mCurrentJob->Cancel();
+    worker->mCurrentJobLock.Unlock();
   }
 
-  mLock.Unlock();
-
   //increment the counter but push no jobs
   //allowing each background thread to unblock
   for(uint i=0;i<Workers.Size();++i)
@@ -98,75 +216,297 @@ JobSystem::~JobSystem()
 
   //delete all threads
   DeleteObjectsInContainer(Workers);
+
+  // Delete all pending jobs that we own (no other threads are running at this point).
+  // if a job is marked to not be deleted on completion then it's likely a background task.
+  // Leave this to the background task manager to delete otherwise a double deletion will happen.
+  while(!PendingJobs.Empty())
+  {
+    Job* job = &PendingJobs.Front();
+    PendingJobs.PopFront();
+    if(job->mDeletedOnCompletion)
+      SafeDelete(job);
+  }
+
+  for(uint i = 0; i < mWorkerQueues.Size(); ++i)
+  {
+    JobWorker* worker = mWorkerQueues[i];
+    while(Job* job = worker->Steal())
+    {
+      if(job->mDeletedOnCompletion)
+        SafeDelete(job);
+    }
+  }
+
+  if(sCurrentWorker != nullptr && sCurrentWorker->mSystem == this)
+    sCurrentWorker = nullptr;
+  DeleteObjectsInContainer(mWorkerQueues);
 }
 
-Job* JobSystem::GetNextJob()
+uint JobSystem::GetWorkerCount()
 {
-  Job* job = nullptr;
+  return Workers.Size() + 1;
+}
 
-  //Locked pop front
-  mLock.Lock();
-  if(!PendingJobs.Empty())
+JobWorker* JobSystem::GetCurrentWorker()
+{
+  JobWorker* worker = sCurrentWorker;
+  if(worker != nullptr && worker->mSystem == this)
+    return worker;
+  return nullptr;
+}
+
+Job* JobSystem::FindJob(JobWorker* worker)
+{
+  // Newest job from our own deque first (best cache locality)
+  if(worker != nullptr)
   {
-    job = &PendingJobs.Front();
-    PendingJobs.Erase(PendingJobs.Begin());
-    ActiveJobs.PushBack(job);
+    if(Job* job = worker->Pop())
+      return job;
   }
-  mLock.Unlock();
 
-  return job;
+  // Jobs added from threads that do not own a deque
+  if(mPendingCount > 0)
+  {
+    Job* job = nullptr;
+    mLock.Lock();
+    if(!PendingJobs.Empty())
+    {
+      job = &PendingJobs.Front();
+      PendingJobs.PopFront();
+      --mPendingCount;
+    }
+    mLock.Unlock();
+
+    if(job != nullptr)
+      return job;
+  }
+
+  // Steal the oldest job from another worker, starting at a random victim
+  uint queueCount = mWorkerQueues.Size();
+  uint start = worker ? worker->NextRandom() % queueCount : 0;
+  for(uint i = 0; i < queueCount; ++i)
+  {
+    JobWorker* victim = mWorkerQueues[(start + i) % queueCount];
+    if(victim == worker)
+      continue;
+
+    // A failed steal only means another thread won the race, retry while there is work
+    while(!victim->IsEmpty())
+    {
+      if(Job* job = victim->Steal())
+        return job;
+    }
+  }
+
+  return nullptr;
 }
 
-void JobSystem::JobFinished(Job* job)
+Job* JobSystem::FindJobToHelp(JobWorker* worker, Job* awaitedJob)
 {
+  Job* job = FindJob(worker);
+  if(job == nullptr)
+    return nullptr;
+
+  // Parents cannot complete before their children so the chain is safe to walk
+  for(Job* parent = job->mParent; parent != nullptr; parent = parent->mParent)
+  {
+    if(parent == awaitedJob)
+      return job;
+  }
+
+  // An unrelated job may be a long background task, running it here would stall
+  // the waiting thread (the main thread would miss its frame). Leave it to a worker.
   mLock.Lock();
-  ActiveJobs.Erase(job);
+  PendingJobs.PushBack(job);
+  ++mPendingCount;
   mLock.Unlock();
+  mJobCounter.Increment();
+  return nullptr;
+}
 
-  if(job->mOsEvent)
-    job->mOsEvent->Signal();
+void JobSystem::ExecuteJob(Job* job)
+{
+  JobWorker* worker = GetCurrentWorker();
+  Job* previousJob = nullptr;
+  if(worker != nullptr)
+  {
+    worker->mCurrentJobLock.Lock();
+    previousJob = worker->mCurrentJob;
+    worker->mCurrentJob = job;
+    worker->mCurrentJobLock.Unlock();
+  }
+
+  //Run the job
+  job->Execute();
+
+  // Restore the previous job (jobs may run nested while waiting on other jobs)
+  if(worker != nullptr)
+  {
+    worker->mCurrentJobLock.Lock();
+    worker->mCurrentJob = previousJob;
+    worker->mCurrentJobLock.Unlock();
+  }
+
+  //Finish the job
+  JobFinished(job);
+}
+
+void JobSystem::JobFinished(Job* job)
+{
+  // Read everything we need before the count reaches zero, as the job
+  // may be deleted by a waiting thread as soon as it has completed
+  Job* parent = job->mParent;
+  OsEvent* osEvent = job->mOsEvent;
+  bool deleteJob = job->mDeletedOnCompletion;
+
+  if(--job->mUnfinishedJobs != 0)
+    return;
+
+  // Let threads blocked in WaitForJob check their job again
+  WakeWaiters();
+
+  // Signaled last as an event waiter is free to delete the job once it returns
+  if(osEvent)
+    osEvent->Signal();
 
   // Only delete the job if specified
-  if(job->mDeletedOnCompletion)
+  if(deleteJob)
     delete job;
+
+  // The parent may now be complete as well
+  if(parent)
+    JobFinished(parent);
 }
 
-OsInt JobSystem::WorkerThreadEntry()
+OsInt JobSystem::WorkerThreadEntry(JobWorker* worker)
 {
+  sCurrentWorker = worker;
+
+  uint workerIndex = 0;
+  while(mWorkerQueues[workerIndex] != worker)
+    ++workerIndex;
+  Profile::SetTraceThreadName(String::Format("JobWorker%u", workerIndex));
+
   for(;;)
   {
     mJobCounter.WaitAndDecrement();
-    Job* job = GetNextJob();
 
-    //No jobs and Semaphore release
-    //that means we are shutting down.
-    if(job == nullptr)
+    //Semaphore released with the workers
+    //disabled means we are shutting down.
+    if(!mWorkerThreadsActive)
       return 0;
 
-    //Run the job
-    job->Execute();
+    // Keep running jobs until there is no work left anywhere. Jobs executed by other
+    // threads may have left extra counts on the semaphore, those just wake us up
+    // to find nothing and go back to waiting.
+    while(Job* job = FindJob(worker))
+    {
+      ExecuteJob(job);
 
-    //Finish the job
-    JobFinished(job);
+      if(!mWorkerThreadsActive)
+        return 0;
+    }
   }
 }
 
-void JobSystem::AddJob(Job* job)
+void JobSystem::AddJob(Job* job, Job* parent)
 {
+  job->mUnfinishedJobs = 1;
+  job->mParent = parent;
+  if(parent)
+  {
+    ErrorIf(parent->IsCompleted(), "Cannot add a child to a job that has already completed");
+    ++parent->mUnfinishedJobs;
+  }
+
   if(!ThreadingEnabled)
   {
-    job->Execute();
+    ExecuteJob(job);
     return;
   }
-  
-  //lock push a job
-  mLock.Lock();
-  PendingJobs.PushBack(job);
-  mLock.Unlock();
 
-  //Signal that a job has been added 
+  // Push to our own deque when we own one, otherwise through the locked queue
+  JobWorker* worker = GetCurrentWorker();
+  if(worker == nullptr || !worker->Push(job))
+  {
+    mLock.Lock();
+    PendingJobs.PushBack(job);
+    ++mPendingCount;
+    mLock.Unlock();
+  }
+
+  //Signal that a job has been added
   //unblocking workers
   mJobCounter.Increment();
+
+  // Blocked waiters may be able to help with the new job
+  WakeWaiters();
+}
+
+void JobSystem::WakeWaiters()
+{
+  // Claim every registered waiter and release exactly one count for each
+  s32 blockedWaiters = mBlockedWaiters.Exchange(0);
+  for(s32 i = 0; i < blockedWaiters; ++i)
+    mWaiterSemaphore.Increment();
+}
+
+bool JobSystem::UnregisterWaiter()
+{
+  for(;;)
+  {
+    s32 blockedWaiters = mBlockedWaiters.Load();
+    // Registrations are interchangeable, if none are left a wake claimed ours
+    if(blockedWaiters == 0)
+      return false;
+    if(mBlockedWaiters.CompareExchangeBool(blockedWaiters - 1, blockedWaiters))
+      return true;
+  }
+}
+
+// Failed attempts to find work before a waiting thread blocks
+const uint cWaitSpinCount = 64;
+
+void JobSystem::WaitForJob(Job* job)
+{
+  JobWorker* worker = GetCurrentWorker();
+  uint failedAttempts = 0;
+  while(!job->IsCompleted())
+  {
+    // Help out instead of blocking, the job's children may be in a queue
+    if(Job* helpJob = FindJobToHelp(worker, job))
+    {
+      ExecuteJob(helpJob);
+      failedAttempts = 0;
+      continue;
+    }
+
+    if(++failedAttempts < cWaitSpinCount)
+    {
+      Os::Sleep(0);
+      continue;
+    }
+
+    // Workers are shutting down and nothing would wake us, keep polling
+    if(!mWorkerThreadsActive)
+    {
+      Os::Sleep(1);
+      continue;
+    }
+
+    // The rest of the job is running on other threads, block until a job completes
+    // or more work is added. The count is published before checking the job again
+    // so a job finishing in between always sees us and releases the semaphore.
+    ++mBlockedWaiters;
+    if((job->IsCompleted() || !mWorkerThreadsActive) && UnregisterWaiter())
+    {
+      failedAttempts = 0;
+      continue;
+    }
+    mWaiterSemaphore.WaitAndDecrement();
+    failedAttempts = 0;
+  }
 }
 
 }//zero
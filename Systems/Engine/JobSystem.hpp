@@ -1,7 +1,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \file JobSystem.hpp
-/// 
+///
 ///
 /// Authors: Chris Peters
 /// Copyright 2010-2011, DigiPen Institute of Technology
@@ -15,6 +15,8 @@
 namespace Zero
 {
 
+class JobWorker;
+
 //-------------------------------------------------------------------------- Job
 class Job : public EventObject
 {
@@ -28,39 +30,181 @@ public:
 
   // Called from a different thread, typically setting a bool to stop
   virtual int Cancel(){return 0;};
-  
+
   /// We don't want to create an OsEvent for every job, so only call this if you
-  /// need it. Creating an OsEvent on this job will also set 
+  /// need it. Creating an OsEvent on this job will also set
   /// mDeletedOnCompletion to false, as the job must be alive to wait on the OsEvent.
   OsEvent* InitializeOsEvent();
 
+  /// A job is completed once it has executed and all of its child jobs have completed.
+  /// Only valid to query on jobs that are not deleted on completion. The OsEvent is
+  /// signaled after the job is marked completed, so jobs with an OsEvent must be
+  /// waited on through the event before they are deleted.
+  bool IsCompleted();
+
   bool mDeletedOnCompletion;
   OsEvent* mOsEvent;
   Link<Job> link;
+
+private:
+  friend class JobSystem;
+  // Starts at one for the job itself and is incremented for every child job.
+  // The job completes (and notifies its parent) when this reaches zero.
+  Atomic<s32> mUnfinishedJobs;
+  Job* mParent;
 };
 
 //------------------------------------------------------------------- Job System
+/// Work stealing job scheduler. Every worker thread (and the thread that created
+/// the job system) owns a lock-free deque it pushes to and pops from, idle workers
+/// steal from the other deques. Jobs added from threads that do not own a deque go
+/// through a locked injection queue.
 class JobSystem
 {
 public:
   JobSystem();
   ~JobSystem();
-  
-  void AddJob(Job* job);
-  OsInt WorkerThreadEntry();
+
+  /// Schedules the job. If a parent is given the parent will not complete until
+  /// this job has completed (the parent must not have completed yet).
+  void AddJob(Job* job, Job* parent = nullptr);
+
+  /// Executes other jobs on the calling thread until the given job has completed.
+  void WaitForJob(Job* job);
+
+  /// Runs function(index) for every index in [start, end) across all workers in
+  /// batches of grainSize indices. The calling thread participates and the call
+  /// returns once every index has been processed.
+  template <typename FunctionType>
+  void ParallelFor(uint start, uint end, uint grainSize, FunctionType function);
+
+  /// Number of threads executing jobs (including the owning thread).
+  uint GetWorkerCount();
+
+  OsInt WorkerThreadEntry(JobWorker* worker);
 
 private:
+  /// Returns the worker owned by the calling thread or null.
+  JobWorker* GetCurrentWorker();
+  /// Finds a job to run from the given worker's deque, the injection queue,
+  /// or by stealing from other workers.
+  Job* FindJob(JobWorker* worker);
+  /// Finds a job a thread waiting on the given job may run. Only the awaited job's
+  /// descendants are returned, anything else is handed back to the worker threads.
+  Job* FindJobToHelp(JobWorker* worker, Job* awaitedJob);
+  void ExecuteJob(Job* job);
+  /// Called when a job (or one of its children) finished.
+  void JobFinished(Job* job);
+  /// Releases every thread blocked in WaitForJob so it can check its job again.
+  void WakeWaiters();
+  /// Takes back a waiter count published before blocking. Returns false if a
+  /// wake already claimed it, the waiter then owes one semaphore decrement.
+  bool UnregisterWaiter();
+
   ThreadLock mLock;
   InList<Job> PendingJobs;
-  InList<Job> ActiveJobs;
+  Atomic<s32> mPendingCount;
   Array<Thread*> Workers;
+  /// Deques for every worker thread, the last one is owned by the creating thread.
+  Array<JobWorker*> mWorkerQueues;
   Semaphore mJobCounter;
-  Job* GetNextJob();
-  void JobFinished(Job* job);
-  bool mWorkerThreadsActive;
+  /// Threads in WaitForJob that gave up spinning block on this until a job
+  /// completes or new work is added. Every count released on the semaphore
+  /// claims one registered waiter so no counts are left over.
+  Semaphore mWaiterSemaphore;
+  Atomic<s32> mBlockedWaiters;
+  volatile bool mWorkerThreadsActive;
   friend class Job;
 };
 
+//-------------------------------------------------------------- Parallel For Job
+/// Helper job used by JobSystem::ParallelFor. Every instance claims batches of
+/// indices from a shared counter until the range is exhausted.
+template <typename FunctionType>
+class ParallelForJob : public Job
+{
+public:
+  ParallelForJob(Atomic<s64>* nextIndex, uint end, uint grainSize, FunctionType* function)
+    : mNextIndex(nextIndex), mEnd(end), mGrainSize(grainSize), mFunction(function)
+  {
+  }
+
+  int Execute() override
+  {
+    RunBatches(mNextIndex, mEnd, mGrainSize, *mFunction);
+    return 0;
+  }
+
+  static void RunBatches(Atomic<s64>* nextIndex, uint end, uint grainSize, FunctionType& function)
+  {
+    // The counter is 64 bit so it can't wrap when claiming past the end of a range near UINT_MAX
+    for(;;)
+    {
+      s64 batchStart = nextIndex->FetchAdd((s64)grainSize);
+      if(batchStart >= (s64)end)
+        return;
+
+      s64 batchEnd = batchStart + grainSize;
+      if(batchEnd > (s64)end)
+        batchEnd = end;
+
+      for(s64 i = batchStart; i < batchEnd; ++i)
+        function((uint)i);
+    }
+  }
+
+  Atomic<s64>* mNextIndex;
+  uint mEnd;
+  uint mGrainSize;
+  FunctionType* mFunction;
+};
+
+/// Job used as the parent of all the helpers of a parallel for, it does no work itself.
+class ParallelForRootJob : public Job
+{
+public:
+  int Execute() override { return 0; }
+};
+
+template <typename FunctionType>
+void JobSystem::ParallelFor(uint start, uint end, uint grainSize, FunctionType function)
+{
+  if(start >= end)
+    return;
+  if(grainSize == 0)
+    grainSize = 1;
+
+  Atomic<s64> nextIndex((s64)start);
+
+  // Don't spawn more helpers than there are batches (the calling thread takes one)
+  uint batchCount = (end - start + grainSize - 1) / grainSize;
+  uint helperCount = Math::Min(batchCount, GetWorkerCount()) - 1;
+  if(!ThreadingEnabled)
+    helperCount = 0;
+
+  // Helpers reference the stack state so they are owned here and joined before returning
+  ParallelForRootJob root;
+  root.mDeletedOnCompletion = false;
+
+  Array<ParallelForJob<FunctionType>*> helpers;
+  helpers.Reserve(helperCount);
+  for(uint i = 0; i < helperCount; ++i)
+  {
+    ParallelForJob<FunctionType>* helper = new ParallelForJob<FunctionType>(&nextIndex, end, grainSize, &function);
+    helper->mDeletedOnCompletion = false;
+    helpers.PushBack(helper);
+    AddJob(helper, &root);
+  }
+
+  ParallelForJob<FunctionType>::RunBatches(&nextIndex, end, grainSize, function);
+
+  // The root has no work of its own, finishing it leaves only the helpers outstanding
+  JobFinished(&root);
+  WaitForJob(&root);
+
+  DeleteObjectsInContainer(helpers);
+}
+
 namespace Z
 {
   extern JobSystem* gJobs;
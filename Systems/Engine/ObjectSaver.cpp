@@ -42,6 +42,27 @@ void ObjectSaver::SaveFullObject(Object* object)
   SaveObject(object, object, path, false, InheritIdContext::Instance);
 }
 
+//**************************************************************************************************
+AsyncFileBatch* ObjectSaver::CloseAsync(StringParam fileName)
+{
+  AsyncFileBatch* batch = ExtractWriteBatch(fileName);
+  Z::gFileIo->Submit(batch);
+  return batch;
+}
+
+//**************************************************************************************************
+AsyncFileBatch* ObjectSaver::ExtractWriteBatch(StringParam fileName)
+{
+  ErrorIf(!mFilename.Empty(), "Saver was opened with a file, use OpenBuffer to save asynchronously.");
+
+  DataBlock data = ExtractAsDataBlock();
+  Close();
+
+  AsyncFileBatch* batch = new AsyncFileBatch();
+  batch->AddWrite(fileName, data, true);
+  return batch;
+}
+
 //**************************************************************************************************
 void ObjectSaver::SaveObject(Object* object, Object* propertyPathParent, PropertyPath& path,
                              bool patching, InheritIdContext::Enum context)
@@ -37,7 +37,24 @@ public:
   /// e.g. saving the state of an object when saving game progress in an exported game.
   void SaveFullObject(Object* object);
 
+  /// Non-blocking alternative to saving to a file. Save to a buffer (OpenBuffer)
+  /// then call this to write the saved text to the file on the file io threads.
+  /// The returned batch completes once the file has been written, the caller
+  /// owns it and must not delete it before then.
+  AsyncFileBatch* CloseAsync(StringParam fileName);
+
+  /// Same as above, but Events::AsyncFileCompleted is sent to the object on the
+  /// main thread once the file has been written (the event owns the batch).
+  template <typename type>
+  void CloseAsync(StringParam fileName, type* notifyObject)
+  {
+    SubmitAsyncFileBatch(ExtractWriteBatch(fileName), notifyObject);
+  }
+
 private:
+  /// Moves the saved text into a batch that writes it to the file.
+  AsyncFileBatch* ExtractWriteBatch(StringParam fileName);
+
   void SaveObject(Object* object, Object* propertyPathParent, PropertyPath& path, bool patching,
                   InheritIdContext::Enum context);
 
@@ -72,7 +72,8 @@ public:
   String Location;
   String FullPath;
 
-  //Loading from Data.
+  //Loading from Data. May point at memory owned elsewhere (a MappedFile or an async
+  //read), loaders read from it in place so it must stay valid until the load returns.
   DataBlock Block;
 
   //Only available when the editor is active.
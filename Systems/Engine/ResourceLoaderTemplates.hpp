@@ -48,22 +48,45 @@ public:
   {
     ResourceType* resource = new ResourceType();
     resource->mContentItem = entry.mLibrarySource;
+    if(LoadFromDataBlock(*resource, entry.Block, defaultFormat))
+    {
+      if(entry.mBuilder)
+        resource->FilterTag = entry.mBuilder->GetTag();
 
-    LoadFromDataBlock(*resource, entry.Block, defaultFormat);
-    resource->Initialize();
-
-    ResourceMananger::GetInstance()->AddResource(entry, resource);
-
-    return resource;
+      resource->Name = entry.Name;
+      resource->Initialize();
+      ResourceMananger::GetInstance()->AddResource(entry, resource);
+      return resource;
+    }
+    else
+    {
+      delete resource;
+      return nullptr;
+    }
   }
 
   void ReloadFromFile(Resource* resourceToReload, ResourceEntry& entry) override
   {
     ResourceType* resource = (ResourceType*)resourceToReload;
     resource->Unload();
-    LoadFromDataFile(*resource, entry.FullPath, defaultFormat, false);
+
+    // Binary files are loaded from a mapping, but a reloaded file may still be
+    // written to (reading a mapping past a truncated end is a fatal SIGBUS)
+    if(defaultFormat == DataFileFormat::Binary)
+    {
+      DataBlock block = ReadFileIntoDataBlock(entry.FullPath.c_str());
+      LoadFromDataBlock(*resource, block, defaultFormat);
+      FreeBlock(block);
+    }
+    else
+    {
+      LoadFromDataFile(*resource, entry.FullPath, defaultFormat, false);
+    }
+
     resource->Initialize();
   }
+
+  bool CanLoadFileFromBlock() override { return true; }
 };
 
 template<typename ResourceMananger>
@@ -165,14 +188,10 @@ public:
   {
     ResourceType* newResource = new ResourceType();
 
-    ChunkFileReader reader;
-    reader.Open(entry.FullPath);
-
-    LoadPattern::Load(newResource, reader);
+    LoadChunksMapped(newResource, entry);
 
     ResourceMananger::GetInstance()->AddResource(entry, newResource);
 
-    reader.Close();
     return newResource;
   }
 
@@ -195,14 +214,40 @@ public:
     ResourceType* newResource = (ResourceType*)resource;
     newResource->Unload();
 
-    ChunkFileReader reader;
-    reader.Open(entry.FullPath);
-
-    LoadPattern::Load(newResource, reader);
+    // Reloads happen while the file may still be written to (reading a mapping
+    // past a truncated end is a fatal SIGBUS) so they always read through the file
+    LoadChunksFromFile(newResource, entry);
 
     resource->SendModified();
   }
 
+  bool CanLoadFileFromBlock() override { return true; }
+
+  // Reads the chunks straight out of the mapped file, falling back
+  // to reading through the file if it could not be mapped
+  void LoadChunksMapped(ResourceType* resource, ResourceEntry& entry)
+  {
+    Status status;
+    MappedFile mappedFile;
+    if(mappedFile.Open(status, entry.FullPath))
+    {
+      ChunkBufferReader reader;
+      reader.Open(mappedFile.GetBlock());
+      LoadPattern::Load(resource, reader);
+      return;
+    }
+
+    LoadChunksFromFile(resource, entry);
+  }
+
+  void LoadChunksFromFile(ResourceType* resource, ResourceEntry& entry)
+  {
+    ChunkFileReader reader;
+    reader.Open(entry.FullPath);
+    LoadPattern::Load(resource, reader);
+    reader.Close();
+  }
+
 };
 
 }
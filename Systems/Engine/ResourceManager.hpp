@@ -197,6 +197,11 @@ public:
   virtual HandleOf<Resource> LoadFromFile(ResourceEntry& entry) = 0;
   virtual void ReloadFromFile(Resource* resource, ResourceEntry& entry) {}
   virtual HandleOf<Resource> LoadFromBlock(ResourceEntry& entry) { return nullptr; }
+
+  /// Whether LoadFromBlock creates the same resource as LoadFromFile when the block
+  /// holds the contents of the file. Files that were read ahead of time (see
+  /// ResourceSystem::LoadPackageAsync) are only loaded from memory if this is true.
+  virtual bool CanLoadFileFromBlock() { return false; }
 };
 
 //------------------------------------------------------------ Native Resource Manager Setup
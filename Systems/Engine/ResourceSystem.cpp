@@ -40,6 +40,7 @@ ResourceSystem::ResourceSystem()
 
   // Only need to listen for the resource package for 'Loading'
   ConnectThisTo(this, Events::ResourcesLoaded, OnResourcesLoaded);
+  ConnectThisTo(this, Events::AsyncFileCompleted, OnPackageFilesRead);
 }
 
 void ResourceSystem::Initialize()
@@ -52,7 +53,7 @@ void ResourceSystem::OnResourcesLoaded(ResourceEvent* event)
   if (event->Name == "Loading")
   {
     Z::gEngine->mHaveLoadingResources = true;
-    GetDispatcher()->Disconnect(this);
+    GetDispatcher()->DisconnectEvent(Events::ResourcesLoaded, this);
   }
 }
 
@@ -165,6 +166,62 @@ ResourceLibrary* ResourceSystem::LoadPackage(Status& status, ResourcePackage* pa
   return resourceLibrary;
 }
 
+void ResourceSystem::LoadPackageAsync(ResourcePackage* package)
+{
+  // Read the resource files off of the main thread, the package
+  // itself is loaded once all of the files are in memory
+  AsyncFileBatch* batch = new AsyncFileBatch();
+  forRange(ResourceEntry& entry, package->Resources.All())
+  {
+    entry.FullPath = FilePath::Combine(package->Location, entry.Location);
+
+    // Only loaders that can load from a block use the data, every other
+    // loader reads the file itself and would read it a second time
+    String type = (entry.Type == "LevelSettings") ? String("Cog") : entry.Type;
+    LoaderRange range = mLoaderMap.Find(type);
+    if(!range.Empty() && range.Front().second->CanLoadFileFromBlock())
+      batch->AddRead(entry.FullPath);
+  }
+
+  mPendingPackages.Insert(batch, package);
+  SubmitAsyncFileBatch(batch, this);
+}
+
+void ResourceSystem::OnPackageFilesRead(AsyncFileEvent* event)
+{
+  AsyncFileBatch* batch = event->Batch;
+  ResourcePackage* package = mPendingPackages.FindValue(batch, nullptr);
+  if(package == nullptr)
+    return;
+  mPendingPackages.Erase(batch);
+
+  // Loaders read the blocks in place, the data is freed along with the event.
+  // Files that were not read (or failed to read) are loaded from the file as usual.
+  // Requests were added in the same order as the entries they read.
+  uint requestIndex = 0;
+  forRange(ResourceEntry& entry, package->Resources.All())
+  {
+    if(requestIndex == batch->Requests.Size())
+      break;
+
+    AsyncFileRequest* request = batch->Requests[requestIndex];
+    if(request->FilePath != entry.FullPath)
+      continue;
+
+    ++requestIndex;
+    if(request->Result.Succeeded())
+      entry.Block = request->Data;
+  }
+
+  Status status;
+  LoadPackage(status, package);
+  if(!status)
+    DoNotifyError("Failed to load resource package.", status.Message);
+
+  forRange(ResourceEntry& entry, package->Resources.All())
+    entry.Block = DataBlock();
+}
+
 ResourceLibrary* ResourceSystem::GetResourceLibrary(StringParam name)
 {
   return LoadedResourceLibraries.FindValue(name, nullptr);
@@ -342,7 +399,17 @@ HandleOf<Resource> ResourceSystem::LoadEntry(Status& status, ResourceEntry& elem
   LoaderRange range = mLoaderMap.Find(element.Type);
   if(!range.Empty())
   {
-    HandleOf<Resource> newResource =  range.Front().second->LoadFromFile(element);
+    ResourceLoader* loader = range.Front().second;
+
+    // The file was already read into memory (see LoadPackageAsync)
+    if(element.Block.Data != nullptr && loader->CanLoadFileFromBlock())
+    {
+      HandleOf<Resource> newResource = loader->LoadFromBlock(element);
+      if(newResource)
+        return newResource;
+    }
+
+    HandleOf<Resource> newResource = loader->LoadFromFile(element);
     //ideally we'd do a check here, but some resources don't load anything (fragments)
     return newResource;
   }
@@ -59,6 +59,12 @@ public:
   // Load a resource package
   ResourceLibrary* LoadPackage(Status& status, ResourcePackage* package);
 
+  // Load a resource package without blocking on file reads. The files are read on
+  // the file io threads and the package is loaded on the main thread once they are
+  // all in memory (PackagedFinished is sent then). The package must stay alive until then.
+  void LoadPackageAsync(ResourcePackage* package);
+  void OnPackageFilesRead(AsyncFileEvent* event);
+
   // Reload all resource in package into resource library.
   void ReloadPackage(ResourceLibrary* resourceLibrary, ResourcePackage* package);
 
@@ -113,6 +119,9 @@ public:
   LoaderMapType mLoaderMap;
 
   Array<ResourceManager*> mResourceManagers;
+
+  //Packages waiting on their files to be read
+  HashMap<AsyncFileBatch*, ResourcePackage*> mPendingPackages;
 };
 
 namespace Z
@@ -20,7 +20,7 @@ namespace Events
   DefineEvent(SpaceDestroyed);
 }//namespace Events
 
-Memory::Pool* Space::sCogLists = new Memory::Pool("CogLists", Memory::GetNamedHeap("CogList"), sizeof(NameCogList), 64);
+Memory::ConcurrentPool* Space::sCogLists = new Memory::ConcurrentPool("CogLists", Memory::GetNamedHeap("CogList"), sizeof(NameCogList), 64);
 
 ZilchDefineType(Space, builder, type)
 {
@@ -70,6 +70,7 @@ Space::Space()
   mIsLoadingLevel = false;
   mInvalidObjectPositionOccurred = false;
   mMaxObjectPosition = real(1e+10);
+  mTransformStore = nullptr;
 }
 
 Space::~Space()
@@ -80,6 +81,15 @@ Space::~Space()
   // Remove ourself from the game session list
   if (GameSession* gameSession = GetGameSession())
     gameSession->InternalRemove(this);
+
+  SafeDelete(mTransformStore);
+}
+
+TransformStore* Space::GetTransformStore()
+{
+  if(mTransformStore == nullptr)
+    mTransformStore = new TransformStore();
+  return mTransformStore;
 }
 
 bool Space::IsEditorMode()
@@ -181,7 +181,7 @@ public:
   typedef HashMap<String, NameCogList*> CogNameMap;
   CogNameMap mNameMap;
 
-  static Memory::Pool* sCogLists;
+  static Memory::ConcurrentPool* sCogLists;
 
   void AddToNameMap(Cog* cog, StringParam name);
   void RemoveFromNameMap(Cog* cog, StringParam name);
@@ -193,6 +193,11 @@ public:
   float mMaxObjectPosition;
   bool mInvalidObjectPositionOccurred;
 
+  /// World matrices of the space's transforms when Transform::sUseTransformStore
+  /// is enabled (created on first use, may be null).
+  TransformStore* GetTransformStore();
+  TransformStore* mTransformStore;
+
   // Last level loaded into the space
   HandleOf<Level> mLevelLoaded;
 
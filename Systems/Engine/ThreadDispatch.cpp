@@ -14,8 +14,60 @@ namespace Z
 ThreadDispatch* gDispatch = nullptr;
 }
 
+//-------------------------------------------------------------------ThreadDispatchCounters
+Profile::ProfileTime GetDispatchTime()
+{
+  return Profile::ProfileSystem::Instance->GetTime();
+}
+
+ThreadDispatchCounters::ThreadDispatchCounters()
+{
+  Reset();
+}
+
+void ThreadDispatchCounters::RecordDepth(uint depth)
+{
+  mMaxQueueDepth = Math::Max(mMaxQueueDepth, depth);
+}
+
+void ThreadDispatchCounters::RecordDispatch(Profile::ProfileTime queuedTime, Profile::ProfileTime dispatchTime)
+{
+  // The timer isn't guaranteed to be monotonic across cores
+  Profile::ProfileTime latency = dispatchTime > queuedTime ? dispatchTime - queuedTime : 0;
+  ++mEventsDispatched;
+  mTotalLatency += latency;
+  mMaxLatency = Math::Max(mMaxLatency, latency);
+}
+
+ThreadDispatchStats ThreadDispatchCounters::GetStats(uint queueDepth)
+{
+  Profile::ProfileSystem* profiler = Profile::ProfileSystem::Instance;
+
+  ThreadDispatchStats stats;
+  stats.QueueDepth = queueDepth;
+  stats.MaxQueueDepth = Math::Max(mMaxQueueDepth, queueDepth);
+  stats.EventsDispatched = mEventsDispatched;
+  stats.AverageLatency = 0.0f;
+  if(mEventsDispatched != 0)
+    stats.AverageLatency = profiler->GetTimeInSeconds(mTotalLatency) / float(mEventsDispatched);
+  stats.MaxLatency = profiler->GetTimeInSeconds(mMaxLatency);
+  return stats;
+}
+
+void ThreadDispatchCounters::Reset()
+{
+  mMaxQueueDepth = 0;
+  mEventsDispatched = 0;
+  mTotalLatency = 0;
+  mMaxLatency = 0;
+}
+
 //-------------------------------------------------------------------ThreadDispatch
+Memory::ConcurrentPool* ThreadDispatch::sNodePool = new Memory::ConcurrentPool("ThreadDispatchQueue",
+  Memory::GetRoot(), MpscQueue<QueuedEvent>::cNodeSize, 64);
+
 ThreadDispatch::ThreadDispatch()
+  : mEvents(sNodePool)
 {
   Z::gDispatch = this;
 }
@@ -37,24 +89,23 @@ void ThreadDispatch::DispatchOn(HandleParam object, EventDispatcher* eventDispat
   queuedEvent.EventToSend = event;
   queuedEvent.EventDispatcherOn = eventDispatcher;
   queuedEvent.EventId  = eventId;
+  queuedEvent.QueuedTime = GetDispatchTime();
 
-  mLock.Lock();
-  mEvents.PushBack(queuedEvent);
-  mLock.Unlock();
+  mEvents.Enqueue(queuedEvent);
 }
 
 void ThreadDispatch::DispatchEvents()
 {
-  Array<QueuedEvent> eventsToDispatch;
-
-  //To avoid dead lock pull out all message before dispatching
-  //(dispatching may add more events)
-  mLock.Lock();
-  eventsToDispatch.Swap(mEvents);
-  mLock.Unlock();
+  //Only dispatch what was queued before we started, dispatching
+  //may queue more events and those are sent next time
+  uint count = mEvents.Count();
+  mCounters.RecordDepth(count);
 
-  forRange(QueuedEvent& queuedEvent, eventsToDispatch.All())
+  QueuedEvent queuedEvent;
+  for(uint i = 0; i < count && mEvents.Dequeue(queuedEvent); ++i)
   {
+    mCounters.RecordDispatch(queuedEvent.QueuedTime, GetDispatchTime());
+
     //Check to see if the object is still alive
     if(queuedEvent.Object.IsNull() == false)
       queuedEvent.EventDispatcherOn->Dispatch(queuedEvent.EventId, queuedEvent.EventToSend);
@@ -62,26 +113,31 @@ void ThreadDispatch::DispatchEvents()
     //delete the event
     delete queuedEvent.EventToSend;
   }
-  eventsToDispatch.Clear();
 }
 
 void ThreadDispatch::ClearEvents()
 {
-  Array<QueuedEvent> eventsToDispatch;
+  QueuedEvent queuedEvent;
+  while(mEvents.Dequeue(queuedEvent))
+    delete queuedEvent.EventToSend;
+}
 
-  mLock.Lock();
-  eventsToDispatch.Swap(mEvents);
-  mLock.Unlock();
+ThreadDispatchStats ThreadDispatch::GetStats()
+{
+  return mCounters.GetStats(mEvents.Count());
+}
 
-  forRange(QueuedEvent& queuedEvent, eventsToDispatch.All())
-  {
-    delete queuedEvent.EventToSend;
-  }
-  eventsToDispatch.Clear();
+void ThreadDispatch::ResetStats()
+{
+  mCounters.Reset();
 }
 
 //-------------------------------------------------------------------ObjectThreadDispatch
+Memory::ConcurrentPool* ObjectThreadDispatch::sNodePool = new Memory::ConcurrentPool("ObjectThreadDispatchQueue",
+  Memory::GetRoot(), MpscQueue<ObjectQueuedEvent>::cNodeSize, 64);
+
 ObjectThreadDispatch::ObjectThreadDispatch()
+  : mEvents(sNodePool)
 {
   ConnectThisTo(Z::gEngine, Events::EngineUpdate, OnEngineUpdate);
 }
@@ -97,44 +153,34 @@ void ObjectThreadDispatch::Dispatch(Object* object, StringParam eventId, Event*
   queuedEvent.EventToSend = event;
   queuedEvent.EventDispatcherOn = object->GetDispatcher();
   queuedEvent.EventId = eventId;
+  queuedEvent.QueuedTime = GetDispatchTime();
 
-  mLock.Lock();
-  mEvents.PushBack(queuedEvent);
-  mLock.Unlock();
+  mEvents.Enqueue(queuedEvent);
 }
 
 void ObjectThreadDispatch::DispatchEvents()
 {
-  Array<ObjectQueuedEvent> eventsToDispatch;
+  // Only dispatch what was queued before we started (dispatching may add more events)
+  uint count = mEvents.Count();
+  mCounters.RecordDepth(count);
 
-  // To avoid dead lock pull out all message before dispatching (dispatching may add more events)
-  mLock.Lock();
-  eventsToDispatch.Swap(mEvents);
-  mLock.Unlock();
-
-  forRange(ObjectQueuedEvent& queuedEvent, eventsToDispatch.All())
+  ObjectQueuedEvent queuedEvent;
+  for(uint i = 0; i < count && mEvents.Dequeue(queuedEvent); ++i)
   {
+    mCounters.RecordDispatch(queuedEvent.QueuedTime, GetDispatchTime());
+
     queuedEvent.EventDispatcherOn->Dispatch(queuedEvent.EventId, queuedEvent.EventToSend);
 
     // Delete the event
     delete queuedEvent.EventToSend;
   }
-  eventsToDispatch.Clear();
 }
 
 void ObjectThreadDispatch::ClearEvents()
 {
-  Array<ObjectQueuedEvent> eventsToDispatch;
-
-  mLock.Lock();
-  eventsToDispatch.Swap(mEvents);
-  mLock.Unlock();
-
-  forRange(ObjectQueuedEvent& queuedEvent, eventsToDispatch.All())
-  {
+  ObjectQueuedEvent queuedEvent;
+  while(mEvents.Dequeue(queuedEvent))
     delete queuedEvent.EventToSend;
-  }
-  eventsToDispatch.Clear();
 }
 
 void ObjectThreadDispatch::OnEngineUpdate(Event* e)
@@ -142,17 +188,29 @@ void ObjectThreadDispatch::OnEngineUpdate(Event* e)
   DispatchEvents();
 }
 
+ThreadDispatchStats ObjectThreadDispatch::GetStats()
+{
+  return mCounters.GetStats(mEvents.Count());
+}
+
+void ObjectThreadDispatch::ResetStats()
+{
+  mCounters.Reset();
+}
 
 void StartThreadSystem()
 {
   Z::gDispatch = new ThreadDispatch();
   Z::gJobs = new JobSystem();
+  Z::gFileIo = new AsyncFileIo();
 }
 
 void ShutdownThreadSystem()
 {
   // This is important that the jobs are deleted first, because the job threads could be using the gDispatch
   SafeDelete(Z::gJobs);
+  // Waits for outstanding file io, completions are sent through gDispatch
+  SafeDelete(Z::gFileIo);
   SafeDelete(Z::gDispatch);
 }
 
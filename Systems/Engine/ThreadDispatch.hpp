@@ -17,6 +17,40 @@ struct QueuedEvent
   String EventId;
   Event* EventToSend;
   EventDispatcher* EventDispatcherOn;
+  Profile::ProfileTime QueuedTime;
+};
+
+//-------------------------------------------------------------------ThreadDispatchStats
+/// Counters for the events sent through a thread dispatch.
+struct ThreadDispatchStats
+{
+  /// Events queued but not dispatched yet.
+  uint QueueDepth;
+  /// The most events that were waiting when the queue was pumped.
+  uint MaxQueueDepth;
+  /// Events dispatched since the stats were last reset.
+  uint EventsDispatched;
+  /// Seconds between an event being queued and dispatched.
+  float AverageLatency;
+  float MaxLatency;
+};
+
+/// Accumulates the stats as events are dispatched (only touched by the consumer).
+class ThreadDispatchCounters
+{
+public:
+  ThreadDispatchCounters();
+
+  void RecordDepth(uint depth);
+  void RecordDispatch(Profile::ProfileTime queuedTime, Profile::ProfileTime dispatchTime);
+  ThreadDispatchStats GetStats(uint queueDepth);
+  void Reset();
+
+private:
+  uint mMaxQueueDepth;
+  uint mEventsDispatched;
+  Profile::ProfileTime mTotalLatency;
+  Profile::ProfileTime mMaxLatency;
 };
 
 //-------------------------------------------------------------------ThreadDispatch
@@ -36,9 +70,16 @@ public:
   void DispatchEvents();
   void ClearEvents();
 
+  ThreadDispatchStats GetStats();
+  void ResetStats();
+
+  /// Queue nodes are shared by every thread dispatch.
+  static Memory::ConcurrentPool* sNodePool;
+
 private:
-  ThreadLock mLock;
-  Array<QueuedEvent> mEvents;
+  /// Any thread may queue an event, only the main thread dispatches them.
+  MpscQueue<QueuedEvent> mEvents;
+  ThreadDispatchCounters mCounters;
 };
 
 //-------------------------------------------------------------------ObjectThreadDispatch
@@ -54,6 +95,7 @@ public:
     String EventId;
     Event* EventToSend;
     EventDispatcher* EventDispatcherOn;
+    Profile::ProfileTime QueuedTime;
   };
 
   ObjectThreadDispatch();
@@ -69,9 +111,16 @@ public:
 
   /// Automatically flushes the event list each engine update.
   void OnEngineUpdate(Event* e);
+
+  ThreadDispatchStats GetStats();
+  void ResetStats();
+
+  /// Queue nodes are shared by every object thread dispatch.
+  static Memory::ConcurrentPool* sNodePool;
+
 private:
-  ThreadLock mLock;
-  Array<ObjectQueuedEvent> mEvents;
+  MpscQueue<ObjectQueuedEvent> mEvents;
+  ThreadDispatchCounters mCounters;
 };
 
 namespace Z
@@ -70,6 +70,7 @@ ZilchDefineType(TimeSpace, builder, type)
   ZilchBindField(mRealTimePassed);
   ZilchBindField(mFrame);
   ZilchBindFieldProperty(mStepCount);
+  ZilchBindFieldProperty(mIsolated);
 }
 
 TimeSpace::TimeSpace()
@@ -77,6 +78,8 @@ TimeSpace::TimeSpace()
   mTimeSystem = NULL;
   
   mPaused = false;
+  mIsolated = false;
+  mRunsScripts = false;
   mFrame = 0;
 
   mRealTimePassed = 0.0;
@@ -99,6 +102,7 @@ void TimeSpace::Serialize(Serializer& stream)
   SerializeNameDefault(mTimeScale, 1.0f);
   SerializeEnumNameDefault(TimeMode, mTimeMode, TimeMode::FixedFrametime);
   SerializeNameDefault(mStepCount, (uint)1);
+  SerializeNameDefault(mIsolated, false);
 }
 
 void TimeSpace::Initialize(CogInitializer& initializer)
@@ -147,12 +151,6 @@ void TimeSpace::Update(float dt)
   Array<NotificationCallback>& cb = Z::gNotifyCallbackStack;
   space->CheckForChangedObjects();
 
-  //push on id of this space for the debug drawer so anyone who debug
-  //draws will by default be in the correct space.
-  //Debug::DefaultConfig config;
-  //config.SpaceId(this->GetOwner()->GetId().Id);
-  Debug::ActiveDrawSpace drawSpace(GetOwner()->GetId().Id);
-
   mRealDt = dt;  
 
   if (mTimeMode == TimeMode::FixedFrametime)
@@ -174,6 +172,26 @@ void TimeSpace::Update(float dt)
   // We don't want the engine to lock down, so cap it at 60 steps per update
   mStepCount = Math::Clamp(mStepCount, 1u, 60u);
 
+  // The debug draw space stack is shared, so isolated spaces
+  // stepped on other threads draw into the default space
+  if(mTimeSystem->IsInParallelStep())
+  {
+    RunSteps();
+    return;
+  }
+
+  //push on id of this space for the debug drawer so anyone who debug
+  //draws will by default be in the correct space.
+  //Debug::DefaultConfig config;
+  //config.SpaceId(this->GetOwner()->GetId().Id);
+  Debug::ActiveDrawSpace drawSpace(GetOwner()->GetId().Id);
+  RunSteps();
+}
+
+void TimeSpace::RunSteps()
+{
+  Space* space = GetSpace();
+
   for (uint i = 0; i < mStepCount; ++i)
   {
     ++mFrame;
@@ -187,6 +205,7 @@ void TimeSpace::Update(float dt)
     {
       ProfileScopeTree("FrameUpdate", "TimeSystem", Color::PaleGoldenrod);
       dispatcher->Dispatch(Events::FrameUpdate, &updateEvent);
+      mUpdates.Update(UpdatePhase::Frame, &updateEvent);
     }
 
     {
@@ -208,6 +227,10 @@ void TimeSpace::Update(float dt)
       //dispatcher->Dispatch(Events::GraphicsFrameUpdate, &updateEvent);
     }
   }
+
+  // Recompute everything moved this frame before it's rendered
+  if(space->mTransformStore)
+    space->mTransformStore->UpdateWorldMatrices();
 }
 
 void TimeSpace::TogglePause()
@@ -233,6 +256,7 @@ void TimeSpace::Step()
   {
     ProfileScopeTree("LogicUpdate", "TimeSystem", Color::Gainsboro);
     dispatcher->Dispatch(Events::LogicUpdate, &updateEvent);
+    mUpdates.Update(UpdatePhase::Logic, &updateEvent);
   }
 
   {
@@ -267,17 +291,24 @@ void TimeSystem::Initialize(SystemInitializer& initializer)
   // This also improves the response of other wait calls but does
   // increase power consumption.
   Os::SetTimerFrequency(1);
+
+  mSyncDispatch = new ObjectThreadDispatch();
 }
 
 TimeSystem::TimeSystem()
 {
   mEngineDt = 0.0f;
   mEngineRuntime = 0.0;
+  mFixedTickRate = 0;
+  mNextTickTime = 0.0;
+  mParallelIsolatedSpaces = false;
+  mInParallelStep = false;
+  mSyncDispatch = nullptr;
 }
 
 TimeSystem::~TimeSystem()
 {
-
+  SafeDelete(mSyncDispatch);
 }
 
 void TimeSystem::Update()
@@ -289,7 +320,11 @@ void TimeSystem::Update()
   // but on some systems the vertical sync is disabled by the driver or the user.
   // Instead of wastefully drawing at maximum speed this try to sleep for the 
   // the rest of the frame. This reduces heat and power use on laptops.
-  if (mLimitFrameRate)
+  if (mFixedTickRate != 0)
+  {
+    dt = WaitForNextTick();
+  }
+  else if (mLimitFrameRate)
   {
     //ProfileScopeTree("Limiter", "Engine", Color::Green);
     const int limitError = 1;
@@ -321,13 +356,20 @@ void TimeSystem::Update()
   mEngineRuntime = mTimer.Time();
 
   // Update every space in the engine
+  Array<TimeSpace*> isolatedSpaces;
   TimeSpaceList::range range = List.All();
   for(; !range.Empty(); range.PopFront())
   {
     TimeSpace& timeSpace = range.Front();
-    timeSpace.Update(dt);
+    if(mParallelIsolatedSpaces && timeSpace.mIsolated && !timeSpace.mRunsScripts)
+      isolatedSpaces.PushBack(&timeSpace);
+    else
+      timeSpace.Update(dt);
   }
 
+  if(!isolatedSpaces.Empty())
+    UpdateIsolatedSpaces(isolatedSpaces, dt);
+
   UpdateEvent uiUpdate(dt, 0, 0, 0);
   GetDispatcher()->Dispatch("UiUpdate", &uiUpdate);
 }
@@ -337,6 +379,104 @@ float TimeSystem::GetTargetDt() const
   return 1.0f / mFrameRate;
 }
 
+void TimeSystem::SetFixedTickRate(uint ticksPerSecond)
+{
+  mFixedTickRate = ticksPerSecond;
+  mNextTickTime = 0.0;
+
+  // Keep the target dt (used by fixed frametime spaces) in sync with the tick rate
+  if (ticksPerSecond != 0)
+  {
+    mLimitFrameRate = true;
+    mFrameRate = ticksPerSecond;
+  }
+}
+
+void TimeSystem::SetParallelIsolatedSpaces(bool parallel)
+{
+  mParallelIsolatedSpaces = parallel;
+}
+
+bool TimeSystem::IsInParallelStep()
+{
+  return mInParallelStep;
+}
+
+void TimeSystem::DispatchAtSync(Object* object, StringParam eventId, Event* event)
+{
+  mSyncDispatch->Dispatch(object, eventId, event);
+}
+
+// Steps one isolated space on a worker
+struct IsolatedSpaceStep
+{
+  Array<TimeSpace*>* mSpaces;
+  float mDt;
+
+  void operator()(uint index)
+  {
+    (*mSpaces)[index]->Update(mDt);
+  }
+};
+
+void TimeSystem::UpdateIsolatedSpaces(Array<TimeSpace*>& spaces, float dt)
+{
+  ProfileScopeTree("IsolatedSpaces", "TimeSystem", Color::DarkOrange);
+
+  if(spaces.Size() == 1 || !ThreadingEnabled)
+  {
+    forRange(TimeSpace* timeSpace, spaces.All())
+      timeSpace->Update(dt);
+  }
+  else
+  {
+    // Objects are still given ids and looked up through the global
+    // tracker, so it is locked while the spaces are stepped. The pools
+    // shared by every space (islands, solvers, broad phase nodes, cog
+    // lists and data trees) are concurrent pools.
+    mInParallelStep = true;
+    Z::gTracker->SetThreadSafe(true);
+
+    IsolatedSpaceStep step = { &spaces, dt };
+    Z::gJobs->ParallelFor(0, spaces.Size(), 1, step);
+
+    Z::gTracker->SetThreadSafe(false);
+    mInParallelStep = false;
+  }
+
+  // Synchronization point, everything the spaces deferred is sent on this thread
+  mSyncDispatch->DispatchEvents();
+}
+
+float TimeSystem::WaitForNextTick()
+{
+  // If a tick took this many intervals too long (e.g. loading a level) the
+  // schedule is reset instead of running a burst of ticks to catch up
+  const double cMaxTickLag = 4.0;
+
+  double interval = 1.0 / double(mFixedTickRate);
+  double now = mTimer.UpdateAndGetTime();
+
+  if (mNextTickTime == 0.0 || now > mNextTickTime + interval * cMaxTickLag)
+    mNextTickTime = now;
+
+  // Sleep until the tick is due. Ticks are scheduled from the previous deadline rather
+  // than the previous frame so sleep rounding doesn't make the tick rate drift, and the
+  // last partial millisecond is not spun so an idle server uses next to no cpu.
+  while (now < mNextTickTime)
+  {
+    int sleepMs = int((mNextTickTime - now) * 1000.0);
+    if (sleepMs <= 0)
+      break;
+
+    Os::Sleep(sleepMs);
+    now = mTimer.UpdateAndGetTime();
+  }
+
+  mNextTickTime += interval;
+  return float(interval);
+}
+
 void TimeSystem::OnProjectLoaded(ObjectEvent* event)
 {
   if (mProjectCog.IsNotNull())
@@ -349,6 +489,10 @@ void TimeSystem::OnProjectLoaded(ObjectEvent* event)
 
 void TimeSystem::OnProjectCogModified(Event* event)
 {
+  // A fixed tick rate overrides the project's settings
+  if (mFixedTickRate != 0)
+    return;
+
   if (FrameRateSettings* frameRateSettings = mProjectCog.has(FrameRateSettings))
   {
     mLimitFrameRate = frameRateSettings->mLimitFrameRate;
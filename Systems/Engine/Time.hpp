@@ -27,6 +27,7 @@ namespace Events
 
 class TimeSystem;
 class TimeConfig;
+class ObjectThreadDispatch;
 System* CreateTimeSystem();
 
 //----------------------------------------------------------------- Update Event
@@ -133,7 +134,21 @@ public:
   /// Causes the engine to update multiple times before rendering a frame.
   uint mStepCount;
 
+  /// The space shares no objects with any other space, so when the TimeSystem is
+  /// set to update isolated spaces in parallel it may be stepped on another thread.
+  /// Anything that touches another space must go through TimeSystem::DispatchAtSync.
+  bool mIsolated;
+
+  /// Set once a script component is initialized in the space. Scripts share one
+  /// executable state, so the space is always stepped on the main thread after this.
+  bool mRunsScripts;
+
+  /// Components updated in batches after FrameUpdate / LogicUpdate are dispatched.
+  UpdateRegistry mUpdates;
+
   //Internals
+  /// Sends out the update events for every step of this frame.
+  void RunSteps();
   Link<TimeSpace> link;
   TimeSystem* mTimeSystem;
 };
@@ -155,6 +170,25 @@ public:
 
   float GetTargetDt() const;
 
+  /// Ticks the engine at exactly this rate (zero to disable), ignoring the project's
+  /// frame rate settings. Every frame is given the same dt and the time in between
+  /// ticks is slept rather than spun. Used by the headless server.
+  void SetFixedTickRate(uint ticksPerSecond);
+
+  /// Steps every TimeSpace marked as isolated concurrently on the JobSystem
+  /// (after all other spaces have been updated). Spaces that run scripts are
+  /// still stepped on the main thread, but a space is only known to run scripts
+  /// once a script component has been initialized in it (on the stepping thread).
+  /// Only enable this when no script component can be created during a step.
+  void SetParallelIsolatedSpaces(bool parallel);
+  /// Whether isolated spaces are currently being stepped concurrently.
+  bool IsInParallelStep();
+
+  /// Queues the event to be sent on the main thread once the isolated spaces have
+  /// finished stepping (the event is deleted after it is sent). Used by isolated
+  /// spaces for anything that affects another space or the engine.
+  void DispatchAtSync(Object* object, StringParam eventId, Event* event);
+
   void OnProjectLoaded(ObjectEvent* event);
   void OnProjectCogModified(Event* event);
 
@@ -169,10 +203,22 @@ public:
   HandleOf<Cog> mProjectCog;
   bool mLimitFrameRate;
   uint mFrameRate;
+  uint mFixedTickRate;
+  bool mParallelIsolatedSpaces;
 
 private:
+  /// Sleeps until the next fixed tick is due and returns the tick's dt.
+  float WaitForNextTick();
+  /// Steps the isolated spaces and then sends everything they deferred.
+  void UpdateIsolatedSpaces(Array<TimeSpace*>& spaces, float dt);
+
+  bool mInParallelStep;
+  ObjectThreadDispatch* mSyncDispatch;
+
   //Main system timer
   Timer mTimer;
+  // When the next fixed tick is due (in timer seconds)
+  double mNextTickTime;
 };
 
 }//namespace Zero
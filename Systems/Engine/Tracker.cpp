@@ -31,6 +31,7 @@ Tracker* Tracker::StaticInitialize()
 Tracker::Tracker()
 {
   mLastGameObjectId = 0;
+  mThreadSafe = false;
 }
 
 Tracker::~Tracker()
@@ -42,6 +43,8 @@ CogId Tracker::IdGameObject(Cog* gameObject)
 {
   ErrorIf(gameObject->mObjectId != cInvalidCogId, "Object Id is already set");
 
+  Lock();
+
   //Just increment the last id used.
   ++mLastGameObjectId;
 
@@ -50,16 +53,24 @@ CogId Tracker::IdGameObject(Cog* gameObject)
 
   //Store the game object in the global object id map
   mObjectMap.Insert(gameObject);
-  return gameObject->mObjectId;
+  CogId id = gameObject->mObjectId;
+
+  Unlock();
+  return id;
 }
 
 Cog* Tracker::GetObjectWithId(CogId id)
 {
+  Lock();
   ObjectMapType::range range = mObjectMap.Find(id);
-  if(!range.Empty())
-    return range.Front();
-  else
-    return nullptr;
+  Cog* object = range.Empty() ? nullptr : range.Front();
+  Unlock();
+  return object;
+}
+
+void Tracker::SetThreadSafe(bool threadSafe)
+{
+  mThreadSafe = threadSafe;
 }
 
 void Tracker::ClearDeletedObjects()
@@ -108,6 +119,13 @@ void Tracker::AddToDestroyList(Cog* gameObject)
 }
 
 void Tracker::Destroy(Cog* gameObject)
+{
+  Lock();
+  DestroyInternal(gameObject);
+  Unlock();
+}
+
+void Tracker::DestroyInternal(Cog* gameObject)
 {
   if(gameObject->mFlags.IsSet(CogFlags::Destroyed))
   {
@@ -140,14 +158,20 @@ void Tracker::Destroy(Cog* gameObject)
 
 Cog* Tracker::RawFind(u32 id)
 {
+  Lock();
+  Cog* found = nullptr;
   ObjectMapType::range range = mObjectMap.All();
   while(!range.Empty())
   {
     if(range.Front()->mObjectId.Id == id)
-      return range.Front();
+    {
+      found = range.Front();
+      break;
+    }
     range.PopFront();
   }
-  return nullptr;
+  Unlock();
+  return found;
 }
 
 void Tracker::DestroyAllObjects()
@@ -45,8 +45,15 @@ public:
 
   uint GetObjectCount(){return mObjectMap.Size();}
 
+  ///While set the object map is locked so objects can be created, found and
+  ///destroyed from multiple threads (used while isolated spaces are stepped).
+  void SetThreadSafe(bool threadSafe);
+
 private:
+  void Lock() { if(mThreadSafe) mLock.Lock(); }
+  void Unlock() { if(mThreadSafe) mLock.Unlock(); }
 
+  void DestroyInternal(Cog* gameObject);
   void AddToDestroyList(Cog* object);
 
   ///Used to incrementally generate unique id's.
@@ -62,6 +69,9 @@ private:
   ObjectMapType mObjectMap;
 
   Array<Cog*> mDestroyArray;
+
+  SpinLock mLock;
+  bool mThreadSafe;
 };
 
 namespace Z
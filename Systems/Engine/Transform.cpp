@@ -111,10 +111,11 @@ void SetRotationLookAt(Transform* transform, Vec3 lookAtPoint, Vec3 up, Facing::
 
 //-------------------------------------------------------------------- Transform
 
-Memory::Pool* Transform::sCachedWorldMatrixPool = new Memory::Pool("TransformWorldMatrixCache",
+Memory::ConcurrentPool* Transform::sCachedWorldMatrixPool = new Memory::ConcurrentPool("TransformWorldMatrixCache",
   Memory::GetRoot( ), sizeof(Mat4), 100);
 
 bool Transform::sCacheWorldMatrices = true;
+bool Transform::sUseTransformStore = false;
 
 ZilchDefineType(Transform, builder, type)
 {
@@ -165,6 +166,8 @@ Transform::Transform( )
   TransformParent = NULL;
   InWorld = false;
   mCachedWorldMatrix = nullptr;
+  mStore = nullptr;
+  mStoreIndex = 0;
 }
 
 Transform::~Transform( )
@@ -173,6 +176,7 @@ Transform::~Transform( )
   // world matrix after OnDestroy which would cause us to leak memory. Cleanup the
   // cached matrix if we have one here no matter what.
   FreeCachedMatrix();
+  RemoveFromStore();
 }
 
 void Transform::Serialize(Serializer& stream)
@@ -199,6 +203,9 @@ void Transform::Initialize(CogInitializer& initializer)
 {
   if(initializer.mParent)
     TransformParent = initializer.mParent->has(Transform);
+
+  if(sUseTransformStore && initializer.mSpace)
+    initializer.mSpace->GetTransformStore()->Add(this);
 }
 
 void Transform::AttachTo(AttachmentInfo& info)
@@ -214,6 +221,8 @@ void Transform::AttachTo(AttachmentInfo& info)
     TransformParent = parent->has(Transform);
   }
 
+  if(mStore)
+    mStore->MarkHierarchyChanged();
   SetDirty( );
 }
 
@@ -224,6 +233,9 @@ void Transform::Detached(AttachmentInfo& info)
 
   if(TransformParent!=NULL)
     TransformParent = NULL;
+
+  if(mStore)
+    mStore->MarkHierarchyChanged();
   SetDirty( );
 }
 
@@ -334,6 +346,8 @@ Mat4 Transform::GetParentRelativeMatrix()
 Mat4 Transform::GetWorldMatrix( )
 {
   // Return it if it's already cached
+  if(mStore != nullptr && !mStore->IsDirty(mStoreIndex))
+    return mStore->GetWorldMatrix(mStoreIndex);
   if(mCachedWorldMatrix != nullptr)
     return *mCachedWorldMatrix;
 
@@ -349,6 +363,14 @@ Mat4 Transform::GetWorldMatrix( )
       worldMatrix = local;
   }
 
+  // Stored transforms are normally computed in the per frame batch,
+  // but the matrix is still valid until something is changed again
+  if(mStore != nullptr)
+  {
+    mStore->SetWorldMatrix(mStoreIndex, worldMatrix);
+    return worldMatrix;
+  }
+
   // Cache it if we should
   if(sCacheWorldMatrices)
   {
@@ -738,6 +760,9 @@ void Transform::SetInWorld(bool state)
   Mat4 worldTransform = GetWorldMatrix();
   InWorld = state;
 
+  if(mStore)
+    mStore->MarkHierarchyChanged();
+
   if(state)
   {
     Vec3 translation,scale;
@@ -778,11 +803,13 @@ bool Transform::GetInWorld()
 void Transform::SetDirty()
 {
   // Don't need to do anything if we're already dirty
-  if(mCachedWorldMatrix == nullptr)
+  if(IsWorldMatrixDirty())
     return;
 
   // Free the memory
   FreeCachedMatrix();
+  if(mStore)
+    mStore->SetDirty(mStoreIndex);
 
   forRange(Cog& child, GetOwner()->GetChildren())
   {
@@ -832,6 +859,7 @@ void Transform::OnDestroy(uint flags /*= 0*/)
   }
 
   FreeCachedMatrix();
+  RemoveFromStore();
 }
 
 void Transform::SetRotationBases(Vec3Param facing, Vec3Param up, Vec3Param right)
@@ -960,4 +988,17 @@ void Transform::FreeCachedMatrix()
   }
 }
 
+bool Transform::IsWorldMatrixDirty()
+{
+  if(mStore != nullptr)
+    return mStore->IsDirty(mStoreIndex);
+  return mCachedWorldMatrix == nullptr;
+}
+
+void Transform::RemoveFromStore()
+{
+  if(mStore != nullptr)
+    mStore->Remove(this);
+}
+
 }//namespace Zero
@@ -41,7 +41,13 @@ public:
   /// the user needs for their simulation. This is especially important for memory
   /// restrictive platforms.
   static bool sCacheWorldMatrices;
-  static Memory::Pool* sCachedWorldMatrixPool;
+  static Memory::ConcurrentPool* sCachedWorldMatrixPool;
+
+  /// When enabled, transforms created afterwards keep their world matrices in their
+  /// space's TransformStore instead of the pool above. Dirty world matrices are then
+  /// recomputed in one batch per frame (after the space's update) and reading a
+  /// clean world matrix is a single array lookup.
+  static bool sUseTransformStore;
 
   /// Constructor / Destructor.
   Transform();
@@ -157,7 +163,7 @@ public:
   void SetInWorld(bool state);
   bool GetInWorld();
 
-  /// Free's the cached world matrix for this and all child objects.
+  /// Free's the cached world matrix (or marks the stored one dirty) for this and all child objects.
   void SetDirty();
 
   /// Clamps a translation value between the max values on the space.
@@ -169,13 +175,20 @@ public:
 private:
   void OnDestroy(uint flags = 0) override;
   void FreeCachedMatrix();
+  bool IsWorldMatrixDirty();
+  void RemoveFromStore();
 
   /// If null, the matrix is dirty.
   Mat4* mCachedWorldMatrix;
+  /// Used instead of the cached matrix when the transform is in a store.
+  TransformStore* mStore;
+  uint mStoreIndex;
   Vec3 Translation;
   Vec3 Scale;
   Quat Rotation;
   bool InWorld;
+
+  friend class TransformStore;
 };
 
 //------------------------------------------------------ Transform MetaTransform
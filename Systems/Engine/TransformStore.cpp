@@ -0,0 +1,240 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file TransformStore.cpp
+/// Implementation of the contiguous world matrix store for transforms.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+TransformStore::TransformStore()
+{
+  mHierarchyChanged = false;
+  mDirtyCount = 0;
+}
+
+TransformStore::~TransformStore()
+{
+  // Transforms normally remove themselves on destroy, but make
+  // sure nothing is left pointing at the store
+  forRange(Transform* transform, mTransforms.All())
+    transform->mStore = nullptr;
+}
+
+void TransformStore::Add(Transform* transform)
+{
+  ErrorIf(transform->mStore != nullptr, "Transform is already in a store.");
+
+  transform->mStore = this;
+  transform->mStoreIndex = mTransforms.Size();
+
+  mTransforms.PushBack(transform);
+  mParents.PushBack((int)cNoParent);
+  mLocal.PushBack(Mat4::cIdentity);
+  mWorld.PushBack(Mat4::cIdentity);
+  mDirty.PushBack(true);
+  ++mDirtyCount;
+
+  // Appending can put a child before its parent
+  mHierarchyChanged = true;
+}
+
+void TransformStore::Remove(Transform* transform)
+{
+  ErrorIf(transform->mStore != this, "Transform is not in this store.");
+
+  uint index = transform->mStoreIndex;
+  if(mDirty[index])
+    --mDirtyCount;
+
+  // Move the last entry into the hole, the order is fixed up on the next rebuild
+  uint last = mTransforms.Size() - 1;
+  if(index != last)
+  {
+    mTransforms[index] = mTransforms[last];
+    mWorld[index] = mWorld[last];
+    mDirty[index] = mDirty[last];
+    mTransforms[index]->mStoreIndex = index;
+  }
+
+  mTransforms.PopBack();
+  mParents.PopBack();
+  mLocal.PopBack();
+  mWorld.PopBack();
+  mDirty.PopBack();
+
+  transform->mStore = nullptr;
+  transform->mStoreIndex = 0;
+  mHierarchyChanged = true;
+}
+
+void TransformStore::MarkHierarchyChanged()
+{
+  mHierarchyChanged = true;
+}
+
+bool TransformStore::IsDirty(uint index)
+{
+  return mDirty[index] != 0;
+}
+
+void TransformStore::SetDirty(uint index)
+{
+  if(mDirty[index])
+    return;
+
+  mDirty[index] = true;
+  ++mDirtyCount;
+}
+
+Mat4Param TransformStore::GetWorldMatrix(uint index)
+{
+  ErrorIf(mDirty[index], "World matrix is dirty.");
+  return mWorld[index];
+}
+
+void TransformStore::SetWorldMatrix(uint index, Mat4Param worldMatrix)
+{
+  mWorld[index] = worldMatrix;
+  if(mDirty[index])
+  {
+    mDirty[index] = false;
+    --mDirtyCount;
+  }
+}
+
+void TransformStore::UpdateWorldMatrices()
+{
+  if(mDirtyCount == 0)
+    return;
+
+  ProfileScopeTree("TransformStore", "TimeSystem", Color::Aquamarine);
+
+  if(mHierarchyChanged)
+    Rebuild();
+
+  uint count = mTransforms.Size();
+
+  // Gather the local matrices of everything that needs to be recomputed
+  for(uint i = 0; i < count; ++i)
+  {
+    if(mDirty[i])
+      mLocal[i] = mTransforms[i]->GetLocalMatrix();
+  }
+
+  // Parents are always before their children, so a parent's world
+  // matrix is up to date by the time any of its children are reached.
+  // Mat4 is stored by rows, so loading one gives the transpose and
+  // (parent * local) is computed as (local^T * parent^T).
+  for(uint i = 0; i < count; ++i)
+  {
+    if(!mDirty[i])
+      continue;
+
+    int parent = mParents[i];
+    if(parent >= 0)
+    {
+      SimMat4 local = Simd::UnAlignedLoadMat4x4(mLocal[i].array);
+      SimMat4 parentWorld = Simd::UnAlignedLoadMat4x4(mWorld[parent].array);
+      Simd::UnAlignedStoreMat4x4(mWorld[i].array, Simd::Multiply(local, parentWorld));
+    }
+    else if(parent == cExternalParent)
+    {
+      mWorld[i] = mTransforms[i]->TransformParent->GetWorldMatrix() * mLocal[i];
+    }
+    else
+    {
+      mWorld[i] = mLocal[i];
+    }
+
+    mDirty[i] = false;
+  }
+
+  mDirtyCount = 0;
+}
+
+uint TransformStore::Size()
+{
+  return mTransforms.Size();
+}
+
+void TransformStore::Rebuild()
+{
+  uint count = mTransforms.Size();
+
+  // Bucket the entries by depth, siblings keep their relative order
+  Array<uint> depths;
+  depths.Resize(count);
+  uint maxDepth = 0;
+  for(uint i = 0; i < count; ++i)
+  {
+    depths[i] = GetDepth(mTransforms[i]);
+    maxDepth = Math::Max(maxDepth, depths[i]);
+  }
+
+  Array<uint> offsets;
+  offsets.Resize(maxDepth + 2, 0);
+  for(uint i = 0; i < count; ++i)
+    ++offsets[depths[i] + 1];
+  for(uint depth = 1; depth < offsets.Size(); ++depth)
+    offsets[depth] += offsets[depth - 1];
+
+  Array<Transform*> transforms;
+  Array<Mat4> world;
+  Array<byte> dirty;
+  transforms.Resize(count);
+  world.Resize(count);
+  dirty.Resize(count);
+
+  for(uint i = 0; i < count; ++i)
+  {
+    uint index = offsets[depths[i]]++;
+    transforms[index] = mTransforms[i];
+    world[index] = mWorld[i];
+    dirty[index] = mDirty[i];
+    transforms[index]->mStoreIndex = index;
+  }
+
+  mTransforms.Swap(transforms);
+  mWorld.Swap(world);
+  mDirty.Swap(dirty);
+
+  for(uint i = 0; i < count; ++i)
+  {
+    Transform* transform = mTransforms[i];
+    if(transform->InWorld || transform->TransformParent == nullptr)
+      mParents[i] = cNoParent;
+    else if(Transform* parent = GetStoredParent(transform))
+      mParents[i] = (int)parent->mStoreIndex;
+    else
+      mParents[i] = cExternalParent;
+  }
+
+  mHierarchyChanged = false;
+}
+
+uint TransformStore::GetDepth(Transform* transform)
+{
+  uint depth = 0;
+  while(Transform* parent = GetStoredParent(transform))
+  {
+    ++depth;
+    transform = parent;
+  }
+  return depth;
+}
+
+Transform* TransformStore::GetStoredParent(Transform* transform)
+{
+  if(transform->InWorld)
+    return nullptr;
+
+  Transform* parent = transform->TransformParent;
+  if(parent == nullptr || parent->mStore != this)
+    return nullptr;
+  return parent;
+}
+
+}//namespace Zero
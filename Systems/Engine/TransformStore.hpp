@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file TransformStore.hpp
+/// Declaration of the contiguous world matrix store for transforms.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace Zero
+{
+
+class Transform;
+
+//-------------------------------------------------------------- Transform Store
+/// Opt-in replacement for the pooled world matrix cache (see Transform::sUseTransformStore).
+/// Every transform in a space is given an index into arrays of local matrices, world
+/// matrices, parent indices and dirty flags. The arrays are sorted so that parents are
+/// always before their children, which lets all dirty world matrices be recomputed in
+/// one linear pass per frame (parentWorld * local with the simd matrix routines).
+/// A clean transform's world matrix is just a read from the world array.
+class TransformStore
+{
+public:
+  /// The transform has no parent (or is in world) so its world matrix is its local matrix.
+  static const int cNoParent = -1;
+  /// The parent is not in this store, its world matrix is requested from the parent.
+  static const int cExternalParent = -2;
+
+  TransformStore();
+  ~TransformStore();
+
+  void Add(Transform* transform);
+  void Remove(Transform* transform);
+
+  /// Must be called whenever a transform's parent or in world state changes.
+  void MarkHierarchyChanged();
+
+  bool IsDirty(uint index);
+  /// Only marks the one entry, Transform::SetDirty walks the children.
+  void SetDirty(uint index);
+  Mat4Param GetWorldMatrix(uint index);
+  /// Stores a world matrix that was computed outside of the batch update.
+  void SetWorldMatrix(uint index, Mat4Param worldMatrix);
+
+  /// Recomputes every dirty world matrix in parent before child order.
+  void UpdateWorldMatrices();
+
+  uint Size();
+
+private:
+  /// Sorts the entries by depth in the hierarchy and recomputes the parent indices.
+  void Rebuild();
+  uint GetDepth(Transform* transform);
+  Transform* GetStoredParent(Transform* transform);
+
+  Array<Transform*> mTransforms;
+  Array<int> mParents;
+  Array<Mat4> mLocal;
+  Array<Mat4> mWorld;
+  Array<byte> mDirty;
+
+  bool mHierarchyChanged;
+  uint mDirtyCount;
+};
+
+}//namespace Zero
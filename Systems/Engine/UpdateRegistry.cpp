@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file UpdateRegistry.cpp
+/// Implementation of the batched component update registry.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+UpdateRegistry::UpdateRegistry()
+{
+  mRunningPhase = -1;
+}
+
+UpdateRegistry::~UpdateRegistry()
+{
+  for(uint phase = 0; phase < UpdatePhase::Size; ++phase)
+    DeleteObjectsInContainer(mBatches[phase]);
+}
+
+void UpdateRegistry::Add(UpdatePhase::Enum phase, BatchUpdateFn function, Component* component, uint flags)
+{
+  ErrorIf(mSlots[phase].FindPointer(component) != nullptr, "Component is already registered for this update phase.");
+
+  if(mRunningPhase == (int)phase)
+  {
+    PendingAdd pending = { function, component, flags };
+    mPendingAdds.PushBack(pending);
+    return;
+  }
+
+  AddToBatch(phase, function, component, flags);
+}
+
+void UpdateRegistry::AddToBatch(UpdatePhase::Enum phase, BatchUpdateFn function, Component* component, uint flags)
+{
+  // There are only ever a handful of update functions per phase. Components that register
+  // the same function with different flags (e.g. only some are thread safe) get their own batch.
+  Array<UpdateBatch*>& batches = mBatches[phase];
+  UpdateBatch* batch = nullptr;
+  for(uint i = 0; i < batches.Size(); ++i)
+  {
+    if(batches[i]->mFunction == function && batches[i]->mFlags == flags)
+    {
+      batch = batches[i];
+      break;
+    }
+  }
+
+  if(batch == nullptr)
+  {
+    batch = new UpdateBatch();
+    batch->mFunction = function;
+    batch->mFlags = flags;
+    batches.PushBack(batch);
+  }
+
+  UpdateSlot slot = { batch, batch->mComponents.Size() };
+  batch->mComponents.PushBack(component);
+  mSlots[phase].Insert(component, slot);
+}
+
+void UpdateRegistry::Remove(UpdatePhase::Enum phase, Component* component)
+{
+  UpdateSlot* found = mSlots[phase].FindPointer(component);
+  if(found == nullptr)
+  {
+    // It may have been added while the phase was running
+    if(mRunningPhase != (int)phase)
+      return;
+
+    for(uint i = 0; i < mPendingAdds.Size(); ++i)
+    {
+      if(mPendingAdds[i].mComponent == component)
+      {
+        mPendingAdds.EraseAt(i);
+        return;
+      }
+    }
+    return;
+  }
+
+  UpdateSlot slot = *found;
+  mSlots[phase].Erase(component);
+
+  Array<Component*>& components = slot.mBatch->mComponents;
+  if(mRunningPhase == (int)phase)
+  {
+    components[slot.mIndex] = nullptr;
+    if(!mPendingCompacts.Contains(slot.mBatch))
+      mPendingCompacts.PushBack(slot.mBatch);
+    return;
+  }
+
+  // Keep the batch contiguous by moving the last component into the hole
+  Component* last = components.Back();
+  components[slot.mIndex] = last;
+  components.PopBack();
+  if(last != component)
+    mSlots[phase].FindPointer(last)->mIndex = slot.mIndex;
+}
+
+void UpdateRegistry::Compact(UpdatePhase::Enum phase, UpdateBatch* batch)
+{
+  // Order is kept so components update in a stable order
+  Array<Component*>& components = batch->mComponents;
+  uint count = 0;
+  for(uint i = 0; i < components.Size(); ++i)
+  {
+    Component* component = components[i];
+    if(component == nullptr)
+      continue;
+
+    if(count != i)
+    {
+      components[count] = component;
+      mSlots[phase].FindPointer(component)->mIndex = count;
+    }
+    ++count;
+  }
+  components.Resize(count);
+}
+
+void UpdateRegistry::Update(UpdatePhase::Enum phase, UpdateEvent* event)
+{
+  ErrorIf(mRunningPhase != -1, "Update phases cannot be run recursively.");
+  mRunningPhase = (int)phase;
+
+  Array<UpdateBatch*>& batches = mBatches[phase];
+  for(uint i = 0; i < batches.Size(); ++i)
+    RunBatch(batches[i], event);
+
+  mRunningPhase = -1;
+
+  forRange(UpdateBatch* batch, mPendingCompacts.All())
+    Compact(phase, batch);
+  mPendingCompacts.Clear();
+
+  forRange(PendingAdd& pending, mPendingAdds.All())
+    AddToBatch(phase, pending.mFunction, pending.mComponent, pending.mFlags);
+  mPendingAdds.Clear();
+}
+
+//-------------------------------------------------------------- Batch Range Job
+// Runs one range of a batch on a worker
+struct UpdateBatchRange
+{
+  UpdateBatch* mBatch;
+  UpdateEvent* mEvent;
+  uint mCount;
+
+  void operator()(uint rangeIndex)
+  {
+    uint batchSize = UpdateRegistry::cParallelBatchSize;
+    uint start = rangeIndex * batchSize;
+    uint count = Math::Min(batchSize, mCount - start);
+    mBatch->mFunction(mBatch->mComponents.Data() + start, count, mEvent);
+  }
+};
+
+void UpdateRegistry::RunBatch(UpdateBatch* batch, UpdateEvent* event)
+{
+  uint count = batch->mComponents.Size();
+  if(count == 0)
+    return;
+
+  bool threadSafe = (batch->mFlags & UpdateFlags::ThreadSafe) != 0;
+  if(!threadSafe || !ThreadingEnabled || count < cParallelBatchSize * 2)
+  {
+    batch->mFunction(batch->mComponents.Data(), count, event);
+    return;
+  }
+
+  UpdateBatchRange range = { batch, event, count };
+  uint batchSize = cParallelBatchSize;
+  uint rangeCount = (count + batchSize - 1) / batchSize;
+  Z::gJobs->ParallelFor(0, rangeCount, 1, range);
+}
+
+uint UpdateRegistry::GetCount(UpdatePhase::Enum phase)
+{
+  return mSlots[phase].Size();
+}
+
+}//namespace Zero
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file UpdateRegistry.hpp
+/// Declaration of the batched component update registry.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace Zero
+{
+
+class Component;
+class UpdateEvent;
+
+DeclareEnum2(UpdatePhase, Frame, Logic);
+
+DeclareBitField1(UpdateFlags,
+                 // The update only touches its own component (and reads shared
+                 // state), so batches of this type may run across the JobSystem
+                 ThreadSafe);
+
+/// Runs the update function of one type over count components.
+typedef void (*BatchUpdateFn)(Component** components, uint count, UpdateEvent* event);
+
+//----------------------------------------------------------------- Update Batch
+/// All the components registered with the same update function and flags.
+class UpdateBatch
+{
+public:
+  BatchUpdateFn mFunction;
+  uint mFlags;
+  /// Contiguous list of components, removed components are swapped with the back
+  /// (or nulled while the batch is running).
+  Array<Component*> mComponents;
+};
+
+/// Where a registered component is stored.
+struct UpdateSlot
+{
+  UpdateBatch* mBatch;
+  uint mIndex;
+};
+
+//-------------------------------------------------------------- Update Registry
+/// Opt-in alternative to connecting every component to FrameUpdate / LogicUpdate.
+/// Components register an update function for a phase and all components sharing
+/// the function and flags are stored in one contiguous batch that is run in a single loop,
+/// rather than walking an event connection and a virtual invoke per component.
+/// Batches run after the phase's event has been dispatched, in registration order.
+///
+///   mSpace->has(TimeSpace)->mUpdates.Add<Particle, &Particle::OnLogicUpdate>(UpdatePhase::Logic, this);
+///   ...
+///   mSpace->has(TimeSpace)->mUpdates.Remove(UpdatePhase::Logic, this);
+class UpdateRegistry
+{
+public:
+  /// Batches of thread safe updates smaller than this run on the calling thread.
+  static const uint cParallelBatchSize = 256;
+
+  UpdateRegistry();
+  ~UpdateRegistry();
+
+  /// Registers the component's member function for the phase.
+  template<typename ComponentType, void (ComponentType::*Function)(UpdateEvent*)>
+  void Add(UpdatePhase::Enum phase, ComponentType* component, uint flags = 0);
+
+  /// Registers the component with an update function for the phase.
+  void Add(UpdatePhase::Enum phase, BatchUpdateFn function, Component* component, uint flags = 0);
+  /// Removes the component from the phase (must be done before the component is destroyed).
+  void Remove(UpdatePhase::Enum phase, Component* component);
+
+  /// Runs every batch registered for the phase.
+  void Update(UpdatePhase::Enum phase, UpdateEvent* event);
+
+  /// Number of components registered for the phase.
+  uint GetCount(UpdatePhase::Enum phase);
+
+private:
+  struct PendingAdd
+  {
+    BatchUpdateFn mFunction;
+    Component* mComponent;
+    uint mFlags;
+  };
+
+  void AddToBatch(UpdatePhase::Enum phase, BatchUpdateFn function, Component* component, uint flags);
+  /// Removes the components that were nulled out while the phase was running.
+  void Compact(UpdatePhase::Enum phase, UpdateBatch* batch);
+  void RunBatch(UpdateBatch* batch, UpdateEvent* event);
+
+  Array<UpdateBatch*> mBatches[UpdatePhase::Size];
+  HashMap<Component*, UpdateSlot> mSlots[UpdatePhase::Size];
+
+  /// While a phase is running its batches can't change, components added are
+  /// held here and removed components are nulled out until the phase finishes.
+  int mRunningPhase;
+  Array<PendingAdd> mPendingAdds;
+  Array<UpdateBatch*> mPendingCompacts;
+};
+
+/// Calls the member function on every component of the batch.
+template<typename ComponentType, void (ComponentType::*Function)(UpdateEvent*)>
+void BatchUpdate(Component** components, uint count, UpdateEvent* event)
+{
+  for(uint i = 0; i < count; ++i)
+  {
+    if(Component* component = components[i])
+      (static_cast<ComponentType*>(component)->*Function)(event);
+  }
+}
+
+template<typename ComponentType, void (ComponentType::*Function)(UpdateEvent*)>
+void UpdateRegistry::Add(UpdatePhase::Enum phase, ComponentType* component, uint flags)
+{
+  Add(phase, &BatchUpdate<ComponentType, Function>, component, flags);
+}
+
+}//namespace Zero
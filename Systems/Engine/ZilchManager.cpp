@@ -63,7 +63,9 @@ BoundType* ZilchCompileEvent::GetReplacingType(BoundType* oldType)
 ZilchManager::ZilchManager() :
   mVersion(0),
   mShouldAttemptCompile(true),
-  mLastCompileResult(CompileResult::CompilationSucceeded)
+  mLastCompileResult(CompileResult::CompilationSucceeded),
+  mCountedState(nullptr),
+  mCountedHeapAllocations(0)
 {
   ConnectThisTo(Z::gEngine, Events::EngineUpdate, OnEngineUpdate);
 }
@@ -146,6 +148,20 @@ void ZilchManager::OnEngineUpdate(UpdateEvent* event)
   InternalCompile();
 
   mDebugger.Update();
+
+  // The state is replaced when scripts are recompiled (possibly at the same address)
+  ExecutableState* state = ExecutableState::CallingState;
+  if(state != mCountedState || (state != nullptr && state->HeapAllocationCount < mCountedHeapAllocations))
+  {
+    mCountedState = state;
+    mCountedHeapAllocations = 0;
+  }
+
+  if(state != nullptr)
+  {
+    ProfileCounter("Zilch.HeapAllocations", state->HeapAllocationCount - mCountedHeapAllocations);
+    mCountedHeapAllocations = state->HeapAllocationCount;
+  }
 }
 
 //**************************************************************************************************
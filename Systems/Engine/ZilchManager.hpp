@@ -83,6 +83,11 @@ public:
 
   // The debugger interface that we register states with
   Debugger mDebugger;
+
+  // Zilch doesn't use the profiler, so the heap allocations of the calling state
+  // are reported to the Zilch.HeapAllocations counter once per engine update
+  ExecutableState* mCountedState;
+  size_t mCountedHeapAllocations;
 };
 
 }//namespace Zero
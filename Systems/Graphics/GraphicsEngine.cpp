@@ -128,7 +128,7 @@ void GraphicsEngine::Initialize(SystemInitializer& initializer)
   ConnectThisTo(ZilchManager::GetInstance(), Events::ScriptsCompiledPostPatch, OnScriptsCompiledPostPatch);
   ConnectThisTo(ZilchManager::GetInstance(), Events::ScriptCompilationFailed, OnScriptCompilationFailed);
 
-  ParticleList::Memory = new Memory::Pool("Particles", Memory::GetRoot(), sizeof(Particle), 1024);
+  ParticleList::Memory = new Memory::ConcurrentPool("Particles", Memory::GetRoot(), sizeof(Particle), 1024);
   Shader::sPool = new Memory::Pool("Shaders", Memory::GetRoot(), sizeof(Shader), 1024);
 
   mFrameCounter = 0;
@@ -142,6 +142,11 @@ void GraphicsSpace::OnFrameUpdate(float frameDt)
   mVisibleGraphicals.Clear();
   uint lastIndex = 0;
 
+  // Summed over every camera
+  uint visibleCount = 0;
+  uint culledCount = 0;
+  uint cullableCount = mBroadPhase.GetTotalProxyCount();
+
   uint renderGroupCount = mGraphicsEngine->GetRenderGroupCount();
   ErrorIf(renderGroupCount == 0, "No render groups, core resources must be missing.");
 
@@ -165,12 +170,22 @@ void GraphicsSpace::OnFrameUpdate(float frameDt)
     Frustum frustum = camera.GetFrustum(camera.mViewportInterface->GetAspectRatio());
 
     // Visibility culled graphicals
+    uint inFrustumCount = 0;
     forRangeBroadphaseTree (GraphicsBroadPhase, mBroadPhase, Frustum, frustum)
+    {
       AddToVisibleGraphicals(*range.Front(), camera, cameraPos, cameraDir, &frustum);
+      ++inFrustumCount;
+    }
 
     // Not culled
     forRange (Graphical& graphical, mGraphicalsNeverCulled.All())
+    {
       AddToVisibleGraphicals(graphical, camera, cameraPos, cameraDir);
+      ++visibleCount;
+    }
+
+    visibleCount += inFrustumCount;
+    culledCount += cullableCount - inFrustumCount;
 
     // Get DebugGraphical entries, not broadphased
     // DebugGraphicals exist for one frame and are not placed in broadphase
@@ -215,6 +230,9 @@ void GraphicsSpace::OnFrameUpdate(float frameDt)
       rangeStart = rangeEnd;
     }
   }
+
+  ProfileCounter("Graphics.Visible", visibleCount);
+  ProfileCounter("Graphics.Culled", culledCount);
 }
 
 //**************************************************************************************************
@@ -269,7 +287,7 @@ void GraphicsSpace::RenderQueuesUpdate(RenderTasks& renderTasks, RenderQueues& r
     camera.GetViewData(viewBlock);
 
     uint totalViewNodesNeeded = 0;
-    Array<IndexRange> groupRanges;
+    Array<IndexRange, FrameAllocator> groupRanges;
     size_t indexRangeIndex = 0;
     IndexRange indexRange(0, 0);
     if (camera.mGraphicalIndexRanges.Size())
@@ -40,7 +40,7 @@ ZilchDefineType(Particle, builder, type)
 }
 
 //---------------------------------------------------------------- Particle List
-Memory::Pool* ParticleList::Memory = NULL;
+Memory::ConcurrentPool* ParticleList::Memory = NULL;
 
 void ParticleList::Initialize()
 {
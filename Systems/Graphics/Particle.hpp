@@ -74,7 +74,7 @@ public:
     return range(Particles);
   }
 
-  static Memory::Pool* Memory;
+  static Memory::ConcurrentPool* Memory;
   Particle* Particles;
   Particle* Destroyed;
 
@@ -103,7 +103,7 @@ void RenderGroup::OnObjectModified(ObjectEvent* event)
 }
 
 //**************************************************************************************************
-void RenderGroup::GetMaterials(HashSet<Material*>& materials)
+void RenderGroup::GetMaterials(FrameMaterialSet& materials)
 {
   Array<RenderGroup*> renderGroups;
   GetRenderGroups(renderGroups);
@@ -6,6 +6,9 @@
 namespace Zero
 {
 
+// Materials gathered while adding render tasks, only used for the frame.
+typedef HashSet<Material*, HashPolicy<Material*>, FrameAllocator> FrameMaterialSet;
+
 /// How Materials are categorized, determines which graphicals are drawn in a render pass.
 class RenderGroup : public DataResource
 {
@@ -26,7 +29,7 @@ public:
   void OnObjectModified(ObjectEvent* event);
 
   // Appends to set all associated Materials of this RenderGroup and all its sub groups.
-  void GetMaterials(HashSet<Material*>& materials);
+  void GetMaterials(FrameMaterialSet& materials);
   // Adds to array this RenderGroup and all sub groups.
   void GetRenderGroups(Array<RenderGroup*>& renderGroups);
 
@@ -552,7 +552,7 @@ void RenderTasksEvent::AddRenderTaskRenderPass(RenderSettings& renderSettings, R
   if (fragmentType != ZilchFragmentType::RenderPass)
     return DoNotifyException("Error", "Fragment is not a [RenderPass]");
 
-  HashSet<Material*> materials;
+  FrameMaterialSet materials;
   renderGroup.GetMaterials(materials);
 
   uint shaderInputsId = GetUniqueShaderInputsId();
@@ -577,7 +577,7 @@ void RenderTasksEvent::AddRenderTaskSubRenderGroupPass(SubRenderGroupPass& subRe
   // which is all the elements minus the one base task.
   uint subGroupCount = subRenderGroupPass.mSubData.Size() - 1;
 
-  HashSet<Material*> materials;
+  FrameMaterialSet materials;
   subRenderGroupPass.mBaseRenderGroup->GetMaterials(materials);
 
   for (size_t i = 0; i < subRenderGroupPass.mSubData.Size(); ++i)
@@ -615,7 +615,7 @@ void RenderTasksEvent::AddRenderTaskRenderPass(RenderSettings& renderSettings, G
   if (fragmentType != ZilchFragmentType::RenderPass)
     return DoNotifyException("Error", "Fragment is not a [RenderPass]");
 
-  HashSet<Material*> materials;
+  FrameMaterialSet materials;
 
   // Need to add an index range for this set of entries
   IndexRange indexRange;
@@ -110,7 +110,18 @@ void Sprite::Initialize(CogInitializer& initializer)
   mCurrentFrame = mStartFrame;
   mFrameTime = 0.0f;
 
-  ConnectThisTo(GetSpace(), Events::LogicUpdate, OnLogicUpdate);
+  // Sprites are updated in one batch rather than each connecting to LogicUpdate
+  if (TimeSpace* timeSpace = GetSpace()->has(TimeSpace))
+    timeSpace->mUpdates.Add<Sprite, &Sprite::OnLogicUpdate>(UpdatePhase::Logic, this);
+}
+
+//**************************************************************************************************
+void Sprite::OnDestroy(uint flags)
+{
+  if (TimeSpace* timeSpace = GetSpace()->has(TimeSpace))
+    timeSpace->mUpdates.Remove(UpdatePhase::Logic, this);
+
+  BaseSprite::OnDestroy(flags);
 }
 
 //**************************************************************************************************
@@ -7,22 +7,29 @@ namespace Zero
 {
 
 //**************************************************************************************************
-void LoadTexture(StringParam filename, Texture* texture)
+// Copies the next size bytes out of the file contents, fails if the contents are too short
+bool ReadTextureData(DataBlock& block, size_t& offset, void* data, size_t size)
+{
+  if (block.Size - offset < size)
+    return false;
+
+  memcpy(data, block.Data + offset, size);
+  offset += size;
+  return true;
+}
+
+//**************************************************************************************************
+void LoadTexture(DataBlock block, Texture* texture)
 {
   texture->mFormat = TextureFormat::None;
   texture->mMipHeaders = nullptr;
   texture->mImageData = nullptr;
   texture->mTotalDataSize = 0;
 
-  File file;
-  file.Open(filename.c_str(), FileMode::Read, FileAccessPattern::Sequential);
-
-  if (!file.IsOpen())
-    return;
-
+  size_t offset = 0;
   TextureHeader header;
-  header.mFileId = 0;
-  Read(file, header);
+  if (!ReadTextureData(block, offset, &header, sizeof(header)))
+    return;
 
   if (header.mFileId != TextureFileId)
     return;
@@ -32,12 +39,14 @@ void LoadTexture(StringParam filename, Texture* texture)
   {
     // If a texture is compressed, the data file will have an uncompressed version of the texture
     // after the compressed data, including a separate file header
-    uint dataSizeToSkip = header.mMipCount * sizeof(MipHeader) + header.mTotalDataSize;
-    file.Seek(dataSizeToSkip, SeekOrigin::Current);
+    size_t dataSizeToSkip = header.mMipCount * sizeof(MipHeader) + header.mTotalDataSize;
+    if (block.Size - offset < dataSizeToSkip)
+      return;
+    offset += dataSizeToSkip;
 
     // Read new header
-    header.mFileId = 0;
-    Read(file, header);
+    if (!ReadTextureData(block, offset, &header, sizeof(header)))
+      return;
 
     if (header.mFileId != TextureFileId)
       return;
@@ -46,11 +55,8 @@ void LoadTexture(StringParam filename, Texture* texture)
   MipHeader* mipHeaders = new MipHeader[header.mMipCount];
   byte* imageData = new byte[header.mTotalDataSize];
 
-  Status status;
-  file.Read(status, (byte*)mipHeaders, header.mMipCount * sizeof(MipHeader));
-  file.Read(status, imageData, header.mTotalDataSize);
-
-  if (status.Failed())
+  if (!ReadTextureData(block, offset, mipHeaders, header.mMipCount * sizeof(MipHeader)) ||
+      !ReadTextureData(block, offset, imageData, header.mTotalDataSize))
   {
     delete[] mipHeaders;
     delete[] imageData;
@@ -76,11 +82,29 @@ void LoadTexture(StringParam filename, Texture* texture)
   texture->mMipMapping = (TextureMipMapping::Enum)header.mMipMapping;
 }
 
+//**************************************************************************************************
+// Reads a copy of the file instead of mapping it
+void LoadTextureFromFile(StringParam filename, Texture* texture)
+{
+  DataBlock block = ReadFileIntoDataBlock(filename.c_str());
+  LoadTexture(block, texture);
+  FreeBlock(block);
+}
+
 //**************************************************************************************************
 HandleOf<Resource> TextureLoader::LoadFromFile(ResourceEntry& entry)
 {
   Texture* texture = new Texture();
-  LoadTexture(entry.FullPath, texture);
+
+  // Copy straight out of a mapping of the file. Reloads happen while the file may still be
+  // written to (reading a mapping past a truncated end is a fatal SIGBUS) so they do not map.
+  Status status;
+  MappedFile mappedFile;
+  if (mappedFile.Open(status, entry.FullPath))
+    LoadTexture(mappedFile.GetBlock(), texture);
+  else
+    LoadTextureFromFile(entry.FullPath, texture);
+
   TextureManager::GetInstance()->AddResource(entry, texture);
   return texture;
 }
@@ -89,7 +113,7 @@ HandleOf<Resource> TextureLoader::LoadFromFile(ResourceEntry& entry)
 void TextureLoader::ReloadFromFile(Resource* resource, ResourceEntry& entry)
 {
   Texture* texture = (Texture*)resource;
-  LoadTexture(entry.FullPath, texture);
+  LoadTextureFromFile(entry.FullPath, texture);
   texture->SendModified();
 }
 
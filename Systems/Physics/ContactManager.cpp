@@ -11,12 +11,12 @@ namespace Zero
 
 namespace Physics
 {
-Memory::Pool* sContactPool = nullptr;
+Memory::ConcurrentPool* sContactPool = nullptr;
 
 ContactManager::ContactManager()
 {
   if(sContactPool == nullptr)
-    sContactPool = new Memory::Pool("Contacts", Memory::GetNamedHeap("Physics"), sizeof(Contact), 1000);
+    sContactPool = new Memory::ConcurrentPool("Contacts", Memory::GetNamedHeap("Physics"), sizeof(Contact), 1000);
   mContactPool = sContactPool;
   mSpace = nullptr;
 }
@@ -39,7 +39,7 @@ private:
   typedef InList<Contact, &Contact::SolverLink> ContactList;
   ContactList mContactsToDestroy;
 
-  Memory::Pool* mContactPool;
+  Memory::ConcurrentPool* mContactPool;
 };
 
 /// Checks if a contact already exists for a given manifold. Returns nullptr
@@ -12,7 +12,7 @@ namespace Zero
 namespace Physics
 {
 
-Memory::Pool* Island::sPool = new Memory::Pool("Islands", Memory::GetNamedHeap("Physics"), sizeof(Island), 4096 );
+Memory::ConcurrentPool* Island::sPool = new Memory::ConcurrentPool("Islands", Memory::GetNamedHeap("Physics"), sizeof(Island), 4096 );
 
 void* Island::operator new(size_t size)
 {
@@ -10,7 +10,7 @@ namespace Zero
 {
 
 class PhysicsSpace;
-namespace Memory{class Pool;}
+namespace Memory{class ConcurrentPool;}
 
 namespace Physics
 {
@@ -22,7 +22,7 @@ class IConstraintSolver;
 class Island
 {
 public:
-  static Memory::Pool* sPool;
+  static Memory::ConcurrentPool* sPool;
   static void* operator new(size_t size);
   static void operator delete(void* pMem, size_t size);
 
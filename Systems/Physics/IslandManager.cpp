@@ -36,7 +36,7 @@ void AddTreeToStack(Collider* collider, ColliderStack& stack)
 
   //now that we have the root body of the tree (dynamic root), we can
   //loop through the tree and add all colliders to the stack
-  Array<RigidBody*> bodyStack;
+  InlineArray<RigidBody*, 16> bodyStack;
   bodyStack.PushBack(body);
 
   while(!bodyStack.Empty())
@@ -9,7 +9,7 @@
 namespace Zero
 {
 
-namespace Memory{class Pool;}
+namespace Memory{class ConcurrentPool;}
 
 namespace Physics
 {
@@ -22,7 +22,7 @@ struct Manifold;
 class IConstraintSolver
 {
 public:
-  static Memory::Pool* sPool;
+  static Memory::ConcurrentPool* sPool;
 
   OverloadedNew();
 
@@ -39,8 +39,8 @@ Manifold::Manifold()
   Restitution = real(0.0);
 }
 
-Memory::Pool* Manifold::sManifoldPool = new Memory::Pool("Manifolds", Memory::GetNamedHeap("Physics"),
-                                                         sizeof(Manifold), 2000);
+Memory::ConcurrentPool* Manifold::sManifoldPool = new Memory::ConcurrentPool("Manifolds", Memory::GetNamedHeap("Physics"),
+                                                                             sizeof(Manifold), 2000);
 
 void* Manifold::operator new(size_t size)
 {
@@ -42,7 +42,7 @@ struct Manifold
 {
   Manifold();
 
-  static Memory::Pool* sManifoldPool;
+  static Memory::ConcurrentPool* sManifoldPool;
   OverloadedNew();
   
   ManifoldPoint GetPoint(uint index);
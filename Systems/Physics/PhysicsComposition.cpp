@@ -84,8 +84,7 @@ void ValidateTree(PhysicsNode* testNode)
 
   //do a depth first traversal of the physics nodes and call the
   //passed in functor on all of them
-  Array<PhysicsNode*> stack;
-  stack.Reserve(64);
+  InlineArray<PhysicsNode*, 64> stack;
   stack.PushBack(root);
 
   while(!stack.Empty())
@@ -155,8 +154,7 @@ void RelinkNodes(Cog* owner, Cog* parentOwner, PhysicsNode* node, PhysicsNode* p
 //until we find a cog with physics where we can extract the node.
 void LinkNewParentNode(PhysicsNode* node, Cog* owner)
 {
-  Array<Cog*> stack;
-  stack.Reserve(64);
+  InlineArray<Cog*, 64> stack;
   stack.PushBack(owner);
 
   while(!stack.Empty())
@@ -327,8 +325,7 @@ void FullRecurseDown(PhysicsNode* root, Functor& functor)
 {
   //do a depth first traversal of the physics nodes and call the
   //passed in functor on all of them
-  Array<PhysicsNode*> stack;
-  stack.Reserve(64);
+  InlineArray<PhysicsNode*, 64> stack;
   stack.PushBack(root);
 
   while(!stack.Empty())
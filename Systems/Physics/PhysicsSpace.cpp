@@ -796,6 +796,8 @@ void PhysicsSpace::BroadPhase()
   // Sort the pairs for determinism!
   if(GetDeterministic())
     Sort(mPossiblePairs.All(), &ClientPairSorter);
+
+  ProfileCounter("Physics.BroadPhasePairs", mPossiblePairs.Size());
 }
 
 void PhysicsSpace::NarrowPhase()
@@ -809,6 +811,7 @@ void PhysicsSpace::NarrowPhase()
   Array<NodePointerPair> Collisions;
   Collisions.SetAllocator(allocator);
 
+  uint contactCount = 0;
   uint size = mPossiblePairs.Size();
   for(unsigned pairIndex = 0; pairIndex < size; ++pairIndex)
   {
@@ -837,6 +840,7 @@ void PhysicsSpace::NarrowPhase()
     for(uint i = 0; i < tempManifolds.Size(); ++i)
     {
       Physics::Manifold& manifold = tempManifolds[i];
+      contactCount += manifold.ContactCount;
       mContactManager->AddManifold(tempManifolds[i]);
       manifold.Clear();
     }
@@ -848,6 +852,9 @@ void PhysicsSpace::NarrowPhase()
 
   // We have all connections for the frame so build the islands.
   mIslandManager->BuildIslands(mDynamicColliders);
+
+  ProfileCounter("Physics.Contacts", contactCount);
+  ProfileCounter("Physics.Islands", mIslandManager->mIslandCount);
 }
 
 void PhysicsSpace::PreSolve(real dt)
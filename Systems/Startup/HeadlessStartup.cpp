@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file HeadlessStartup.cpp
+/// Startup of the engine without a window, graphics or sound.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+//--------------------------------------------------------------------------------- Headless Startup
+//**************************************************************************************************
+void HeadlessStartup::InitializeLibraries(ZeroStartupSettings& settings)
+{
+  InitializeCoreLibraries();
+
+  PlatformLibrary::Initialize();
+  GeometryLibrary::Initialize();
+  MetaDatabase::GetInstance()->AddNativeLibrary(GeometryLibrary::GetLibrary());
+  MetaLibrary::Initialize();
+  SerializationLibrary::Initialize();
+  ContentMetaLibrary::Initialize();
+  SpatialPartitionLibrary::Initialize();
+
+  EngineLibrary::Initialize(settings);
+  PhysicsLibrary::Initialize();
+  NetworkingLibrary::Initialize();
+
+  ZilchScriptLibrary::Initialize();
+
+  NativeBindingList::ValidateTypes();
+
+  // Documentation is only used by the editor so it is not loaded
+}
+
+//**************************************************************************************************
+void HeadlessStartup::Shutdown()
+{
+  Zero::TimerBlock block("Shutting down Libraries.");
+
+  Core::GetInstance().GetLibrary()->ClearComponents();
+
+  // Shutdown in reverse order
+  ZilchScriptLibrary::Shutdown();
+
+  NetworkingLibrary::Shutdown();
+  PhysicsLibrary::Shutdown();
+  EngineLibrary::Shutdown();
+
+  SpatialPartitionLibrary::Shutdown();
+  ContentMetaLibrary::Shutdown();
+  SerializationLibrary::Shutdown();
+  MetaLibrary::Shutdown();
+  GeometryLibrary::Shutdown();
+  PlatformLibrary::Shutdown();
+
+  // ClearLibrary
+  ZilchScriptLibrary::GetInstance().ClearLibrary();
+
+  NetworkingLibrary::GetInstance().ClearLibrary();
+  PhysicsLibrary::GetInstance().ClearLibrary();
+  EngineLibrary::GetInstance().ClearLibrary();
+
+  SpatialPartitionLibrary::GetInstance().ClearLibrary();
+  ContentMetaLibrary::GetInstance().ClearLibrary();
+  SerializationLibrary::GetInstance().ClearLibrary();
+  MetaLibrary::GetInstance().ClearLibrary();
+  GeometryLibrary::GetInstance().ClearLibrary();
+
+  // Destroy
+  ZilchScriptLibrary::Destroy();
+
+  NetworkingLibrary::Destroy();
+  PhysicsLibrary::Destroy();
+  EngineLibrary::Destroy();
+
+  SpatialPartitionLibrary::Destroy();
+  ContentMetaLibrary::Destroy();
+  SerializationLibrary::Destroy();
+  MetaLibrary::Destroy();
+  GeometryLibrary::Destroy();
+
+  ShutdownCoreLibraries();
+}
+
+}//namespace Zero
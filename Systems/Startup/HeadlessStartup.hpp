@@ -0,0 +1,25 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file HeadlessStartup.hpp
+/// Startup of the engine without a window, graphics or sound.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace Zero
+{
+
+//--------------------------------------------------------------------------------- Headless Startup
+// Initializes only the libraries needed to simulate a game without a window, graphics or
+// sound (used by the dedicated server). Scripts and content that reference types from the
+// skipped libraries (Graphics, Sound, Widget, Editor, Gameplay...) will not be available.
+class HeadlessStartup : public ZeroStartup
+{
+public:
+  void Shutdown();
+
+protected:
+  void InitializeLibraries(ZeroStartupSettings& settings) override;
+};
+
+}//namespace Zero
@@ -20,38 +20,7 @@ Engine* ZeroStartup::Initialize(ZeroStartupSettings& settings)
 //**************************************************************************************************
 void ZeroStartup::InitializeLibraries(ZeroStartupSettings& settings)
 {
-  CommonLibrary::Initialize();
-
-  // Temporary location for registering handle managers
-  //ZilchRegisterSharedHandleManager(ReferenceCountedHandleManager);
-  ZilchRegisterSharedHandleManager(CogHandleManager);
-  ZilchRegisterSharedHandleManager(ComponentHandleManager);
-  ZilchRegisterSharedHandleManager(ResourceHandleManager);
-  ZilchRegisterSharedHandleManager(WidgetHandleManager);
-  ZilchRegisterSharedHandleManager(ContentItemHandleManager);
-
-  RegisterCommonHandleManagers();
-
-  ZeroRegisterHandleManager(ContentComposition);
-
-  // Graphics specific
-  ZeroRegisterThreadSafeReferenceCountedHandleManager(ThreadSafeReferenceCounted);
-  ZeroRegisterThreadSafeReferenceCountedHandleManager(BlendSettings);
-  ZeroRegisterThreadSafeReferenceCountedHandleManager(DepthSettings);
-
-  // Setup the core Zilch library
-  mZilchSetup = new ZilchSetup(SetupFlags::DoNotShutdownMemory);
-
-  // We need the calling state to be set so we can create Handles for Meta Components
-  Zilch::Module module;
-  mState = module.Link();
-  mState->SetTimeout(5);
-  ExecutableState::CallingState = mState;
-
-  MetaDatabase::Initialize();
-
-  // Add the core library to the meta database
-  MetaDatabase::GetInstance()->AddNativeLibrary(Core::GetInstance().GetLibrary());
+  InitializeCoreLibraries();
 
   // Initialize Zero Libraries
   PlatformLibrary::Initialize();
@@ -160,6 +129,49 @@ void ZeroStartup::Shutdown()
   MetaLibrary::Destroy();
   GeometryLibrary::Destroy();
 
+  ShutdownCoreLibraries();
+}
+
+//**************************************************************************************************
+void ZeroStartup::InitializeCoreLibraries()
+{
+  CommonLibrary::Initialize();
+
+  // Temporary location for registering handle managers
+  //ZilchRegisterSharedHandleManager(ReferenceCountedHandleManager);
+  ZilchRegisterSharedHandleManager(CogHandleManager);
+  ZilchRegisterSharedHandleManager(ComponentHandleManager);
+  ZilchRegisterSharedHandleManager(ResourceHandleManager);
+  ZilchRegisterSharedHandleManager(WidgetHandleManager);
+  ZilchRegisterSharedHandleManager(ContentItemHandleManager);
+
+  RegisterCommonHandleManagers();
+
+  ZeroRegisterHandleManager(ContentComposition);
+
+  // Graphics specific
+  ZeroRegisterThreadSafeReferenceCountedHandleManager(ThreadSafeReferenceCounted);
+  ZeroRegisterThreadSafeReferenceCountedHandleManager(BlendSettings);
+  ZeroRegisterThreadSafeReferenceCountedHandleManager(DepthSettings);
+
+  // Setup the core Zilch library
+  mZilchSetup = new ZilchSetup(SetupFlags::DoNotShutdownMemory);
+
+  // We need the calling state to be set so we can create Handles for Meta Components
+  Zilch::Module module;
+  mState = module.Link();
+  mState->SetTimeout(5);
+  ExecutableState::CallingState = mState;
+
+  MetaDatabase::Initialize();
+
+  // Add the core library to the meta database
+  MetaDatabase::GetInstance()->AddNativeLibrary(Core::GetInstance().GetLibrary());
+}
+
+//**************************************************************************************************
+void ZeroStartup::ShutdownCoreLibraries()
+{
   ZilchManager::Destroy();
   MetaDatabase::Destroy();
   
@@ -20,6 +20,12 @@ public:
 protected:
   virtual void InitializeLibraries(ZeroStartupSettings& settings);
   Engine* InitializeEngine();
+
+  // Common library, handle managers, Zilch and the meta database. Every
+  // startup needs these before any other library can be initialized.
+  void InitializeCoreLibraries();
+  void ShutdownCoreLibraries();
+
   ExecutableState* mState;
   ZilchSetup* mZilchSetup;
 };
@@ -19,4 +19,5 @@
 #include "WindowsShell/WindowsShellSystemStandard.hpp"
 #include "ZilchScript/ZilchScriptStandard.hpp"
 
-#include "Startup.hpp"
\ No newline at end of file
+#include "Startup.hpp"
+#include "HeadlessStartup.hpp"
\ No newline at end of file
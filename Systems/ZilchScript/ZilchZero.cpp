@@ -124,6 +124,13 @@ void ZilchComponent::ScriptInitialize(CogInitializer& initializer)
 {
   BoundType* thisType = ZilchVirtualTypeId(this);
 
+  // Scripts can't be run on multiple threads, keep the space on the main thread
+  if (initializer.mSpace)
+  {
+    if (TimeSpace* timeSpace = initializer.mSpace->has(TimeSpace))
+      timeSpace->mRunsScripts = true;
+  }
+
   // Set the value for all dependencies
   PopulateDependencies(this, this->GetOwner());
 
@@ -0,0 +1,306 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///  \file AllocatorTest.cpp
+///  Unit tests and timings for the small object allocator, frame arena and
+///  concurrent pool.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "ContainerTestStandard.hpp"
+#include "CppUnitLite2/CppUnitLite2.h"
+
+#include "Memory/SmallObjectAllocator.hpp"
+#include "Memory/FrameArena.hpp"
+#include "Memory/ConcurrentPool.hpp"
+#include "Containers/HashMap.hpp"
+#include "Containers/HashSet.hpp"
+#include "Platform/Thread.hpp"
+
+#include "WindowsDebugTimer.hpp"
+
+using namespace Zero::Memory;
+
+static const size_t AllocationCount = 4096;
+static const size_t AllocatorIterations = 2000000;
+static const size_t AllocatorThreadCount = 4;
+
+TEST(SmallObjectClasses)
+{
+  for(size_t size = 1; size <= cMaxSmallObjectSize; ++size)
+  {
+    uint sizeClass = GetSmallObjectClass(size);
+    CHECK(sizeClass < cSmallObjectClassCount);
+    CHECK(GetSmallObjectClassSize(sizeClass) >= size);
+    if(sizeClass > 0)
+      CHECK(GetSmallObjectClassSize(sizeClass - 1) < size);
+  }
+}
+
+TEST(SmallObjectAllocate)
+{
+  Zero::Array<byte*> allocations;
+  for(size_t i = 0; i < AllocationCount; ++i)
+  {
+    // Include sizes past cMaxSmallObjectSize that go to the system heap
+    size_t size = (i * 37) % (cMaxSmallObjectSize * 2) + 1;
+    byte* memory = (byte*)Zero::zAllocate(size);
+    CHECK(memory != nullptr);
+    CHECK(size_t(memory) % 16 == 0);
+    memset(memory, int(i & 0xFF), size);
+    allocations.PushBack(memory);
+  }
+
+  for(size_t i = 0; i < AllocationCount; ++i)
+  {
+    size_t size = (i * 37) % (cMaxSmallObjectSize * 2) + 1;
+    CHECK(allocations[i][0] == byte(i & 0xFF));
+    CHECK(allocations[i][size - 1] == byte(i & 0xFF));
+    Zero::zDeallocate(allocations[i]);
+  }
+}
+
+unsigned long FreeOnOtherThread(void* data)
+{
+  Zero::Array<byte*>& allocations = *(Zero::Array<byte*>*)data;
+  for(size_t i = 0; i < allocations.Size(); ++i)
+    Zero::zDeallocate(allocations[i]);
+  return 0;
+}
+
+TEST(SmallObjectCrossThreadFree)
+{
+  Zero::Array<byte*> allocations;
+  for(size_t i = 0; i < AllocationCount; ++i)
+    allocations.PushBack((byte*)Zero::zAllocate(i % 256 + 1));
+
+  Zero::Thread thread;
+  thread.Initialize(FreeOnOtherThread, &allocations, "FreeOnOtherThread");
+  thread.Resume();
+  thread.WaitForCompletion();
+
+  // Memory freed by the other thread is given back and can be used again
+  for(size_t i = 0; i < AllocationCount; ++i)
+    allocations[i] = (byte*)Zero::zAllocate(i % 256 + 1);
+  for(size_t i = 0; i < AllocationCount; ++i)
+    Zero::zDeallocate(allocations[i]);
+}
+
+TEST(FrameArenaReuse)
+{
+  // Memory is kept for the next frame and reused the frame after
+  AdvanceFrameArenas();
+  MemPtr first = FrameAllocate(64);
+  memset(first, 0xAB, 64);
+
+  AdvanceFrameArenas();
+  MemPtr second = FrameAllocate(64);
+  CHECK(second != first);
+  CHECK(((byte*)first)[63] == 0xAB);
+
+  AdvanceFrameArenas();
+  MemPtr third = FrameAllocate(64);
+  CHECK(third == first);
+}
+
+TEST(FrameArenaContainers)
+{
+  AdvanceFrameArenas();
+
+  Zero::Array<size_t, Zero::FrameAllocator> values;
+  Zero::HashMap<size_t, size_t, Zero::HashPolicy<size_t>, Zero::FrameAllocator> squares;
+  for(size_t i = 0; i < AllocationCount; ++i)
+  {
+    values.PushBack(i);
+    squares.Insert(i, i * i);
+  }
+
+  for(size_t i = 0; i < AllocationCount; ++i)
+  {
+    CHECK(values[i] == i);
+    CHECK(squares.FindValue(i, 0) == i * i);
+  }
+}
+
+TEST(ConcurrentPoolAllocate)
+{
+  ConcurrentPool pool("TestPool", GetRoot(), 48, 100);
+
+  Zero::HashSet<byte*> allocations;
+  for(size_t i = 0; i < AllocationCount; ++i)
+  {
+    byte* memory = (byte*)pool.Allocate(48);
+    CHECK(allocations.Contains(memory) == false);
+    allocations.Insert(memory);
+  }
+
+  for(Zero::HashSet<byte*>::range r = allocations.All(); !r.Empty(); r.PopFront())
+    pool.Deallocate(r.Front(), 48);
+}
+
+struct ConcurrentPoolThreadData
+{
+  ConcurrentPool* Pool;
+  Zero::Array<byte*>* Allocations;
+};
+
+unsigned long FreeToPoolOnOtherThread(void* data)
+{
+  ConcurrentPoolThreadData& threadData = *(ConcurrentPoolThreadData*)data;
+  for(size_t i = 0; i < threadData.Allocations->Size(); ++i)
+    threadData.Pool->Deallocate((*threadData.Allocations)[i], 48);
+  return 0;
+}
+
+TEST(ConcurrentPoolCrossThreadFree)
+{
+  ConcurrentPool pool("TestPool", GetRoot(), 48, 100);
+
+  Zero::Array<byte*> allocations;
+  for(size_t i = 0; i < AllocationCount; ++i)
+    allocations.PushBack((byte*)pool.Allocate(48));
+
+  ConcurrentPoolThreadData threadData = {&pool, &allocations};
+  Zero::Thread thread;
+  thread.Initialize(FreeToPoolOnOtherThread, &threadData, "FreeToPoolOnOtherThread");
+  thread.Resume();
+  thread.WaitForCompletion();
+
+  // The other thread's magazines were given back when it exited
+  for(size_t i = 0; i < AllocationCount; ++i)
+    allocations[i] = (byte*)pool.Allocate(48);
+  for(size_t i = 0; i < AllocationCount; ++i)
+    pool.Deallocate(allocations[i], 48);
+}
+
+TEST(ConcurrentPoolReuseIndex)
+{
+  // More pools than there are thread cache slots, each one is destroyed while
+  // this thread still caches magazines for it and the next one reuses its slot
+  for(size_t i = 0; i < 200; ++i)
+  {
+    ConcurrentPool pool("TestPool", GetRoot(), 48, 100);
+
+    Zero::HashSet<byte*> allocations;
+    for(size_t j = 0; j < 40; ++j)
+    {
+      byte* memory = (byte*)pool.Allocate(48);
+      CHECK(allocations.Contains(memory) == false);
+      allocations.Insert(memory);
+    }
+
+    for(Zero::HashSet<byte*>::range r = allocations.All(); !r.Empty(); r.PopFront())
+      pool.Deallocate(r.Front(), 48);
+  }
+}
+
+//------------------------------------------------------------------- Timings
+// Randomly replaces live allocations (16 to 256 bytes) the way the engine churns
+// through small objects. Run with zAllocate and with malloc for comparison.
+template<bool UseSystemHeap>
+unsigned long AllocationChurn(void* data)
+{
+  const size_t cLiveCount = 256;
+  void* live[cLiveCount] = {};
+  uint random = uint(size_t(data)) * 7919 + 1;
+
+  for(size_t i = 0; i < AllocatorIterations; ++i)
+  {
+    random = random * 1103515245 + 12345;
+    size_t slot = (random >> 8) % cLiveCount;
+    size_t size = 16 + (random >> 16) % 240;
+
+    if(UseSystemHeap)
+    {
+      free(live[slot]);
+      live[slot] = malloc(size);
+    }
+    else
+    {
+      Zero::zDeallocate(live[slot]);
+      live[slot] = Zero::zAllocate(size);
+    }
+  }
+
+  for(size_t i = 0; i < cLiveCount; ++i)
+  {
+    if(UseSystemHeap)
+      free(live[i]);
+    else
+      Zero::zDeallocate(live[i]);
+  }
+  return 0;
+}
+
+template<bool UseSystemHeap>
+void RunAllocationChurnThreads()
+{
+  Zero::Thread threads[AllocatorThreadCount];
+  for(size_t i = 0; i < AllocatorThreadCount; ++i)
+  {
+    threads[i].Initialize(AllocationChurn<UseSystemHeap>, (void*)i, "AllocationChurn");
+    threads[i].Resume();
+  }
+
+  for(size_t i = 0; i < AllocatorThreadCount; ++i)
+    threads[i].WaitForCompletion();
+}
+
+TEST(SmallObjectTimingSingleThread)
+{
+  {
+    WindowsDebugTimer timer("malloc single thread");
+    AllocationChurn<true>(nullptr);
+  }
+  {
+    WindowsDebugTimer timer("zAllocate single thread");
+    AllocationChurn<false>(nullptr);
+  }
+}
+
+TEST(SmallObjectTimingMultiThread)
+{
+  {
+    WindowsDebugTimer timer("malloc multiple threads");
+    RunAllocationChurnThreads<true>();
+  }
+  {
+    WindowsDebugTimer timer("zAllocate multiple threads");
+    RunAllocationChurnThreads<false>();
+  }
+}
+
+// Each thread replaces random live blocks in a shared pool
+unsigned long ConcurrentPoolChurn(void* data)
+{
+  ConcurrentPool* pool = (ConcurrentPool*)data;
+  const size_t cLiveCount = 256;
+  void* live[cLiveCount] = {};
+  uint random = uint(size_t(&live)) | 1;
+
+  for(size_t i = 0; i < AllocatorIterations; ++i)
+  {
+    random = random * 1103515245 + 12345;
+    size_t slot = (random >> 8) % cLiveCount;
+    pool->Deallocate(live[slot], 64);
+    live[slot] = pool->Allocate(64);
+  }
+
+  for(size_t i = 0; i < cLiveCount; ++i)
+    pool->Deallocate(live[i], 64);
+  return 0;
+}
+
+TEST(ConcurrentPoolTimingMultiThread)
+{
+  ConcurrentPool pool("TestPool", GetRoot(), 64, 1024);
+
+  WindowsDebugTimer timer("ConcurrentPool multiple threads");
+  Zero::Thread threads[AllocatorThreadCount];
+  for(size_t i = 0; i < AllocatorThreadCount; ++i)
+  {
+    threads[i].Initialize(ConcurrentPoolChurn, &pool, "ConcurrentPoolChurn");
+    threads[i].Resume();
+  }
+
+  for(size_t i = 0; i < AllocatorThreadCount; ++i)
+    threads[i].WaitForCompletion();
+}
@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///  \file HashMapTest.cpp
+///  Unit tests and timings for the hash map and hash set.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "ContainerTestStandard.hpp"
+#include "CppUnitLite2/CppUnitLite2.h"
+
+#include "Containers/HashMap.hpp"
+#include "Containers/HashSet.hpp"
+#include "ChainedHashMap.hpp"
+
+#include "WindowsDebugTimer.hpp"
+
+static const uint HashKeyCount = 100000;
+static const uint HashOperationCount = 1000000;
+
+// Alternates between small sequential keys and keys that only
+// differ in their high bits (like pointers)
+uint HashTestKey(uint i)
+{
+  return (i & 1) ? (i << 12) | 1 : i;
+}
+
+TEST(HashMapInsertFind)
+{
+  Zero::HashMap<uint, uint> map;
+  for(uint i = 0; i < HashKeyCount; ++i)
+    CHECK(map.Insert(HashTestKey(i), i).mIsNewInsert);
+
+  CHECK_EQUAL(HashKeyCount, map.Size());
+  CHECK(map.LoadFactor() <= map.MaxLoadFactor());
+
+  for(uint i = 0; i < HashKeyCount; ++i)
+  {
+    uint* value = map.FindPointer(HashTestKey(i));
+    CHECK(value != nullptr && *value == i);
+  }
+  CHECK(map.FindPointer(3) == nullptr);
+
+  // Inserting an existing key overrides the value
+  CHECK(!map.Insert(HashTestKey(10), 7).mIsNewInsert);
+  CHECK_EQUAL(7, map[HashTestKey(10)]);
+  CHECK_EQUAL(HashKeyCount, map.Size());
+
+  // Find returns a range of the single value
+  Zero::HashMap<uint, uint>::range found = map.Find(HashTestKey(10));
+  CHECK(!found.Empty());
+  CHECK_EQUAL(HashTestKey(10), found.Front().first);
+  found.PopFront();
+  CHECK(found.Empty());
+  CHECK(map.Find(3).Empty());
+}
+
+TEST(HashMapErase)
+{
+  Zero::HashMap<uint, uint> map;
+  for(uint i = 0; i < HashKeyCount; ++i)
+    map.Insert(HashTestKey(i), i);
+
+  for(uint i = 0; i < HashKeyCount; i += 2)
+    CHECK(map.Erase(HashTestKey(i)));
+  CHECK(!map.Erase(HashTestKey(0)));
+  CHECK_EQUAL(HashKeyCount / 2, map.Size());
+
+  for(uint i = 0; i < HashKeyCount; ++i)
+    CHECK_EQUAL(i % 2 == 1, map.ContainsKey(HashTestKey(i)));
+
+  // Erased slots are reused
+  size_t bucketCount = map.BucketCount();
+  for(uint i = 0; i < HashKeyCount; i += 2)
+    map.Insert(HashTestKey(i), i);
+  CHECK_EQUAL(HashKeyCount, map.Size());
+  CHECK_EQUAL(bucketCount, map.BucketCount());
+}
+
+TEST(HashMapChurn)
+{
+  // Repeatedly erasing and inserting must not grow the table
+  Zero::HashMap<uint, uint> map;
+  for(uint i = 0; i < 1000; ++i)
+    map.Insert(i, i);
+  size_t bucketCount = map.BucketCount();
+
+  for(uint i = 1000; i < HashOperationCount; ++i)
+  {
+    CHECK(map.Erase(i - 1000));
+    map.Insert(i, i);
+  }
+
+  CHECK_EQUAL(1000, map.Size());
+  CHECK_EQUAL(bucketCount, map.BucketCount());
+}
+
+TEST(HashMapRange)
+{
+  Zero::HashMap<uint, uint> map;
+  for(uint i = 0; i < 1000; ++i)
+    map.Insert(i, i * 2);
+
+  // Every value is visited once and erasing during iteration is safe
+  Zero::HashSet<uint> visited;
+  Zero::HashMap<uint, uint>::range range = map.All();
+  CHECK_EQUAL(1000, range.Length());
+  for(; !range.Empty(); range.PopFront())
+  {
+    CHECK_EQUAL(range.Front().first * 2, range.Front().second);
+    CHECK(visited.InsertNoOverwrite(range.Front().first));
+    if(range.Front().first % 3 == 0)
+      map.Erase(range.Front().first);
+  }
+  CHECK_EQUAL(1000, visited.Size());
+  CHECK_EQUAL(666, map.Size());
+
+  Zero::HashMap<uint, uint> copy(map);
+  CHECK(copy == map);
+
+  map.Clear();
+  CHECK(map.Empty());
+  CHECK(map.All().Empty());
+}
+
+TEST(HashSetInsertErase)
+{
+  Zero::HashSet<uint> set;
+  for(uint i = 0; i < HashKeyCount; ++i)
+    set.Insert(HashTestKey(i));
+  CHECK_EQUAL(HashKeyCount, set.Size());
+  CHECK(!set.InsertNoOverwrite(HashTestKey(5)));
+
+  for(uint i = 0; i < HashKeyCount; i += 3)
+    CHECK(set.Erase(HashTestKey(i)));
+
+  for(uint i = 0; i < HashKeyCount; ++i)
+    CHECK_EQUAL(i % 3 != 0, set.Contains(HashTestKey(i)));
+}
+
+//------------------------------------------------------------------- Timings
+// Each timing is run on HashMap and on the chained table it replaced.
+template<typename MapType>
+void HashMapInsertTiming(MapType& map)
+{
+  for(uint i = 0; i < HashKeyCount; ++i)
+    map.Insert(HashTestKey(i), i);
+}
+
+template<typename MapType>
+uint HashMapFindTiming(MapType& map)
+{
+  // Half the searches miss
+  uint found = 0;
+  uint random = 1;
+  for(uint i = 0; i < HashOperationCount; ++i)
+  {
+    random = random * 1103515245 + 12345;
+    if(map.FindPointer(HashTestKey((random >> 8) % (HashKeyCount * 2))) != nullptr)
+      ++found;
+  }
+  return found;
+}
+
+template<typename MapType>
+void HashMapEraseTiming(MapType& map)
+{
+  // Erase and insert back so the map stays the same size
+  uint random = 1;
+  for(uint i = 0; i < HashOperationCount; ++i)
+  {
+    random = random * 1103515245 + 12345;
+    uint key = HashTestKey((random >> 8) % HashKeyCount);
+    if(map.Erase(key))
+      map.Insert(key, i);
+  }
+}
+
+template<typename MapType>
+void RunHashMapTimings(cstr name)
+{
+  MapType map;
+  {
+    WindowsDebugTimer timer(String::Format("%s insert", name));
+    HashMapInsertTiming(map);
+  }
+  {
+    WindowsDebugTimer timer(String::Format("%s find", name));
+    CHECK(HashMapFindTiming(map) != 0);
+  }
+  {
+    WindowsDebugTimer timer(String::Format("%s erase", name));
+    HashMapEraseTiming(map);
+  }
+}
+
+TEST(HashMapTimings)
+{
+  RunHashMapTimings< Zero::ChainedHashMap<uint, uint> >("Chained HashMap");
+  RunHashMapTimings< Zero::HashMap<uint, uint> >("HashMap");
+}
@@ -0,0 +1,132 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///  \file InlineArrayTest.cpp
+///  Unit tests for the inline array.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "ContainerTestStandard.hpp"
+#include "CppUnitLite2/CppUnitLite2.h"
+
+#include "Containers/InlineArray.hpp"
+#include "String/String.hpp"
+
+typedef Zero::InlineArray<int, 4> InlineIntArray;
+typedef Zero::InlineArray<Zero::String, 2> InlineStringArray;
+
+TEST(InlineArray_Inline)
+{
+  InlineIntArray actual;
+  CHECK(actual.IsInline());
+  CHECK_EQUAL(4, actual.capacity());
+
+  for(int i = 0; i < 4; ++i)
+    actual.PushBack(i);
+  CHECK(actual.IsInline());
+
+  // Past the inline count the elements move to the heap
+  actual.PushBack(4);
+  CHECK(!actual.IsInline());
+  CHECK_EQUAL(5, actual.Size());
+  for(int i = 0; i < 5; ++i)
+    CHECK_EQUAL(i, actual[i]);
+
+  // Deallocate goes back to the inline storage
+  actual.Deallocate();
+  CHECK(actual.IsInline());
+  CHECK(actual.Empty());
+}
+
+TEST(InlineArray_InsertErase)
+{
+  InlineIntArray actual;
+  actual.PushBack(1);
+  actual.PushBack(3);
+  actual.InsertAt(0, 0);
+  actual.InsertAt(2, 2);
+  actual.InsertAt(4, 4);
+  actual.InsertAt(5, 5);
+
+  int expected[] = {0, 1, 2, 3, 4, 5};
+  CHECK_EQUAL(6, actual.Size());
+  CHECK_ARRAY_EQUAL(expected, actual, 6);
+
+  actual.EraseAt(0);
+  CHECK(actual.EraseValue(3));
+  CHECK(!actual.EraseValue(3));
+  actual.PopBack();
+
+  int erased[] = {1, 2, 4};
+  CHECK_EQUAL(3, actual.Size());
+  CHECK_ARRAY_EQUAL(erased, actual, 3);
+}
+
+TEST(InlineArray_PushBackSelf)
+{
+  // Pushing an element of the array while it grows out of the inline storage
+  InlineIntArray actual;
+  for(int i = 0; i < 4; ++i)
+    actual.PushBack(i);
+  actual.PushBack(actual[2]);
+  CHECK_EQUAL(2, actual.Back());
+}
+
+TEST(InlineArray_CopySwap)
+{
+  InlineStringArray small;
+  small.PushBack("a");
+
+  InlineStringArray large;
+  large.PushBack("b");
+  large.PushBack("c");
+  large.PushBack("d");
+
+  InlineStringArray copy(large);
+  CHECK(copy == large);
+
+  // Swapping inline and heap arrays moves the inline elements
+  small.Swap(large);
+  CHECK_EQUAL(3, small.Size());
+  CHECK(!small.IsInline());
+  CHECK(small == copy);
+  CHECK_EQUAL(1, large.Size());
+  CHECK(large.IsInline());
+  CHECK(large[0] == "a");
+
+  large = small;
+  CHECK(large == copy);
+}
+
+TEST(InlineArray_Resize)
+{
+  InlineIntArray actual;
+  actual.Resize(10, 7);
+  CHECK_EQUAL(10, actual.Size());
+  CHECK_EQUAL(7, actual[9]);
+
+  actual.Resize(2);
+  CHECK_EQUAL(2, actual.Size());
+
+  int count = 0;
+  for(InlineIntArray::range range = actual.All(); !range.Empty(); range.PopFront())
+  {
+    CHECK_EQUAL(7, range.Front());
+    ++count;
+  }
+  CHECK_EQUAL(2, count);
+}
+
+struct alignas(32) OverAlignedValue
+{
+  float Values[8];
+};
+
+TEST(InlineArray_Alignment)
+{
+  // Inline elements must be aligned for their type even when it's wider than a pointer
+  Zero::InlineArray<OverAlignedValue, 3> actual;
+  actual.PushBack(OverAlignedValue());
+  actual.PushBack(OverAlignedValue());
+  CHECK(actual.IsInline());
+  CHECK_EQUAL(0, (size_t)&actual[0] % alignof(OverAlignedValue));
+  CHECK_EQUAL(0, (size_t)&actual[1] % alignof(OverAlignedValue));
+}
@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+///  \file MpscQueueTest.cpp
+///  Unit tests for the multiple producer single consumer queue.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "ContainerTestStandard.hpp"
+#include "CppUnitLite2/CppUnitLite2.h"
+
+#include "Containers/MpscQueue.hpp"
+#include "Platform/Thread.hpp"
+#include "String/String.hpp"
+
+typedef Zero::MpscQueue<int> IntQueue;
+typedef Zero::MpscQueue<Zero::String> StringQueue;
+
+Zero::Memory::ConcurrentPool* GetIntQueuePool()
+{
+  static Zero::Memory::ConcurrentPool* pool = new Zero::Memory::ConcurrentPool("IntQueueTest",
+    Zero::Memory::GetRoot(), IntQueue::cNodeSize, 64);
+  return pool;
+}
+
+TEST(MpscQueue_Order)
+{
+  IntQueue queue(GetIntQueuePool());
+  CHECK(queue.Empty());
+
+  int value = -1;
+  CHECK(!queue.Dequeue(value));
+
+  for(int i = 0; i < 100; ++i)
+    queue.Enqueue(i);
+  CHECK_EQUAL(100, queue.Count());
+
+  // Values come back out in the order they were pushed
+  for(int i = 0; i < 100; ++i)
+  {
+    CHECK(queue.Dequeue(value));
+    CHECK_EQUAL(i, value);
+  }
+
+  CHECK(queue.Empty());
+  CHECK(!queue.Dequeue(value));
+}
+
+TEST(MpscQueue_Clear)
+{
+  Zero::Memory::ConcurrentPool pool("StringQueueTest", Zero::Memory::GetRoot(), StringQueue::cNodeSize, 16);
+  {
+    StringQueue queue(&pool);
+    queue.Enqueue("Zero");
+    queue.Enqueue("One");
+
+    Zero::String value;
+    CHECK(queue.Dequeue(value));
+    CHECK(value == "Zero");
+
+    // Remaining values are released by clear (or the destructor)
+    queue.Clear();
+    CHECK(queue.Empty());
+    queue.Enqueue("Two");
+  }
+}
+
+const int cProducerCount = 4;
+const int cValuesPerProducer = 10000;
+
+struct ProducerData
+{
+  IntQueue* mQueue;
+  int mProducer;
+};
+
+Zero::OsInt ProduceValues(void* data)
+{
+  ProducerData* producer = (ProducerData*)data;
+  for(int i = 0; i < cValuesPerProducer; ++i)
+    producer->mQueue->Enqueue(producer->mProducer * cValuesPerProducer + i);
+  return 0;
+}
+
+TEST(MpscQueue_MultipleProducers)
+{
+  IntQueue queue(GetIntQueuePool());
+
+  ProducerData data[cProducerCount];
+  Zero::Thread threads[cProducerCount];
+  for(int i = 0; i < cProducerCount; ++i)
+  {
+    data[i].mQueue = &queue;
+    data[i].mProducer = i;
+    threads[i].Initialize(ProduceValues, &data[i], "Producer");
+    threads[i].Resume();
+  }
+
+  // Every value arrives once and each producer's values stay in order
+  int lastValue[cProducerCount] = { -1, -1, -1, -1 };
+  int received = 0;
+  while(received < cProducerCount * cValuesPerProducer)
+  {
+    int value;
+    if(!queue.Dequeue(value))
+      continue;
+
+    int producer = value / cValuesPerProducer;
+    int index = value % cValuesPerProducer;
+    CHECK(index > lastValue[producer]);
+    lastValue[producer] = index;
+    ++received;
+  }
+
+  for(int i = 0; i < cProducerCount; ++i)
+  {
+    threads[i].WaitForCompletion();
+    CHECK_EQUAL(cValuesPerProducer - 1, lastValue[i]);
+  }
+  CHECK(queue.Empty());
+}
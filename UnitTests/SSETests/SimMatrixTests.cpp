@@ -562,3 +562,25 @@ TEST(SimMat_BasisW)
   Check_SimVec4(expected, basisW);
 }
 
+//------------------------------------------------------ Transform Concatenation
+// The TransformStore computes parentWorld * local on row major matrices by
+// loading them as their transposes, which has to match the scalar multiply
+// used by Transform's pooled world matrix cache.
+TEST(SimMat_TransformConcatenation)
+{
+  Math::Mat4 parentWorld;
+  Math::Mat4 local;
+  for(uint i = 0; i < 16; ++i)
+  {
+    parentWorld.array[i] = init4[i];
+    local.array[i] = init4[15 - i] * scalar(0.5);
+  }
+  Math::Mat4 expected = parentWorld * local;
+
+  SimMat4 simLocal = UnAlignedLoadMat4x4(local.array);
+  SimMat4 simParentWorld = UnAlignedLoadMat4x4(parentWorld.array);
+  Math::Mat4 actual;
+  UnAlignedStoreMat4x4(actual.array, Simd::Multiply(simLocal, simParentWorld));
+
+  CHECK_ARRAY_CLOSE(expected.array, actual.array, 16, scalar(0.001));
+}
@@ -52,6 +52,8 @@ public:
 #include "Containers/BlockArray.hpp"
 #include "Containers/ByteBuffer.hpp"
 #include "Containers/CyclicArray.hpp"
+#include "Containers/InlineArray.hpp"
+#include "Containers/MpscQueue.hpp"
 #include "Containers/OwnedArray.hpp"
 #include "Containers/SortedArray.hpp"
 #include "Containers/UnsortedMap.hpp"
@@ -69,11 +71,14 @@ public:
 #include "Containers/HashSet.hpp"
 #include "Containers/SlotMap.hpp"
 #include "Memory/Block.hpp"
+#include "Memory/ConcurrentPool.hpp"
 #include "Memory/Graph.hpp"
+#include "Memory/FrameArena.hpp"
 #include "Memory/Heap.hpp"
 #include "Memory/LocalStackAllocator.hpp"
 #include "Memory/Memory.hpp"
 #include "Memory/Pool.hpp"
+#include "Memory/SmallObjectAllocator.hpp"
 #include "Memory/Stack.hpp"
 #include "Memory/ZeroAllocator.hpp"
 #include "NullPtr.hpp"
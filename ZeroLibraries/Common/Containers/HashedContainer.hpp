@@ -11,6 +11,14 @@
 
 #include "Allocator.hpp"
 #include "Hashing.hpp"
+#include "Utility/Misc.hpp"
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ZeroHashSse2 1
+#include <emmintrin.h>
+#else
+#define ZeroHashSse2 0
+#endif
 
 namespace Zero
 {
@@ -18,6 +26,74 @@ namespace Zero
 void* const cHashOpenNode = nullptr;
 void* const cHashEndNode = (void*)1;
 
+//The table is an array of nodes with one control byte per node. A control byte
+//is either empty, deleted (a value was erased) or holds the low 7 bits of the
+//hash of the node's value. Control bytes are looked at 16 at a time (a group),
+//so a lookup compares its 7 hash bits against a whole group at once and only
+//compares values whose bits match. Groups are probed in a triangular sequence
+//until a group with an empty byte is found.
+
+const size_t cHashGroupSize = 16;
+const s8 cHashControlEmpty = -128;
+const s8 cHashControlDeleted = -2;
+
+//Bit masks of the control bytes in a group that match.
+struct HashControlGroup
+{
+#if ZeroHashSse2
+  HashControlGroup(const s8* control)
+  {
+    mControl = _mm_loadu_si128((const __m128i*)control);
+  }
+
+  uint Match(s8 hashBits) const
+  {
+    return (uint)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hashBits), mControl));
+  }
+
+  uint MatchEmpty() const
+  {
+    return Match(cHashControlEmpty);
+  }
+
+  //Empty and deleted are the only control values with the sign bit set
+  uint MatchEmptyOrDeleted() const
+  {
+    return (uint)_mm_movemask_epi8(mControl);
+  }
+
+  __m128i mControl;
+#else
+  HashControlGroup(const s8* control)
+  {
+    mControl = control;
+  }
+
+  uint Match(s8 hashBits) const
+  {
+    uint bits = 0;
+    for (uint i = 0; i < cHashGroupSize; ++i)
+      bits |= uint(mControl[i] == hashBits) << i;
+    return bits;
+  }
+
+  uint MatchEmpty() const
+  {
+    return Match(cHashControlEmpty);
+  }
+
+  uint MatchEmptyOrDeleted() const
+  {
+    uint bits = 0;
+    for (uint i = 0; i < cHashGroupSize; ++i)
+      bits |= uint(mControl[i] < 0) << i;
+    return bits;
+  }
+
+  const s8* mControl;
+#endif
+};
+
 template<typename ValueType, typename Hasher, typename Allocator>
 class ZeroSharedTemplate HashedContainer : public AllocationContainer<Allocator>
 {
@@ -38,9 +114,8 @@ protected:
     //The value stored in the node (only valid if 'next' is not set to 'cHashOpenNode');
     ValueType Value;
 
-    //Can be set to another node in the chain, or to 'cHashOpenNode'
-    //which means the node itself is open, or to 'cHashEndNode'
-    //which means its at the end of the chain
+    //Set to 'cHashEndNode' when the node holds a value or to 'cHashOpenNode'
+    //when it is empty, so ranges can skip empty nodes without the control bytes
     Node* next;
   };
 
@@ -62,7 +137,9 @@ public:
   {
     mTableSize = 0;
     mSize = 0;
+    mDeletedCount = 0;
     mTable = nullptr;
+    mControl = nullptr;
     mMaxLoadFactor = 0.8f;
   }
 
@@ -104,9 +181,6 @@ public:
       --mSize;
 
       begin = SkipDead(begin, end);
-      //Skip empty slots
-      while (begin != end && begin->next == cHashOpenNode)
-        ++begin;
     }
 
     size_t Length() { return mSize; }
@@ -121,10 +195,10 @@ public:
   };
 
   //Get the hash value for a given value then
-  //mod it by the table size to get a valid index.
+  //mask it by the table size to get its first slot.
   size_type HashedIndex(const_reference value)
   {
-    return mHasher(value) % mTableSize;
+    return (MixHash(mHasher(value)) >> 7) & (mTableSize - 1);
   }
 
   ///////Container Global Modify//////////////////
@@ -132,49 +206,53 @@ public:
   //Rehash the contents of the table.
   void Rehash(size_type newTableSize)
   {
-    if (newTableSize < mSize)
-      return;
+    //The table is a power of two number of groups that fits all the values
+    size_type tableSize = cHashGroupSize;
+    while (tableSize < newTableSize || mSize > MaxUsedSlots(tableSize))
+      tableSize = GetNextSize(tableSize);
 
-    //Expand table to new size
     Node* oldTable = mTable;
+    s8* oldControl = mControl;
     size_type oldTableSize = mTableSize;
 
-    //Allocate the new table
-    Node* newTable = (Node*)mAllocator.Allocate(newTableSize * sizeof(Node));
+    //Allocate the new table with the control bytes after the nodes
+    byte* memory = (byte*)mAllocator.Allocate(TableBytes(tableSize));
+    mTable = (Node*)memory;
+    mControl = (s8*)(memory + tableSize * sizeof(Node));
+    mTableSize = tableSize;
+    mDeletedCount = 0;
 
     //Set all buckets to the open node.
-    for (size_type i = 0; i < newTableSize; ++i)
-      newTable[i].next = (Node*)cHashOpenNode;
+    for (size_type i = 0; i < tableSize; ++i)
+      mTable[i].next = (Node*)cHashOpenNode;
+    memset(mControl, cHashControlEmpty, tableSize);
 
-    //Set the internal member values
-    mTable = newTable;
-    mTableSize = newTableSize;
-    mSize = 0;
-
-    //Now reinsert all valid buckets values
+    //Now reinsert all valid buckets values, the values are
+    //already unique so there is no need to search for them
     for (size_type i = 0; i < oldTableSize; ++i)
     {
       Node& node = oldTable[i];
       if (node.next != cHashOpenNode)
       {
-        //If this errors here, it means most likely their 'equals' operator is wrong
-        InsertInternal(node.Value, OnCollisionError);
+        size_type hash = MixHash(mHasher(node.Value));
+        FillOpenNode(FindInsertSlot(hash), hash, node.Value);
       }
     }
 
     //Free the old table if it existed
     if (oldTableSize != 0)
     {
-      DestructTableValues(oldTable, oldTableSize);
-      mAllocator.Deallocate(oldTable, oldTableSize * sizeof(Node));
+      DestructTableValues(oldTable, oldControl, oldTableSize);
+      mAllocator.Deallocate(oldTable, TableBytes(oldTableSize));
     }
   }
 
   //Destroy all elements.
   void Clear()
   {
-    DestructTableValues(mTable, mTableSize);
+    DestructTableValues(mTable, mControl, mTableSize);
     mSize = 0;
+    mDeletedCount = 0;
   }
 
   //Destroy all elements and frees all memory.
@@ -183,13 +261,15 @@ public:
     if (mTable != nullptr)
     {
       //free all the values in the and then delete the table.
-      DestructTableValues(mTable, mTableSize);
-      mAllocator.Deallocate(mTable, mTableSize * sizeof(Node));
+      DestructTableValues(mTable, mControl, mTableSize);
+      mAllocator.Deallocate(mTable, TableBytes(mTableSize));
     }
 
     mTableSize = 0;
     mSize = 0;
+    mDeletedCount = 0;
     mTable = nullptr;
+    mControl = nullptr;
   }
 
   range All() const
@@ -201,8 +281,10 @@ public:
   void Swap(this_type& other)
   {
     Zero::Swap(mTable, other.mTable);
+    Zero::Swap(mControl, other.mControl);
     Zero::Swap(mTableSize, other.mTableSize);
     Zero::Swap(mSize, other.mSize);
+    Zero::Swap(mDeletedCount, other.mDeletedCount);
     Zero::Swap(mMaxLoadFactor, other.mMaxLoadFactor);
     Zero::Swap(mHasher, other.mHasher);
   }
@@ -236,104 +318,29 @@ public:
   template <typename CollisionFunc>
   InsertResult InsertInternal(const_reference value, CollisionFunc onCollison)
   {
-    //Expand the table if insertion would break load factor
-    //even if it might be a double Insert
-    CheckForExpand(mSize + 1);
+    size_type hash = MixHash(mHasher(value));
 
-
-    //Find the node for this value this is its
-    //primary bucket
-    size_type curHash = HashedIndex(value);
-    Node* node = mTable + curHash;
-
-    //If the node is empty (see 'next')
-    if (node->next != cHashOpenNode)
+    //Same key
+    if (mTableSize != 0)
     {
-      //If there is a collision check to see if it the
-      //object is in its primary bucket.
-
-      //Possible Collision or same key.
-      if (mHasher.Equal(node->Value, value))
+      Node* node = FindWithHash(value, hash, mHasher);
+      if (node != cHashOpenNode)
       {
         onCollison(node, value);
         return InsertResult(false, node);
       }
-      else
-      {
-        //Hash Collision
-        //If this hashed value is not in its primary bucket
-        //steal this bucket (robin hood hashing)
-        size_type actualHash = HashedIndex(node->Value);
-        if (actualHash != curHash)
-        {
-          //Kick the node out of the bucket
-
-          Node* movingNodePrimary = mTable + actualHash;
-
-          ErrorIf(movingNodePrimary->next == cHashOpenNode,
-                  "Bad hash function. Hash value has changed or other issue.");
-
-          Node* movingNodePrev = movingNodePrimary;
-
-          //Search through the moving nodes links
-          //and find the previous node. This node
-          //needs it next updated.
-          while (movingNodePrev->next != node)
-            movingNodePrev = movingNodePrev->next;
-
-          //Remove the object from the chain.
-          movingNodePrev->next = movingNodePrev->next->next;
-
-          //Inert the old object into its bucket chain
-          AppendToBucketChain(movingNodePrev, node->Value);
-
-          //Replace in current node
-          DestructNode(node);
-          FillOpenNode(node, value);
-
-          //Increase size
-          ++mSize;
-          return InsertResult(true, node);
-
-        }
-        else
-        {
-          //This bucket is the primary key for this value
-          Node* primaryNode = node;
-
-          //Different keys can be in the same bucket chain.
-          //So the entire bucket chain must be checked
-          //for double Insert.
-
-
-          for (Node* searchNode = primaryNode; searchNode != cHashEndNode; searchNode = searchNode->next)
-          {
-            if (mHasher.Equal(searchNode->Value, value))
-            {
-              onCollison(searchNode, value);
-              return InsertResult(false, searchNode);
-            }
-
-          }
-
-          //Not in the list Insert into this chain
-          ++mSize;
-          return InsertResult(true, AppendToBucketChain(primaryNode, value));
+    }
 
-        }
-      }
+    //Expand the table if insertion would break load factor
+    CheckForExpand(mSize + 1);
 
-    }
-    else
-    {
-      //bucket is free use it
-      //Construct the key
-      //Copy data into it
-      ++mSize;
-      FillOpenNode(node, value);
-      return InsertResult(true, node);
-    }
+    Node* node = FindInsertSlot(hash);
+    if (mControl[node - mTable] == cHashControlDeleted)
+      --mDeletedCount;
 
+    FillOpenNode(node, hash, value);
+    ++mSize;
+    return InsertResult(true, node);
   }
 
 
@@ -349,26 +356,7 @@ public:
       return (Node*)cHashOpenNode;
 
     //Hash the value given with the provided hasher.
-    size_type searchHash = searchHasher(searchValue) % mTableSize;
-    Node* node = mTable + searchHash;
-
-    //If the node's next is set to 'cHashOpenNode', it means that
-    // the node itself is open/empty
-    if (node->next != cHashOpenNode)
-    {
-      do
-      {
-        //Check to see if the value of this node is equal
-        //to the search value.
-        if (searchHasher.Equal(searchValue, node->Value))
-          return node;
-
-        //Move through all the objects in the linked list.
-        node = node->next;
-      } while (node != cHashEndNode);
-
-    }
-    return (Node*)cHashOpenNode;
+    return FindWithHash(searchValue, MixHash(searchHasher(searchValue)), searchHasher);
   }
 
   size_t Count(const_reference value)
@@ -396,37 +384,27 @@ public:
     return false;
   }
 
+  //Other nodes are never moved so ranges stay valid
   void EraseNode(Node* node)
   {
     ErrorIf(node == nullptr || node->next == cHashOpenNode,
             "Attempted to erase an invalid node.");
-    size_type eraseHash = HashedIndex(node->Value);
-    Node* bucketPrev = mTable + eraseHash;
+    size_type index = node - mTable;
 
-    if (bucketPrev == node)
+    //Lookups stop at a group with an empty byte, if this node's group already
+    //has one no lookup has ever probed past it and the byte can be emptied.
+    //Otherwise it is marked deleted so lookups continue on to the next group.
+    HashControlGroup group(mControl + (index & ~(cHashGroupSize - 1)));
+    if (group.MatchEmpty() != 0)
     {
-      if (bucketPrev->next != (Node*)cHashEndNode)
-      {
-        //node is the first node in a bucket chain
-        //remove the front by moving the next node
-        //in the chain into this bucket
-        MoveNode(bucketPrev, bucketPrev->next);
-      }
-      else
-      {
-        //Node chain just destroy it
-        DestructNode(bucketPrev);
-      }
-      --mSize;
-      return;
+      mControl[index] = cHashControlEmpty;
+    }
+    else
+    {
+      mControl[index] = cHashControlDeleted;
+      ++mDeletedCount;
     }
 
-    //Search for node's parent
-    while (bucketPrev->next != node)
-      bucketPrev = bucketPrev->next;
-
-    //remove the node from the list
-    bucketPrev->next = node->next;
     DestructNode(node);
     --mSize;
   }
@@ -479,22 +457,55 @@ protected:
   }
 
   Node* mTable;
+  //One control byte per node
+  s8* mControl;
   size_type mTableSize;
   size_type mSize;
+  //Control bytes marked deleted, they end lookups no sooner than a value
+  size_type mDeletedCount;
   float mMaxLoadFactor;
   Hasher mHasher;
   typedef Node node_type;
 
+  //Hashes with poor low bits (pointers, small integers) would fill the same
+  //groups, mix them before taking the slot and control bits.
+  static size_type MixHash(size_t hash)
+  {
+    u64 mixed = u64(hash) * 0x9E3779B97F4A7C15ull;
+    return size_type(mixed ^ (mixed >> 32));
+  }
+
+  static size_type TableBytes(size_type tableSize)
+  {
+    return tableSize * (sizeof(Node) + sizeof(s8));
+  }
+
+  //Always leaves an empty byte so lookups end
+  size_type MaxUsedSlots(size_type tableSize) const
+  {
+    size_type maxUsed = size_type(float(tableSize) * mMaxLoadFactor);
+    return maxUsed < tableSize ? maxUsed : tableSize - 1;
+  }
+
   void CheckForExpand(size_type newsize)
   {
-    if (mTableSize == 0 ||
-      (float(newsize) / float(mTableSize)) > MaxLoadFactor())
+    if (mTableSize == 0)
     {
-      size_type newTableSize = GetNextSize(mTableSize);
-      if (newTableSize == 0)
-        newTableSize = 16;
-      Rehash(newTableSize);
+      Rehash(cHashGroupSize);
+      return;
     }
+
+    if (newsize + mDeletedCount <= MaxUsedSlots(mTableSize))
+      return;
+
+    //If deleted bytes filled the table rehash at the same size to clear them,
+    //unless the values alone are close enough to the limit that it would
+    //happen again soon
+    size_type maxUsed = MaxUsedSlots(mTableSize);
+    size_type newTableSize = mTableSize;
+    if (newsize > maxUsed - maxUsed / 8)
+      newTableSize = GetNextSize(mTableSize);
+    Rehash(newTableSize);
   }
 
   //assumes d is power of 2
@@ -503,24 +514,50 @@ protected:
     return d * 2;
   }
 
-  Node* GetLastInBucketChain(Node* node)
+  template<typename searchType, typename searchHasherType>
+  Node* FindWithHash(const searchType& searchValue, size_type hash,
+                     searchHasherType& searchHasher) const
   {
-    while (node->next != cHashEndNode)
-      node = node->next;
-    return node;
+    s8 hashBits = s8(hash & 0x7F);
+    size_type mask = mTableSize - 1;
+    size_type groupStart = (hash >> 7) & mask & ~(cHashGroupSize - 1);
+
+    for (size_type step = cHashGroupSize; ; step += cHashGroupSize)
+    {
+      HashControlGroup group(mControl + groupStart);
+
+      //Only values with the same hash bits are compared
+      for (uint matches = group.Match(hashBits); matches != 0; matches &= matches - 1)
+      {
+        Node* node = mTable + groupStart + CountTrailingZeros(matches);
+        if (searchHasher.Equal(searchValue, node->Value))
+          return node;
+      }
+
+      if (group.MatchEmpty() != 0)
+        return (Node*)cHashOpenNode;
+
+      groupStart = (groupStart + step) & mask;
+    }
   }
 
-  inline Node* AppendToBucketChain(Node* root, const_reference value)
+  //First empty or deleted node in the probe sequence of the hash.
+  Node* FindInsertSlot(size_type hash)
   {
-    Node* lastInBucket = GetLastInBucketChain(root);
-    Node* openSlot = GetNextOpenBucket(lastInBucket);
+    size_type mask = mTableSize - 1;
+    size_type groupStart = (hash >> 7) & mask & ~(cHashGroupSize - 1);
 
-    FillOpenNode(openSlot, value);
-    lastInBucket->next = openSlot;
-    return openSlot;
+    for (size_type step = cHashGroupSize; ; step += cHashGroupSize)
+    {
+      uint open = HashControlGroup(mControl + groupStart).MatchEmptyOrDeleted();
+      if (open != 0)
+        return mTable + groupStart + CountTrailingZeros(open);
+
+      groupStart = (groupStart + step) & mask;
+    }
   }
 
-  static void DestructTableValues(Node* data, size_type size)
+  static void DestructTableValues(Node* data, s8* control, size_type size)
   {
     for (size_type i = 0; i < size; ++i)
     {
@@ -530,23 +567,16 @@ protected:
 
       data[i].next = (Node*)cHashOpenNode;
     }
-  }
 
-  void MoveNode(Node* dest, Node* source)
-  {
-    DestructNode(dest);
-
-    //Move
-    new(&dest->Value) value_type(source->Value);
-    dest->next = source->next;
-
-    DestructNode(source);
+    if (size != 0)
+      memset(control, cHashControlEmpty, size);
   }
 
-  void FillOpenNode(Node* node, const_reference value)
+  void FillOpenNode(Node* node, size_type hash, const_reference value)
   {
     new(&node->Value) value_type(value);
     node->next = (Node*)cHashEndNode;
+    mControl[node - mTable] = s8(hash & 0x7F);
   }
 
   void DestructNode(Node* node)
@@ -557,33 +587,5 @@ protected:
     node->next = (Node*)cHashOpenNode;
   }
 
-  Node* GetNextOpenBucket(Node* startingNode)
-  {
-    Node* cur = startingNode;
-    Node* end = mTable + mTableSize;
-
-    //Find a 'nearby' bucket by searching around the current
-    //bucket
-
-    while (cur < end)
-    {
-      if (cur->next == cHashOpenNode)
-        return cur;
-      ++cur;
-    }
-
-    cur = startingNode;
-    while (cur >= mTable)
-    {
-      if (cur->next == cHashOpenNode)
-        return cur;
-      --cur;
-    }
-
-    Error("No free slots. Hash map is not working correctly.");
-
-    return (Node*)cHashOpenNode;
-  }
-
 };
 }// namespace Zero
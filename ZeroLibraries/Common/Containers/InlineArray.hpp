@@ -0,0 +1,624 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file InlineArray.hpp
+/// Declaration of the InlineArray container.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+// Includes
+#include "Array.hpp"
+
+namespace Zero
+{
+/// Dynamic array that stores its first InlineCount elements inside the object
+/// and only allocates once it grows past that. Has the same interface as Array
+/// and uses Array's range, so ranges can be passed to code written for Array.
+/// Used for collections that almost always hold a handful of elements
+/// (components on a cog, traversal stacks) to avoid an allocation per object
+/// and the extra pointer chase on every access.
+/// Moving or swapping an array that is inline moves its elements, so
+/// pointers to the elements do not stay valid the way they do for Array.
+template< typename ValueType,
+          size_t InlineCount,
+          typename Allocator = DefaultAllocator,
+          typename value_tt  = StandardTraits<ValueType> >
+class ZeroSharedTemplate InlineArray : public AllocationContainer<Allocator>
+{
+public:
+  /// Standard Typedefs
+  typedef ValueType                                             value_type;
+  typedef value_type*                                           pointer;
+  typedef const value_type*                                     const_pointer;
+  typedef value_type&                                           reference;
+  typedef const value_type&                                     const_reference;
+  typedef pointer                                               iterator;
+  typedef const_pointer                                         const_iterator;
+  typedef size_t                                                size_type;
+  typedef ptrdiff_t                                             difference_type;
+  typedef InlineArray<ValueType, InlineCount, Allocator, value_tt> this_type;
+  typedef AllocationContainer<Allocator>                        base_type;
+  typedef reference                                             FrontResult;
+  typedef typename Array<ValueType>::range                      range;
+  using base_type::mAllocator;
+
+  /// Type Traits
+  typedef value_tt                                             value_type_traits;
+  typedef typename value_type_traits::is_pod_                  typeIsPod;
+  typedef typename value_type_traits::has_trivial_copy_        typePodCopy;
+  typedef typename value_type_traits::has_trivial_destructor_  typePodDes;
+  typedef typename value_type_traits::has_trivial_constructor_ typePodCon;
+  typedef typename value_type_traits::is_pod_                  typePodMove;
+
+  /// Constants
+  static const size_type InvalidIndex = size_type(-1);
+
+  //
+  // Member Functions
+  //
+
+  /// Default Constructor
+  InlineArray()
+    : mData(InlineData()),
+      mCapacity(InlineCount),
+      mSize(0)
+  {
+  }
+
+  /// Copy Constructor
+  InlineArray(const this_type& other)
+    : base_type(other),
+      mData(InlineData()),
+      mCapacity(InlineCount),
+      mSize(0)
+  {
+    Reserve(other.mSize);
+    UninitializedCopy(mData, other.mData, other.mSize, typePodCopy());
+    mSize = other.mSize;
+  }
+
+  /// Move Constructor
+  InlineArray(MoveReference<this_type> other)
+    : base_type(*other),
+      mData(InlineData()),
+      mCapacity(InlineCount),
+      mSize(0)
+  {
+    TakeElements(*other);
+  }
+
+  /// Constructs an array of the specified size with default constructed values
+  explicit InlineArray(size_type size)
+    : mData(InlineData()),
+      mCapacity(InlineCount),
+      mSize(0)
+  {
+    Resize(size);
+  }
+
+  /// Constructs an array of the specified size with copy constructed values
+  InlineArray(size_type size, const_reference fillType)
+    : mData(InlineData()),
+      mCapacity(InlineCount),
+      mSize(0)
+  {
+    Resize(size, fillType);
+  }
+
+  /// Destructor
+  ~InlineArray()
+  {
+    Deallocate();
+  }
+
+  /// Copy Assignment Operator
+  void operator=(const this_type& other)
+  {
+    if(&other == this)
+      return;
+
+    Assign(const_cast<this_type*>(&other)->All());
+  }
+
+  /// Move Assignment Operator
+  void operator=(MoveReference<this_type> other)
+  {
+    if(&other == this)
+      return;
+
+    Deallocate();
+    TakeElements(*other);
+  }
+
+  /// Comparison Operators
+  bool operator ==(const this_type& rhs) const
+  {
+    return Equal(this->All(), rhs.All());
+  }
+  bool operator !=(const this_type& rhs) const
+  {
+    return !(*this == rhs);
+  }
+
+  //
+  // Element Information
+  //
+
+  /// Maximum number of elements before the array must be reallocated
+  size_type capacity() const { return mCapacity; }
+
+  /// Returns true if the elements are stored inside the array object
+  bool IsInline() const { return mData == InlineData(); }
+
+  /// Returns true if the array Contains no elements, else false
+  bool Empty() const { return mSize == 0; }
+
+  /// Returns the number of elements in the array
+  size_type Size() const { return mSize; }
+
+  //
+  // Element Access
+  //
+
+  /// Returns an iterator to the beginning of the array
+  iterator       Begin()       { return mData; }
+  const_iterator Begin() const { return mData; }
+
+  /// Returns an iterator to the end of the array
+  iterator       End()       { return mData + mSize; }
+  const_iterator End() const { return mData + mSize; }
+
+  /// Returns a range of all elements in the array
+  range All()       { return range(Begin(), End());                 }
+  range All() const { return const_cast<InlineArray*>(this)->All(); }
+
+  /// Returns a pointer to the underlying data array
+  pointer       Data()       { return mData; }
+  const_pointer Data() const { return mData; }
+
+  /// Returns the range of elements from index to index + length
+  range SubRange(size_type index, size_type length)
+  {
+    ErrorIf(index + length > mSize, "Accessed array out of bounds.");
+    return range(mData + index, mData + index + length);
+  }
+  range SubRange(size_type index, size_type length) const
+  {
+    return const_cast<InlineArray*>(this)->SubRange(index, length);
+  }
+
+  /// Returns a reference to the element at the specified index
+  reference operator[](size_type index)
+  {
+    ErrorIf(index >= mSize, "Accessed array out of bounds.");
+    return mData[index];
+  }
+  const_reference operator[](size_type index) const
+  {
+    ErrorIf(index >= mSize, "Accessed array out of bounds.");
+    return mData[index];
+  }
+
+  /// Returns a reference to the element at the front of the array
+  reference Front()
+  {
+    ErrorIf(mSize == 0, "Empty array, no front element.");
+    return mData[0];
+  }
+  const_reference Front() const
+  {
+    ErrorIf(mSize == 0, "Empty array, no front element.");
+    return mData[0];
+  }
+
+  /// Returns a reference to the element at the back of the array
+  reference Back()
+  {
+    ErrorIf(mSize == 0, "Empty array, no back element.");
+    return mData[mSize - 1];
+  }
+  const_reference Back() const
+  {
+    ErrorIf(mSize == 0, "Empty array, no back element.");
+    return mData[mSize - 1];
+  }
+
+  //
+  // Element Modification
+  //
+
+  /// Swaps this array's elements with another array
+  void Swap(this_type& other)
+  {
+    if(&other == this)
+      return;
+
+    // Only heap buffers can be exchanged, inline elements have to be moved
+    this_type temp;
+    temp.TakeElements(*this);
+    TakeElements(other);
+    other.TakeElements(temp);
+  }
+
+  /// Constructs an element at the back of the array
+  reference PushBack()
+  {
+    ExpandToNewSize(mSize + 1);
+    Construct(mData + mSize, typeIsPod());
+    ++mSize;
+    return *(mData + (mSize - 1));
+  }
+
+  /// Copies an element to the back of the array
+  void PushBack(const_reference item)
+  {
+    const_pointer toBeAdded = &item;
+    if(mCapacity < mSize + 1)
+    {
+      //Is the item from this array.
+      //This prevents errors with array.PushBack(array[0]);
+      if(toBeAdded >= Begin() && toBeAdded < End())
+      {
+        size_type index = toBeAdded - Begin();
+        ExpandToNewSize(mSize + 1);
+        toBeAdded = mData + index;
+      }
+      else
+      {
+        ExpandToNewSize(mSize + 1);
+      }
+    }
+    ConstructWith(mData + mSize, *toBeAdded);
+    ++mSize;
+  }
+
+  /// Moves an element to the back of the array
+  void PushBack(MoveReference<value_type> item)
+  {
+    pointer toBeAdded = &item;
+    if(mCapacity < mSize + 1)
+    {
+      if(toBeAdded >= Begin() && toBeAdded < End())
+      {
+        size_type index = toBeAdded - Begin();
+        ExpandToNewSize(mSize + 1);
+        toBeAdded = mData + index;
+      }
+      else
+      {
+        ExpandToNewSize(mSize + 1);
+      }
+    }
+    ConstructWith(mData + mSize, ZeroMove(*toBeAdded));
+    ++mSize;
+  }
+
+  /// Removes the element at the front of the array
+  void PopFront()
+  {
+    Erase(mData);
+  }
+
+  /// Removes the element at the back of the array
+  void PopBack()
+  {
+    ErrorIf(mSize == 0, "Empty array, can not pop back element.");
+    Destroy(mData + mSize - 1, typePodDes());
+    --mSize;
+  }
+
+  /// Changes the number of elements stored in the array
+  /// Removes or default constructs elements at the back of the array as necessary
+  void Resize(size_type newSize)
+  {
+    if(mSize == newSize)
+      return;
+    else if(mSize < newSize)
+    {
+      Reserve(newSize);
+      UninitializedFill(mData + mSize, newSize - mSize, typePodCon());
+    }
+    else
+    {
+      DestroyElements(mData + newSize, mSize - newSize, typePodDes());
+    }
+    mSize = newSize;
+  }
+
+  /// Changes the number of elements stored in the array
+  /// Removes or copy constructs elements at the back of the array as necessary
+  void Resize(size_type newSize, const_reference defaultValue)
+  {
+    if(mSize == newSize)
+      return;
+    else if(mSize < newSize)
+    {
+      Reserve(newSize);
+      UninitializedFill(mData + mSize, newSize - mSize, defaultValue);
+    }
+    else
+    {
+      DestroyElements(mData + newSize, mSize - newSize, typePodDes());
+    }
+    mSize = newSize;
+  }
+
+  /// Clears all elements from the array, does not free heap memory
+  void Clear()
+  {
+    DestroyElements(mData, mSize, typePodDes());
+    mSize = 0;
+  }
+
+  /// Reserves at least the specified element capacity
+  void Reserve(size_type newCapacity)
+  {
+    if(mCapacity < newCapacity)
+      ChangeCapacity(newCapacity);
+  }
+
+  /// Destroys all elements and frees heap memory, the array is inline afterwards
+  void Deallocate()
+  {
+    DestroyElements(mData, mSize, typePodDes());
+    if(!IsInline())
+      mAllocator.Deallocate(mData, sizeof(value_type) * mCapacity);
+    mData = InlineData();
+    mCapacity = InlineCount;
+    mSize = 0;
+  }
+
+  //
+  // Insertion Operations
+  //
+
+  /// Clears the array and inserts a range of elements
+  template<typename inputRangeType>
+  void Assign(inputRangeType range)
+  {
+    Clear();
+    Insert(mData, range);
+  }
+
+  /// Appends a range of elements to the end of the array
+  template<typename inputRangeType>
+  void Append(inputRangeType inputRange)
+  {
+    Insert(mData + mSize, inputRange);
+  }
+
+  /// Inserts a range of elements before the specified position in the array
+  template<typename inputRangeType>
+  void Insert(pointer where, inputRangeType inputRange)
+  {
+    ErrorIf(where < mData || where > mData + mSize,
+            "Access array out of bounds.");
+
+    size_type elementsToInsert = inputRange.Length();
+    pointer buffer = InsertExpandCapacity(where, elementsToInsert);
+
+    for(; !inputRange.Empty(); inputRange.PopFront())
+    {
+      ConstructWith(buffer, inputRange.Front());
+      ++buffer;
+    }
+
+    mSize += elementsToInsert;
+  }
+
+  /// Inserts an element before the specified position in the array
+  void Insert(pointer where, const_reference value)
+  {
+    ErrorIf(where < mData || where > mData + mSize,
+            "Access array out of bounds.");
+    ConstPointerRange<value_type> singleValue(&value, &value + 1);
+    Insert(where, singleValue);
+  }
+  void InsertAt(size_type index, const_reference value)
+  {
+    //for insertion the index can be mSize
+    ErrorIf(index > mSize, "Access array out of bounds.");
+    if(index == mSize)
+      PushBack(value);
+    else
+      Insert(mData + index, value);
+  }
+
+  //
+  // Removal Operations
+  //
+
+  /// Removes the element at the specified position in the array
+  void EraseAt(size_type index)
+  {
+    ErrorIf(index >= mSize, "Access array out of bounds.");
+    EraseElements(mData + index, 1);
+  }
+  pointer Erase(pointer where)
+  {
+    ErrorIf(where < mData || where > mData + mSize,
+            "Access array out of bounds.");
+    EraseElements(where, 1);
+    if(!Empty())
+      return where;
+    else
+      return End();
+  }
+
+  /// Removes the sub-range of elements from their positions in the array
+  void Erase(range elements)
+  {
+    EraseElements(elements.Begin(), elements.Length());
+  }
+
+  /// Removes the first equivalent element from the array
+  /// Returns true if successful, else false (an equivalent element was not found)
+  template<typename CompareType>
+  bool EraseValue(const CompareType& value)
+  {
+    size_type index = FindIndex(value);
+    if(index == InvalidIndex)
+      return false;
+
+    Erase(mData + index);
+    return true;
+  }
+  /// Removes the first equivalent element from the array
+  /// Generates an error if an equivalent element was not found
+  template<typename CompareType>
+  void EraseValueError(const CompareType& value)
+  {
+    bool result = EraseValue(value);
+    if(!result)
+      Warn("Value not found in the array");
+  }
+
+  //
+  // Search Operations
+  //
+
+  /// Returns the index of the first equivalent element from the array, else InvalidIndex
+  template<typename CompareType>
+  size_type FindIndex(const CompareType& value) const
+  {
+    for(size_type i = 0; i < mSize; ++i)
+    {
+      if(mData[i] == value)
+        return i;
+    }
+
+    return InvalidIndex;
+  }
+
+  /// Returns a pointer to the first equivalent element in the array, else nullptr
+  template<typename CompareType>
+  pointer FindPointer(const CompareType& value) const
+  {
+    size_type index = FindIndex(value);
+    if(index == InvalidIndex)
+      return nullptr;
+    else
+      return mData + index;
+  }
+
+  /// Returns true if the array Contains an equivalent element, else false
+  template<typename CompareType>
+  bool Contains(const CompareType& value) const
+  {
+    return FindIndex(value) != InvalidIndex;
+  }
+
+protected:
+  pointer InlineData() const
+  {
+    return (pointer)mInline;
+  }
+
+  /// Moves the other array's elements into this empty inline array, a heap
+  /// buffer is taken over and inline elements are moved one by one.
+  /// The other array is left empty and inline.
+  void TakeElements(this_type& other)
+  {
+    ErrorIf(mSize != 0 || !IsInline(), "Array must be empty to take elements.");
+
+    if(other.IsInline())
+    {
+      UninitializedMove(mData, other.mData, other.mSize, typePodMove());
+    }
+    else
+    {
+      mData = other.mData;
+      mCapacity = other.mCapacity;
+      other.mData = other.InlineData();
+      other.mCapacity = InlineCount;
+    }
+
+    mSize = other.mSize;
+    other.mSize = 0;
+  }
+
+  /// Makes room for numberOfElements at where and returns the
+  /// position the new elements should be constructed at.
+  pointer InsertExpandCapacity(pointer where, size_type numberOfElements)
+  {
+    size_type index = where - mData;
+    ExpandToNewSize(mSize + numberOfElements);
+    where = mData + index;
+
+    size_type elementsToMove = mSize - index;
+    if(elementsToMove != 0)
+    {
+      UninitializedMoveRev(where + numberOfElements, where, elementsToMove,
+                           typePodMove());
+    }
+    return where;
+  }
+
+  /// Removes the specified number of elements from the array starting at the given position
+  void EraseElements(pointer where, size_type numberOfElements)
+  {
+    size_type elementsToMove = (End() - where) - numberOfElements;
+
+    DestroyElements(where, numberOfElements, typeIsPod());
+
+    if(elementsToMove > 0)
+    {
+      UninitializedMove(where, where + numberOfElements, elementsToMove,
+                        typePodMove());
+    }
+
+    mSize -= numberOfElements;
+  }
+
+  /// Expands the capacity by 50% or to the new size, whichever is larger
+  void ExpandToNewSize(size_type newSize)
+  {
+    if(mCapacity < newSize)
+    {
+      size_type expandedSize = mCapacity + (mCapacity / 2);
+      ChangeCapacity(expandedSize < newSize ? newSize : expandedSize);
+    }
+  }
+
+  /// Moves the elements to a new heap buffer (or back inline if they fit)
+  void ChangeCapacity(size_type newCapacity)
+  {
+    if(newCapacity < mSize)
+      Resize(newCapacity);
+
+    pointer newData;
+    if(newCapacity <= InlineCount)
+    {
+      if(IsInline())
+        return;
+      newData = InlineData();
+      newCapacity = InlineCount;
+    }
+    else
+    {
+      newData = (pointer)mAllocator.Allocate(newCapacity * sizeof(value_type));
+    }
+
+    if(mSize != 0)
+      UninitializedMove(newData, mData, mSize, typePodMove());
+
+    if(!IsInline())
+      mAllocator.Deallocate(mData, sizeof(value_type) * mCapacity);
+
+    mCapacity = newCapacity;
+    mData = newData;
+  }
+
+  /// Points at the inline elements or at a heap buffer
+  pointer   mData;
+  /// Element capacity, InlineCount while the elements are inline
+  size_type mCapacity;
+  /// Number of elements in the array
+  size_type mSize;
+
+  /// Storage for the inline elements, aligned for the element type
+  /// (including over aligned types such as simd vectors)
+  alignas(ValueType) byte mInline[sizeof(ValueType) * InlineCount];
+};
+
+} // namespace Zero
@@ -0,0 +1,124 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file MpscQueue.hpp
+/// Declaration of the lock-free multiple producer single consumer queue.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Utility/Atomic.hpp"
+#include "Memory/ConcurrentPool.hpp"
+
+namespace Zero
+{
+
+///A queue that any number of threads can push onto without locking while one
+///thread (the consumer) pops. Values are stored in a linked list of nodes where
+///producers swap themselves in as the head with a single atomic exchange and
+///then link the previous head to their node. The consumer always owns a stub
+///node at the tail, popping advances the tail to the next node (which becomes
+///the new stub) and frees the old one. A producer that has swapped the head but
+///not linked its node yet hides the values behind it until it finishes, so a
+///pop can miss values that were pushed concurrently; they are seen on a later pop.
+///Nodes are recycled through a ConcurrentPool shared by all queues of the type
+///(nodes freed by the consumer flow back to the producers through the pool).
+template<typename type>
+class MpscQueue
+{
+public:
+  typedef MpscQueue<type> this_type;
+  typedef type value_type;
+
+  struct Node
+  {
+    Node* volatile Next;
+    //Only constructed while the node is holding a value (never for the stub)
+    type Value;
+  };
+
+  ///Pool blocks must be at least this size.
+  static const size_t cNodeSize = sizeof(Node);
+
+  MpscQueue(Memory::ConcurrentPool* nodePool)
+  {
+    mNodePool = nodePool;
+    mCount = 0;
+
+    Node* stub = (Node*)mNodePool->Allocate(sizeof(Node));
+    stub->Next = nullptr;
+    mHead = stub;
+    mTail = stub;
+  }
+
+  ///No producers may be pushing when the queue is destroyed.
+  ~MpscQueue()
+  {
+    Clear();
+    mNodePool->Deallocate(mTail, sizeof(Node));
+  }
+
+  ///Adds a value to the queue, safe to call from any thread.
+  void Enqueue(const type& value)
+  {
+    Node* node = (Node*)mNodePool->Allocate(sizeof(Node));
+    node->Next = nullptr;
+    new(&node->Value) type(value);
+
+    //Counted before it can be popped so the count never goes negative
+    AtomicPreIncrement(&mCount);
+
+    Node* previous = (Node*)AtomicExchange((void* volatile*)&mHead, node);
+    AtomicStore((void* volatile*)&previous->Next, node);
+  }
+
+  ///Pops the oldest value, returns false if nothing could be popped.
+  ///Only the consumer thread may call this.
+  bool Dequeue(type& value)
+  {
+    Node* tail = mTail;
+    Node* next = (Node*)AtomicLoad((void* volatile*)&tail->Next);
+    if(next == nullptr)
+      return false;
+
+    //The next node becomes the stub
+    value = next->Value;
+    next->Value.~type();
+    mTail = next;
+
+    mNodePool->Deallocate(tail, sizeof(Node));
+    AtomicPreDecrement(&mCount);
+    return true;
+  }
+
+  ///Pops and destroys every value. Only the consumer thread may call this.
+  void Clear()
+  {
+    type value;
+    while(Dequeue(value))
+      ;
+  }
+
+  ///Number of values pushed but not yet popped. Values still being
+  ///pushed may be counted before they can be popped.
+  uint Count()
+  {
+    return (uint)AtomicLoad(&mCount);
+  }
+
+  bool Empty()
+  {
+    return Count() == 0;
+  }
+
+private:
+  //Most recently pushed node, swapped by producers
+  Node* volatile mHead;
+  //Stub node, only touched by the consumer
+  Node* mTail;
+  volatile s32 mCount;
+  Memory::ConcurrentPool* mNodePool;
+
+  MpscQueue(const this_type&);
+  void operator=(const this_type&);
+};
+
+}//namespace Zero
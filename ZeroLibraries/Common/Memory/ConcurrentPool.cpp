@@ -0,0 +1,370 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file ConcurrentPool.cpp
+/// Implementation of the thread safe memory pool allocator.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "ConcurrentPool.hpp"
+
+// A magazine is a chain of free blocks linked through their first word. While
+// a magazine is on the shared stack its first block also holds the link to the
+// next magazine and the number of blocks in the chain.
+//
+// The shared stack's head is a pointer with a counter packed into the unused
+// upper bits (the upper 16 bits on 64 bit, a separate 32 bits on 32 bit). The
+// counter changes on every push and pop so a thread that read the head before
+// another thread popped and pushed the same magazine fails its exchange instead
+// of linking in a stale next pointer. Pages are never freed while the pool is
+// in use, so reading the next pointer of a magazine that was just taken by
+// another thread is harmless.
+
+namespace Zero
+{
+namespace Memory
+{
+
+struct MagazineBlock
+{
+  MagazineBlock* NextBlock;
+  MagazineBlock* NextMagazine;
+  size_t Count;
+};
+
+//---------------------------------------------------------------- Tagged Pointer
+const uint cTagShift = sizeof(void*) == 8 ? 48 : 32;
+const u64 cPointerMask = (u64(1) << cTagShift) - 1;
+
+MagazineBlock* GetTaggedMagazine(s64 tagged)
+{
+  return (MagazineBlock*)size_t(u64(tagged) & cPointerMask);
+}
+
+s64 MakeTaggedMagazine(MagazineBlock* magazine, s64 previous)
+{
+  u64 tag = (u64(previous) >> cTagShift) + 1;
+  return s64((tag << cTagShift) | (u64(size_t(magazine)) & cPointerMask));
+}
+
+//------------------------------------------------------------------ Thread Cache
+// Pools are given an index into every thread's cache when they are created and
+// give it back when they are destroyed. Pools past the limit work off the shared stack.
+const uint cMaxConcurrentPools = 64;
+
+struct ThreadMagazines
+{
+  // Blocks are taken from and freed to the loaded magazine. The previous
+  // magazine is either empty or full, swapping the two keeps a thread that
+  // alternates between allocating and freeing off the shared stack.
+  MagazineBlock* Loaded;
+  uint LoadedCount;
+  MagazineBlock* Previous;
+  uint PreviousCount;
+};
+
+struct ThreadPoolCache
+{
+  ThreadMagazines Pools[cMaxConcurrentPools];
+  // Every live cache, so a pool's slot can be cleared in all of them
+  ThreadPoolCache* NextCache;
+};
+
+ZeroThreadLocal ThreadPoolCache* tPoolCache = nullptr;
+
+// Guards the list of caches and the pool indices. Only taken when a thread first
+// uses a pool or exits and when pools are created or cleaned up.
+SpinLock gPoolCacheLock;
+ThreadPoolCache* gPoolCaches = nullptr;
+ConcurrentPool* gConcurrentPools[cMaxConcurrentPools];
+// Indices that have never been used start at gNextPoolIndex, the indices of
+// destroyed pools are kept on a stack to be reused first
+uint gNextPoolIndex = 0;
+uint gFreePoolIndices[cMaxConcurrentPools];
+uint gFreePoolIndexCount = 0;
+
+ThreadMagazines& GetThreadMagazines(uint poolIndex)
+{
+  ThreadPoolCache* cache = tPoolCache;
+  if(cache == nullptr)
+  {
+    //Allocated with calloc so the cache does not count itself
+    cache = (ThreadPoolCache*)calloc(1, sizeof(ThreadPoolCache));
+    ErrorIf(cache == nullptr, "Failed to allocate pool cache for thread.");
+    tPoolCache = cache;
+
+    gPoolCacheLock.Lock();
+    cache->NextCache = gPoolCaches;
+    gPoolCaches = cache;
+    gPoolCacheLock.Unlock();
+  }
+  return cache->Pools[poolIndex];
+}
+
+void ReleaseThreadPoolCaches()
+{
+  ThreadPoolCache* cache = tPoolCache;
+  if(cache == nullptr)
+    return;
+
+  tPoolCache = nullptr;
+
+  // Held throughout so no pool can be destroyed while its magazines are given back
+  gPoolCacheLock.Lock();
+  for(ThreadPoolCache** link = &gPoolCaches; *link != nullptr; link = &(*link)->NextCache)
+  {
+    if(*link == cache)
+    {
+      *link = cache->NextCache;
+      break;
+    }
+  }
+
+  for(uint i = 0; i < cMaxConcurrentPools; ++i)
+  {
+    ConcurrentPool* pool = gConcurrentPools[i];
+    if(pool == nullptr)
+      continue;
+
+    ThreadMagazines& magazines = cache->Pools[i];
+    if(magazines.LoadedCount != 0)
+      pool->ReleaseMagazine(magazines.Loaded, magazines.LoadedCount);
+    if(magazines.PreviousCount != 0)
+      pool->ReleaseMagazine(magazines.Previous, magazines.PreviousCount);
+  }
+  gPoolCacheLock.Unlock();
+
+  free(cache);
+}
+
+uint AcquirePoolIndex(ConcurrentPool* pool)
+{
+  uint index = cMaxConcurrentPools;
+  gPoolCacheLock.Lock();
+  if(gFreePoolIndexCount != 0)
+    index = gFreePoolIndices[--gFreePoolIndexCount];
+  else if(gNextPoolIndex < cMaxConcurrentPools)
+    index = gNextPoolIndex++;
+
+  if(index < cMaxConcurrentPools)
+    gConcurrentPools[index] = pool;
+  gPoolCacheLock.Unlock();
+  return index;
+}
+
+// Drops the magazines every thread holds for the pool, they point into its pages
+void ClearPoolMagazines(uint index)
+{
+  if(index >= cMaxConcurrentPools)
+    return;
+
+  gPoolCacheLock.Lock();
+  for(ThreadPoolCache* cache = gPoolCaches; cache != nullptr; cache = cache->NextCache)
+    memset(&cache->Pools[index], 0, sizeof(ThreadMagazines));
+  gPoolCacheLock.Unlock();
+}
+
+void ReleasePoolIndex(uint index)
+{
+  if(index >= cMaxConcurrentPools)
+    return;
+
+  gPoolCacheLock.Lock();
+  gConcurrentPools[index] = nullptr;
+  gFreePoolIndices[gFreePoolIndexCount++] = index;
+  gPoolCacheLock.Unlock();
+}
+
+//--------------------------------------------------------------- Concurrent Pool
+ConcurrentPool::ConcurrentPool(cstr name, Graph* parent, size_t blockSize, size_t blocksPerPage)
+  : Graph(name, parent)
+{
+  ErrorIf(parent == nullptr, "Memory pool needs a parent node otherwise it will not be deallocated.");
+
+  //Free blocks hold the magazine links
+  if(blockSize < sizeof(MagazineBlock))
+    blockSize = sizeof(MagazineBlock);
+  blockSize = (blockSize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+  mBlockSize = blockSize;
+  mBlocksPerPage = blocksPerPage;
+  mPageSize = blockSize * blocksPerPage;
+  mFullMagazines = 0;
+
+  mPoolIndex = AcquirePoolIndex(this);
+}
+
+ConcurrentPool::~ConcurrentPool()
+{
+  CleanUp();
+  ReleasePoolIndex(mPoolIndex);
+}
+
+MemPtr ConcurrentPool::Allocate(size_t numberOfBytes)
+{
+  ErrorIf(numberOfBytes > mBlockSize, "Allocation is large than block size.");
+  AddAllocation(mBlockSize);
+
+  // Without a thread cache take one block and give the rest back
+  if(mPoolIndex >= cMaxConcurrentPools)
+  {
+    uint count;
+    MagazineBlock* block = (MagazineBlock*)AcquireMagazine(count);
+    if(count > 1)
+      ReleaseMagazine(block->NextBlock, count - 1);
+    return block;
+  }
+
+  ThreadMagazines& magazines = GetThreadMagazines(mPoolIndex);
+  if(magazines.LoadedCount == 0)
+  {
+    if(magazines.PreviousCount != 0)
+    {
+      magazines.Loaded = magazines.Previous;
+      magazines.LoadedCount = magazines.PreviousCount;
+      magazines.Previous = nullptr;
+      magazines.PreviousCount = 0;
+    }
+    else
+    {
+      magazines.Loaded = (MagazineBlock*)AcquireMagazine(magazines.LoadedCount);
+    }
+  }
+
+  MagazineBlock* block = magazines.Loaded;
+  magazines.Loaded = block->NextBlock;
+  --magazines.LoadedCount;
+  return block;
+}
+
+void ConcurrentPool::Deallocate(MemPtr ptr, size_t /*numberOfBytes*/)
+{
+  // It should be safe to delete null pointers
+  if(ptr == nullptr)
+    return;
+
+#ifdef ZeroDebug
+  // 0xFAFAFAFA is our own byte pattern used to show that we deallocated the memory, but have not
+  // yet released it to the os
+  memset(ptr, 0xFA, mBlockSize);
+#endif
+
+  RemoveAllocation(mBlockSize);
+
+  MagazineBlock* block = (MagazineBlock*)ptr;
+  if(mPoolIndex >= cMaxConcurrentPools)
+  {
+    block->NextBlock = nullptr;
+    ReleaseMagazine(block, 1);
+    return;
+  }
+
+  ThreadMagazines& magazines = GetThreadMagazines(mPoolIndex);
+  if(magazines.LoadedCount == cMagazineSize)
+  {
+    // Keep the full magazine as the previous one and start an empty one
+    if(magazines.PreviousCount != 0)
+      ReleaseMagazine(magazines.Previous, magazines.PreviousCount);
+    magazines.Previous = magazines.Loaded;
+    magazines.PreviousCount = magazines.LoadedCount;
+    magazines.Loaded = nullptr;
+    magazines.LoadedCount = 0;
+  }
+
+  block->NextBlock = magazines.Loaded;
+  magazines.Loaded = block;
+  ++magazines.LoadedCount;
+}
+
+void ConcurrentPool::ReleaseMagazine(MemPtr blocks, uint count)
+{
+  MagazineBlock* magazine = (MagazineBlock*)blocks;
+  magazine->Count = count;
+
+  s64 head;
+  do
+  {
+    head = AtomicLoad(&mFullMagazines);
+    magazine->NextMagazine = GetTaggedMagazine(head);
+  } while(!AtomicCompareExchangeBool(&mFullMagazines, MakeTaggedMagazine(magazine, head), head));
+}
+
+MemPtr ConcurrentPool::AcquireMagazine(uint& count)
+{
+  for(;;)
+  {
+    s64 head = AtomicLoad(&mFullMagazines);
+    MagazineBlock* magazine = GetTaggedMagazine(head);
+    if(magazine == nullptr)
+      return AllocatePage(count);
+
+    MagazineBlock* next = magazine->NextMagazine;
+    if(AtomicCompareExchangeBool(&mFullMagazines, MakeTaggedMagazine(next, head), head))
+    {
+      count = (uint)magazine->Count;
+      return magazine;
+    }
+  }
+}
+
+MemPtr ConcurrentPool::AllocatePage(uint& count)
+{
+  //Allocate a new page of memory and divide it into magazines,
+  //the first is returned and the rest are put on the shared stack.
+  DeltaDedicated(mPageSize);
+  byte* memoryPage = (byte*)zAllocate(mPageSize);
+  ErrorIf(memoryPage == nullptr, "Failed to allocate memory pool page.");
+
+  mPageLock.Lock();
+  mPages.PushBack(memoryPage);
+  mPageLock.Unlock();
+
+  MagazineBlock* first = nullptr;
+  for(size_t start = 0; start < mBlocksPerPage; start += cMagazineSize)
+  {
+    size_t end = start + cMagazineSize;
+    if(end > mBlocksPerPage)
+      end = mBlocksPerPage;
+
+    // Link the blocks of this magazine in address order
+    MagazineBlock* magazine = (MagazineBlock*)(memoryPage + mBlockSize * start);
+    for(size_t block = start; block < end; ++block)
+    {
+      MagazineBlock* current = (MagazineBlock*)(memoryPage + mBlockSize * block);
+      current->NextBlock = block + 1 < end ? (MagazineBlock*)(memoryPage + mBlockSize * (block + 1)) : nullptr;
+    }
+
+    if(first == nullptr)
+    {
+      first = magazine;
+      count = uint(end - start);
+    }
+    else
+    {
+      ReleaseMagazine(magazine, uint(end - start));
+    }
+  }
+
+  return first;
+}
+
+void ConcurrentPool::CleanUp()
+{
+  ErrorIf(GetLocalStats().BytesAllocated != 0, "Failed to release all memory from pool %s", Name.c_str());
+
+  //Blocks cached by any thread point into the pages being freed
+  ClearPoolMagazines(mPoolIndex);
+
+  //Deallocate each page
+  for(unsigned i = 0; i < mPages.Size(); ++i)
+    zDeallocate(mPages[i]);
+  mPages.Deallocate();
+  mFullMagazines = 0;
+}
+
+void ConcurrentPool::Print(size_t tabs, size_t flags)
+{
+  PrintHelper(tabs, flags, "ConcurrentPool");
+}
+
+}//namespace Memory
+}//namespace Zero
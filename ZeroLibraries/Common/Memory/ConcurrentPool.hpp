@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file ConcurrentPool.hpp
+/// Declaration of the thread safe memory pool allocator.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Containers/Array.hpp"
+#include "Utility/Atomic.hpp"
+#include "Utility/SpinLock.hpp"
+#include "Graph.hpp"
+
+namespace Zero
+{
+namespace Memory
+{
+
+///A memory pool that can be allocated from and freed to on any thread.
+///Each thread keeps two magazines (short lists of free blocks) per pool that
+///it allocates from and frees to without any synchronization. Full magazines
+///are exchanged with a lock-free stack shared by all threads, so the shared
+///state is only touched once every cMagazineSize operations. Blocks freed on a
+///different thread than they were allocated on are simply reused by that thread.
+///Used in place of Pool for objects created and destroyed by jobs.
+class ConcurrentPool : public Graph
+{
+public:
+  ///Blocks moved between a thread and the shared stack at a time.
+  static const uint cMagazineSize = 32;
+
+  ConcurrentPool(cstr name, Graph* parent, size_t blockSize, size_t blocksPerPage);
+  ~ConcurrentPool();
+
+  static void* operator new(size_t size) { return malloc(size); }
+  static void operator delete(void* pMem, size_t size) { free(pMem); }
+
+  template<typename type>
+  type* AllocateType();
+  template<typename type>
+  void DeallocateType(type* instance);
+  MemPtr Allocate(size_t numberOfBytes);
+  void Deallocate(MemPtr ptr, size_t numberOfBytes);
+  void Print(size_t tabs, size_t flags);
+  ///Frees all pages, no other thread may be using the pool.
+  void CleanUp();
+
+  ///Pushes a chain of count blocks onto the shared stack.
+  void ReleaseMagazine(MemPtr blocks, uint count);
+
+private:
+  MemPtr AcquireMagazine(uint& count);
+  MemPtr AllocatePage(uint& count);
+
+  //Index of this pool's magazines in each thread's cache
+  uint mPoolIndex;
+  size_t mBlockSize;
+  size_t mBlocksPerPage;
+  size_t mPageSize;
+  //Tagged pointer to the first magazine on the shared stack (see ConcurrentPool.cpp)
+  volatile s64 mFullMagazines;
+  SpinLock mPageLock;
+  Array<byte*> mPages;
+
+  ConcurrentPool(const ConcurrentPool&);
+  void operator=(const ConcurrentPool&);
+};
+
+///Gives the calling thread's magazines back to their pools (called on thread exit).
+void ReleaseThreadPoolCaches();
+
+template<typename type>
+type* ConcurrentPool::AllocateType()
+{
+  MemPtr memory = Allocate(sizeof(type));
+  type* object = new(memory) type();
+  return object;
+}
+
+template<typename type>
+void ConcurrentPool::DeallocateType(type* instance)
+{
+  instance->~type();
+  Deallocate(instance, sizeof(type));
+}
+
+}//namespace Memory
+}//namespace Zero
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file FrameArena.cpp
+/// Implementation of the per frame scratch memory arena.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+namespace Memory
+{
+
+//Size of the blocks the arena grows by
+const size_t cFrameArenaBlockSize = 256 * 1024;
+const size_t cFrameArenaAlignment = 16;
+
+//Header at the start of each block, the rest of the block is handed out
+struct FrameArenaBlock
+{
+  FrameArenaBlock* Next;
+  size_t Size;
+  //Keeps the data after the header aligned
+  size_t Padding[2];
+};
+
+struct FrameArenaBuffer
+{
+  //The first block is the one being allocated from
+  FrameArenaBlock* Blocks;
+  byte* Cursor;
+  byte* End;
+};
+
+struct ThreadFrameArena
+{
+  FrameArenaBuffer Buffers[2];
+  uint Current;
+  //Frame the current buffer was last used on
+  s32 Frame;
+  ThreadFrameArena* NextFree;
+};
+
+ZeroThreadLocal ThreadFrameArena* tFrameArena = nullptr;
+
+volatile s32 gFrameArenaFrame = 0;
+//Arenas of exited threads waiting to be reused
+ThreadFrameArena* gFreeFrameArenas = nullptr;
+SpinLock gFreeFrameArenasLock;
+//Memory graph node showing the bytes held by all arenas
+Graph* gFrameArenaNode = nullptr;
+
+void AllocateFrameArenaBlock(FrameArenaBuffer& buffer, size_t minimumSize)
+{
+  size_t size = minimumSize + sizeof(FrameArenaBlock);
+  if(size < cFrameArenaBlockSize)
+    size = cFrameArenaBlockSize;
+
+  FrameArenaBlock* block = (FrameArenaBlock*)zAllocate(size);
+  ErrorIf(block == nullptr, "Failed to allocate frame arena block.");
+  block->Size = size;
+  block->Next = buffer.Blocks;
+  buffer.Blocks = block;
+  buffer.Cursor = (byte*)(block + 1);
+  buffer.End = (byte*)block + size;
+
+  if(gFrameArenaNode)
+    gFrameArenaNode->DeltaDedicated(size);
+}
+
+void FreeFrameArenaBlocks(FrameArenaBuffer& buffer)
+{
+  FrameArenaBlock* block = buffer.Blocks;
+  while(block != nullptr)
+  {
+    FrameArenaBlock* next = block->Next;
+    if(gFrameArenaNode)
+      gFrameArenaNode->DeltaDedicated(MemCounterType(0) - block->Size);
+    zDeallocate(block);
+    block = next;
+  }
+
+  buffer.Blocks = nullptr;
+  buffer.Cursor = nullptr;
+  buffer.End = nullptr;
+}
+
+void ResetFrameArenaBuffer(FrameArenaBuffer& buffer)
+{
+  FrameArenaBlock* block = buffer.Blocks;
+  if(block == nullptr)
+    return;
+
+  if(block->Next == nullptr)
+  {
+    buffer.Cursor = (byte*)(block + 1);
+    return;
+  }
+
+  //The buffer grew last time it was used, replace all the blocks with one
+  //block big enough for all of them so a frame like it fits in a single block
+  size_t totalSize = 0;
+  for(; block != nullptr; block = block->Next)
+    totalSize += block->Size;
+
+  FreeFrameArenaBlocks(buffer);
+  AllocateFrameArenaBlock(buffer, totalSize);
+}
+
+ThreadFrameArena* GetThreadFrameArena()
+{
+  ThreadFrameArena* arena = tFrameArena;
+  if(arena != nullptr)
+    return arena;
+
+  gFreeFrameArenasLock.Lock();
+  arena = gFreeFrameArenas;
+  if(arena != nullptr)
+    gFreeFrameArenas = arena->NextFree;
+  gFreeFrameArenasLock.Unlock();
+
+  if(arena == nullptr)
+  {
+    arena = (ThreadFrameArena*)zAllocate(sizeof(ThreadFrameArena));
+    memset(arena, 0, sizeof(ThreadFrameArena));
+    arena->Frame = gFrameArenaFrame;
+  }
+
+  tFrameArena = arena;
+  return arena;
+}
+
+void AdvanceFrameArenas()
+{
+  if(gFrameArenaNode == nullptr)
+    gFrameArenaNode = GetNamedHeap("FrameArena");
+
+  AtomicPreIncrement(&gFrameArenaFrame);
+}
+
+MemPtr FrameAllocate(size_t numberOfBytes)
+{
+  ThreadFrameArena* arena = GetThreadFrameArena();
+
+  //Switch buffers the first time this thread allocates in a new frame
+  s32 frame = gFrameArenaFrame;
+  if(arena->Frame != frame)
+  {
+    arena->Current ^= 1;
+    ResetFrameArenaBuffer(arena->Buffers[arena->Current]);
+
+    //If more than one frame has passed the other buffer is old as well
+    if(frame - arena->Frame > 1)
+      ResetFrameArenaBuffer(arena->Buffers[arena->Current ^ 1]);
+
+    arena->Frame = frame;
+  }
+
+  numberOfBytes = (numberOfBytes + cFrameArenaAlignment - 1) & ~(cFrameArenaAlignment - 1);
+
+  FrameArenaBuffer& buffer = arena->Buffers[arena->Current];
+  if(size_t(buffer.End - buffer.Cursor) < numberOfBytes)
+    AllocateFrameArenaBlock(buffer, numberOfBytes);
+
+  byte* memory = buffer.Cursor;
+  buffer.Cursor += numberOfBytes;
+  return memory;
+}
+
+void ReleaseThreadFrameArena()
+{
+  ThreadFrameArena* arena = tFrameArena;
+  if(arena == nullptr)
+    return;
+
+  //The arena keeps its blocks and frame so memory handed out by the exiting
+  //thread stays valid for as long as it would have otherwise
+  tFrameArena = nullptr;
+  gFreeFrameArenasLock.Lock();
+  arena->NextFree = gFreeFrameArenas;
+  gFreeFrameArenas = arena;
+  gFreeFrameArenasLock.Unlock();
+}
+
+}//namespace Memory
+
+}//namespace Zero
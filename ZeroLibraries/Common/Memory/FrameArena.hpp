@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file FrameArena.hpp
+/// Declaration of the per frame scratch memory arena.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Graph.hpp"
+
+namespace Zero
+{
+
+namespace Memory
+{
+
+///Moves every thread's frame arena on to the next frame (called once at the
+///start of each engine update). Memory allocated two frames ago is reused.
+ZeroShared void AdvanceFrameArenas();
+
+///Allocates from the calling thread's frame arena. Each thread has two buffers
+///that are switched every frame, so the memory stays valid until the end of
+///the next frame. There is no deallocation, the buffer is reset all at once.
+ZeroShared MemPtr FrameAllocate(size_t numberOfBytes);
+
+///Lets another thread reuse the calling thread's arena (called on thread exit).
+void ReleaseThreadFrameArena();
+
+}//namespace Memory
+
+///Allocator for containers of scratch data that are built and thrown away within
+///a frame (Array<T, FrameAllocator>, HashMap<K, V, HashPolicy<K>, FrameAllocator>...).
+///Deallocate does nothing, so growing a container leaves its old buffers in the
+///arena until it is reset. Containers using it must not be kept (or cleared and
+///reused) past the end of the next frame.
+class FrameAllocator : public Memory::StandardMemory
+{
+public:
+  MemPtr Allocate(size_t numberOfBytes){return Memory::FrameAllocate(numberOfBytes);}
+  void Deallocate(MemPtr ptr, size_t numberOfBytes){}
+};
+
+}//namespace Zero
@@ -8,7 +8,8 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 #include "Precompiled.hpp"
-
+#include "SmallObjectAllocator.hpp"
+#include "ConcurrentPool.hpp"
 
 #ifdef UseMemoryDebugger
 #include "Allocations.hpp" //@ignore (for the compactor turning this into a single hpp/cpp)
@@ -27,8 +28,10 @@ void* zAllocate(size_t numberOfBytes)
   return DebugAllocate(numberOfBytes, AllocationType_Direct, 4);
 #elif UseMemoryTracker
   return DebugAllocate(numberOfBytes, 4);
-#else
+#elif UseSystemAllocator
   return malloc(numberOfBytes);
+#else
+  return Memory::SmallObjectAllocate(numberOfBytes);
 #endif
 }
 
@@ -38,8 +41,10 @@ void zDeallocate(void* ptr)
   DebugDeallocate(ptr, AllocationType_Direct);
 #elif UseMemoryTracker
   return DebugDeallocate(ptr);
-#else
+#elif UseSystemAllocator
   return free(ptr);
+#else
+  return Memory::SmallObjectDeallocate(ptr);
 #endif
 }
 
@@ -104,6 +109,170 @@ void Stats::Accumulate(const Stats& right)
   PeakAllocated += right.PeakAllocated;
 }
 
+//----------------------------------------------------------------- Thread Stats
+//Every thread that allocates gets a block of counters with a slot for each graph
+//node. Only the owning thread writes to its block so no atomics or locks are
+//needed, the blocks are summed when the stats are requested. Memory freed on a
+//different thread than it was allocated on makes that thread's counters wrap
+//below zero, the unsigned sum over all threads is still correct.
+//Slots of destroyed nodes are reused, this is the most nodes alive at once.
+const uint cMaxGraphNodes = 256;
+
+struct ThreadStats
+{
+  Stats Nodes[cMaxGraphNodes];
+  //Running totals over every node (see GetAllocationTotals)
+  MemCounterType TotalAllocations;
+  MemCounterType TotalBytesAllocated;
+  //Allocation sampling state (see Graph::SampleAllocation)
+  MemCounterType BytesSinceSample;
+  MemCounterType NextSample;
+  uint SampleRandom;
+  bool InSample;
+  //All blocks ever created (blocks are never freed)
+  ThreadStats* NextThread;
+  //Blocks of exited threads waiting to be reused
+  ThreadStats* NextFree;
+};
+
+ZeroThreadLocal ThreadStats* tThreadStats = nullptr;
+ThreadStats* volatile gThreadStats = nullptr;
+ThreadStats* gFreeThreadStats = nullptr;
+SpinLock gFreeThreadStatsLock;
+
+//Stats slots that have never been used start at gNextStatsIndex, the
+//slots of destroyed nodes are kept on a stack to be reused first
+SpinLock gStatsIndexLock;
+uint gNextStatsIndex = 0;
+uint gFreeStatsIndices[cMaxGraphNodes];
+uint gFreeStatsIndexCount = 0;
+bool gReportedStatsOverflow = false;
+
+AllocationSampler volatile gAllocationSampler = nullptr;
+volatile size_t gAllocationSampleInterval = 0;
+
+ThreadStats* GetThreadStats()
+{
+  ThreadStats* threadStats = tThreadStats;
+  if(threadStats != nullptr)
+    return threadStats;
+
+  //Reuse an exited thread's block, it keeps its counts so totals stay correct
+  gFreeThreadStatsLock.Lock();
+  threadStats = gFreeThreadStats;
+  if(threadStats != nullptr)
+    gFreeThreadStats = threadStats->NextFree;
+  gFreeThreadStatsLock.Unlock();
+
+  if(threadStats == nullptr)
+  {
+    //Allocated with calloc so the stats do not count themselves
+    threadStats = (ThreadStats*)calloc(1, sizeof(ThreadStats));
+    ErrorIf(threadStats == nullptr, "Failed to allocate memory stats for thread.");
+
+    void* head;
+    do
+    {
+      head = AtomicLoad((void* volatile*)&gThreadStats);
+      threadStats->NextThread = (ThreadStats*)head;
+    } while(!AtomicCompareExchangeBool((void* volatile*)&gThreadStats, threadStats, head));
+  }
+
+  tThreadStats = threadStats;
+  return threadStats;
+}
+
+void ReleaseThreadStats()
+{
+  ThreadStats* threadStats = tThreadStats;
+  if(threadStats == nullptr)
+    return;
+
+  tThreadStats = nullptr;
+  gFreeThreadStatsLock.Lock();
+  threadStats->NextFree = gFreeThreadStats;
+  gFreeThreadStats = threadStats;
+  gFreeThreadStatsLock.Unlock();
+}
+
+uint AcquireStatsIndex()
+{
+  uint index;
+  bool overflow = false;
+  gStatsIndexLock.Lock();
+  if(gFreeStatsIndexCount != 0)
+  {
+    index = gFreeStatsIndices[--gFreeStatsIndexCount];
+  }
+  else if(gNextStatsIndex < cMaxGraphNodes - 1)
+  {
+    index = gNextStatsIndex++;
+  }
+  else
+  {
+    //The last slot is shared by every node past the limit
+    index = cMaxGraphNodes - 1;
+    overflow = !gReportedStatsOverflow;
+    gReportedStatsOverflow = true;
+  }
+  gStatsIndexLock.Unlock();
+
+  if(overflow)
+  {
+    DebugPrint("Too many memory graph nodes are alive at once, the stats of the newest "
+               "nodes are combined. Increase cMaxGraphNodes.\n");
+    ErrorIf(true, "Created too many memory graph nodes. Increase cMaxGraphNodes.");
+  }
+  return index;
+}
+
+void ReleaseStatsIndex(uint index)
+{
+  //The shared overflow slot is never reused
+  if(index == cMaxGraphNodes - 1)
+    return;
+
+  //The node is gone so nothing writes to its slot anymore, clear it in every
+  //thread's block so the next node to use it starts from zero
+  ThreadStats* threadStats = (ThreadStats*)AtomicLoad((void* volatile*)&gThreadStats);
+  for(; threadStats != nullptr; threadStats = threadStats->NextThread)
+    threadStats->Nodes[index] = Stats();
+
+  gStatsIndexLock.Lock();
+  gFreeStatsIndices[gFreeStatsIndexCount++] = index;
+  gStatsIndexLock.Unlock();
+}
+
+void GetAllocationTotals(MemCounterType& allocations, MemCounterType& bytesAllocated)
+{
+  allocations = 0;
+  bytesAllocated = 0;
+  ThreadStats* threadStats = (ThreadStats*)AtomicLoad((void* volatile*)&gThreadStats);
+  for(; threadStats != nullptr; threadStats = threadStats->NextThread)
+  {
+    allocations += threadStats->TotalAllocations;
+    bytesAllocated += threadStats->TotalBytesAllocated;
+  }
+}
+
+void SetAllocationSampler(AllocationSampler sampler, size_t sampleInterval)
+{
+  if(sampler == nullptr)
+    sampleInterval = 0;
+
+  gAllocationSampleInterval = 0;
+  gAllocationSampler = sampler;
+  gAllocationSampleInterval = sampleInterval;
+}
+
+void ReleaseThreadMemory()
+{
+  ReleaseThreadStats();
+  ReleaseThreadFrameArena();
+  ReleaseThreadPoolCaches();
+  ReleaseThreadCache();
+}
+
 
 Root* Root::RootGraph = nullptr;
 Heap* Root::GloblHeap = nullptr;
@@ -197,23 +366,106 @@ public:
 
 Graph::Graph(cstr name, Graph* parent)
   : Name(name),
-  mParent(parent)
+  mParent(parent),
+  mPeakAllocated(0)
 {
+  mStatsIndex = AcquireStatsIndex();
+
   if(parent != nullptr)
     parent->Children.PushBack(this);
 }
 
+void Graph::DeltaDedicated(MemCounterType bytes)
+{
+  Stats& stats = GetThreadStats()->Nodes[mStatsIndex];
+  stats.BytesDedicated+=bytes;
+}
+
+void Graph::AddAllocation(MemCounterType bytes)
+{
+  ThreadStats* threadStats = GetThreadStats();
+  Stats& stats = threadStats->Nodes[mStatsIndex];
+  ++stats.Active;
+  ++stats.Allocations;
+  stats.BytesAllocated += bytes;
+  ++threadStats->TotalAllocations;
+  threadStats->TotalBytesAllocated += bytes;
+
+  if(gAllocationSampleInterval != 0)
+    SampleAllocation(threadStats, bytes);
+}
+
+void Graph::SampleAllocation(ThreadStats* threadStats, MemCounterType bytes)
+{
+  threadStats->BytesSinceSample += bytes;
+  if(threadStats->BytesSinceSample < threadStats->NextSample || threadStats->InSample)
+    return;
+
+  MemCounterType sampledBytes = threadStats->BytesSinceSample;
+  bool firstSample = threadStats->NextSample == 0;
+  threadStats->BytesSinceSample = 0;
+
+  //Take the next sample somewhere between half and one and a half intervals
+  //from now so allocation patterns that repeat every interval are not missed
+  size_t interval = gAllocationSampleInterval;
+  uint random = threadStats->SampleRandom;
+  if(random == 0)
+    random = uint(size_t(threadStats)) | 1;
+  random ^= random << 13;
+  random ^= random >> 17;
+  random ^= random << 5;
+  threadStats->SampleRandom = random;
+  threadStats->NextSample = interval / 2 + random % (interval + 1);
+  if(threadStats->NextSample == 0)
+    threadStats->NextSample = 1;
+
+  //The first allocation a thread makes only starts its countdown
+  AllocationSampler sampler = gAllocationSampler;
+  if(firstSample || sampler == nullptr)
+    return;
+
+  threadStats->InSample = true;
+  sampler(this, bytes, sampledBytes);
+  threadStats->InSample = false;
+}
+
+void Graph::RemoveAllocation(MemCounterType bytes)
+{
+  ThreadStats* threadStats = GetThreadStats();
+  Stats& stats = threadStats->Nodes[mStatsIndex];
+  --stats.Active;
+  stats.BytesAllocated -= bytes;
+  threadStats->TotalBytesAllocated -= bytes;
+}
+
+Stats Graph::GetLocalStats()
+{
+  Stats data;
+  ThreadStats* threadStats = (ThreadStats*)AtomicLoad((void* volatile*)&gThreadStats);
+  for(; threadStats != nullptr; threadStats = threadStats->NextThread)
+    data.Accumulate(threadStats->Nodes[mStatsIndex]);
+
+  //Tracking the exact peak would need a shared byte count on every allocation,
+  //instead it is raised to the total seen each time the stats are collected
+  MemCounterType peakAllocated = mPeakAllocated.Load();
+  while(data.BytesAllocated > peakAllocated && !mPeakAllocated.CompareExchangeBool(data.BytesAllocated, peakAllocated))
+    peakAllocated = mPeakAllocated.Load();
+  data.PeakAllocated = data.BytesAllocated > peakAllocated ? data.BytesAllocated : peakAllocated;
+  return data;
+}
+
 void Graph::PrintHeader(size_t flags)
 {
   //DebugPrint("%-*s", maxTabs*tabSize, "Name" );
 
   VistNamePrinter p;
 
+  Stats names;
   if(flags & Stats::ShowLocal)
-    mData.Visit(p, flags);
+    names.Visit(p, flags);
 
   if(flags & Stats::ShowTotal)
-    mData.Visit(p, flags);
+    names.Visit(p, flags);
 
   DebugPrint("\n");
 }
@@ -240,7 +492,10 @@ void Graph::PrintHelper(size_t tabs, size_t flags, cstr /*name*/)
   VistPrinter p;
 
   if(flags & Stats::ShowLocal)
-    mData.Visit(p, flags);
+  {
+    Stats local = GetLocalStats();
+    local.Visit(p, flags);
+  }
 
   if(flags & Stats::ShowTotal)
     total.Visit(p, flags);
@@ -257,7 +512,7 @@ void Graph::PrintHelper(size_t tabs, size_t flags, cstr /*name*/)
 
 void Graph::Compute(Stats& data)
 {
-  data.Accumulate(mData);
+  data.Accumulate(GetLocalStats());
   InListBaseLink<Graph>::range sub = Children.All();
   while(!sub.Empty())
   {
@@ -280,6 +535,7 @@ void Graph::Print(size_t tabs, size_t flags)
 Graph::~Graph()
 {
   DeleteObjectsIn(Children);
+  ReleaseStatsIndex(mStatsIndex);
 }
 
 Heap* GetNamedHeap(cstr name)
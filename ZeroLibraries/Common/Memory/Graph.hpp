@@ -9,6 +9,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "Memory.hpp"
+#include "Utility/Atomic.hpp"
 #include "Containers/InList.hpp"
 #include "String/FixedString.hpp"
 
@@ -44,6 +45,8 @@ struct ZeroShared Stats
   void Accumulate(const Stats& right);
 };
 
+struct ThreadStats;
+
 ///Base Memory graph node. All allocators are derived from this class for
 ///runtime memory statics collection and debugging. Class provides a graph
 ///structure for hierarchical grouping of memory and the ability to name allocators.
@@ -55,29 +58,18 @@ public:
   cstr GetName(){return Name.c_str();}
   FixedString<32> Name;
   Graph* mParent;
-  Stats mData;
 
   Graph(cstr name, Graph* parent);
 
-  void DeltaDedicated(MemCounterType bytes)
-  {
-    mData.BytesDedicated+=bytes;
-  }
+  // Counters are kept per thread (see Graph.cpp) so allocating threads never
+  // contend on or race over a shared counter.
+  void DeltaDedicated(MemCounterType bytes);
+  void AddAllocation(MemCounterType bytes);
+  void RemoveAllocation(MemCounterType bytes);
 
-  void AddAllocation(MemCounterType bytes)
-  {
-    ++mData.Active;
-    ++mData.Allocations;
-    mData.BytesAllocated+=bytes;
-    if(mData.BytesAllocated > mData.PeakAllocated)
-      mData.PeakAllocated = mData.BytesAllocated;
-  }
-
-  void RemoveAllocation(MemCounterType bytes)
-  {
-    --mData.Active;
-    mData.BytesAllocated-=bytes;
-  }
+  /// Sums the counters of every thread for this node (not including children).
+  /// The peak is the most bytes seen allocated by any call to this.
+  Stats GetLocalStats();
 
   typedef InListBaseLink<Graph>::range RangeType;
   RangeType GetChildren(){return Children.All();}
@@ -92,6 +84,13 @@ public:
   virtual void CleanUp();
   virtual ~Graph();
 private:
+  void SampleAllocation(ThreadStats* threadStats, MemCounterType bytes);
+
+  //Index of this node's counters in each thread's stats, given back when the node is destroyed
+  uint mStatsIndex;
+  //The most bytes seen allocated when the stats were collected
+  Atomic<MemCounterType> mPeakAllocated;
+
   //Can not copy memory managers.
   Graph(const Graph&);
   void operator=(const Graph&);
@@ -121,6 +120,22 @@ Heap* GetNamedHeap(cstr name);
 Root* GetRoot();
 Heap* GetStaticHeap();
 void Shutdown();
+/// Releases the calling thread's allocator cache, frame arena, pool magazines and stats, call before a thread exits.
+ZeroShared void ReleaseThreadMemory();
+
+/// Allocations ever made and bytes currently allocated through every graph node. Read
+/// from running totals kept by each thread, so it is cheap enough to call every frame
+/// (Compute on the root walks every node).
+ZeroShared void GetAllocationTotals(MemCounterType& allocations, MemCounterType& bytesAllocated);
+
+/// Called on the allocating thread about once every sample interval bytes allocated
+/// through graph nodes. sampledBytes is the number of bytes the sample stands for.
+/// Allocations made inside the sampler are not sampled.
+typedef void (*AllocationSampler)(Graph* node, size_t bytes, size_t sampledBytes);
+/// Sets the function called for allocation samples, a null sampler or an interval
+/// of zero turns sampling off.
+ZeroShared void SetAllocationSampler(AllocationSampler sampler, size_t sampleInterval);
+
 void DumpMemoryDebuggerStats(cstr projectName);
 
 class ZeroShared StandardMemory
@@ -41,7 +41,7 @@ void Pool::AllocatePage()
 
 void Pool::CleanUp()
 {
-  ErrorIf(mPodStackPool == false && mData.BytesAllocated != 0, "Failed to release all memory from pool %s", Name.c_str());
+  ErrorIf(mPodStackPool == false && GetLocalStats().BytesAllocated != 0, "Failed to release all memory from pool %s", Name.c_str());
   //Deallocate each page
   for(unsigned i=0;i<mPages.Size();++i)
     zDeallocate(mPages[i]);//mPageSize
@@ -0,0 +1,367 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file SmallObjectAllocator.cpp
+/// Implementation of the thread caching small object allocator.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+
+// Small allocations are grouped into size classes. Memory for each class is carved
+// from 64KB spans that are only ever used by that class, so the class of any block
+// can be found from its address with the span map (no per allocation header).
+// Each thread keeps a free list per class that it allocates from and frees to
+// without locking. Thread lists are refilled from (and overflow to) a shared list
+// per class in batches, so the shared lists are only locked every few dozen calls.
+//
+// Spans are never returned to the system. All of the allocator state is zero
+// initialized global data because zAllocate is called during static initialization.
+
+namespace Zero
+{
+
+namespace Memory
+{
+
+//------------------------------------------------------------------ Size Classes
+const size_t cSmallObjectAlignment = 16;
+// Classes below this size are 16 bytes apart
+const size_t cLinearClassLimit = 128;
+const uint cLinearClassCount = 8;
+
+uint GetSmallObjectClass(size_t numberOfBytes)
+{
+  if(numberOfBytes <= cLinearClassLimit)
+    return numberOfBytes == 0 ? 0 : uint((numberOfBytes - 1) / cSmallObjectAlignment);
+
+  // Find the power of two the size is in, each is split into four classes
+  size_t last = numberOfBytes - 1;
+  uint shift = 7;
+  while((last >> (shift + 1)) != 0)
+    ++shift;
+
+  return cLinearClassCount + (shift - 7) * 4 + uint(last >> (shift - 2)) - 4;
+}
+
+// Block size of each class
+const uint cSmallObjectClassSizes[cSmallObjectClassCount] =
+{
+  16, 32, 48, 64, 80, 96, 112, 128,
+  160, 192, 224, 256,
+  320, 384, 448, 512,
+  640, 768, 896, 1024,
+  1280, 1536, 1792, 2048
+};
+
+// Number of blocks moved between a thread's cache and the shared list at once
+// (about 4KB worth, at least 4 and at most 64 blocks)
+const uint cSmallObjectBatchCounts[cSmallObjectClassCount] =
+{
+  64, 64, 64, 64, 51, 42, 36, 32,
+  25, 21, 18, 16,
+  12, 10, 9, 8,
+  6, 5, 4, 4,
+  4, 4, 4, 4
+};
+
+size_t GetSmallObjectClassSize(uint sizeClass)
+{
+  return cSmallObjectClassSizes[sizeClass];
+}
+
+//--------------------------------------------------------------------- Span Map
+const uint cSpanShift = 16;
+const size_t cSpanSize = size_t(1) << cSpanShift;
+// Spans are carved out of larger chunks requested from the system
+const size_t cSpansPerChunk = 32;
+
+// Two level map from span index to (size class + 1), zero for memory that
+// does not belong to a span. 48 bits of address on 64 bit and 32 bits on 32 bit.
+const uint cAddressBits = sizeof(void*) == 8 ? 48 : 32;
+const uint cSpanMapLeafBits = 16;
+const uint cSpanMapRootBits = cAddressBits - cSpanShift - cSpanMapLeafBits;
+const size_t cSpanMapLeafSize = size_t(1) << cSpanMapLeafBits;
+
+struct SpanMapLeaf
+{
+  byte SizeClass[cSpanMapLeafSize];
+};
+
+SpanMapLeaf* volatile gSpanMap[size_t(1) << cSpanMapRootBits];
+
+// Returns the leaf for the span index (or null if the address is out of range)
+SpanMapLeaf* volatile* GetSpanMapRoot(size_t spanIndex)
+{
+  size_t rootIndex = spanIndex >> cSpanMapLeafBits;
+  if(rootIndex >= (size_t(1) << cSpanMapRootBits))
+    return nullptr;
+  return &gSpanMap[rootIndex];
+}
+
+uint GetSpanSizeClass(MemPtr ptr)
+{
+  size_t spanIndex = size_t(ptr) >> cSpanShift;
+  SpanMapLeaf* volatile* root = GetSpanMapRoot(spanIndex);
+  if(root == nullptr || *root == nullptr)
+    return cSmallObjectClassCount;
+
+  byte mapped = (*root)->SizeClass[spanIndex & (cSpanMapLeafSize - 1)];
+  return mapped == 0 ? cSmallObjectClassCount : uint(mapped - 1);
+}
+
+//-------------------------------------------------------------------- Free Lists
+struct FreeBlock
+{
+  FreeBlock* Next;
+};
+
+// Shared list for a size class, also owns the span blocks are currently carved from
+struct CentralFreeList
+{
+  SpinLock Lock;
+  FreeBlock* Head;
+  byte* SpanCursor;
+  byte* SpanEnd;
+};
+
+CentralFreeList gCentralLists[cSmallObjectClassCount];
+
+// Guards the current chunk and the span map
+SpinLock gSpanLock;
+byte* gChunkCursor;
+byte* gChunkEnd;
+
+// Takes a new span out of the current chunk and marks it with the size
+// class. Returns null if the system is out of memory.
+byte* AcquireSpan(uint sizeClass)
+{
+  gSpanLock.Lock();
+
+  if(gChunkCursor == gChunkEnd)
+  {
+    // Over allocate by a span so the chunk can be aligned to the span size
+    byte* chunk = (byte*)malloc(cSpansPerChunk * cSpanSize + cSpanSize);
+    if(chunk == nullptr)
+    {
+      gSpanLock.Unlock();
+      return nullptr;
+    }
+
+    size_t aligned = (size_t(chunk) + cSpanSize - 1) & ~(cSpanSize - 1);
+    gChunkCursor = (byte*)aligned;
+    gChunkEnd = gChunkCursor + cSpansPerChunk * cSpanSize;
+  }
+
+  byte* span = gChunkCursor;
+  size_t spanIndex = size_t(span) >> cSpanShift;
+  SpanMapLeaf* volatile* root = GetSpanMapRoot(spanIndex);
+  if(root == nullptr)
+  {
+    // Addresses outside of the span map are left to malloc
+    gSpanLock.Unlock();
+    return nullptr;
+  }
+
+  if(*root == nullptr)
+  {
+    SpanMapLeaf* leaf = (SpanMapLeaf*)calloc(1, sizeof(SpanMapLeaf));
+    if(leaf == nullptr)
+    {
+      gSpanLock.Unlock();
+      return nullptr;
+    }
+    *root = leaf;
+  }
+
+  (*root)->SizeClass[spanIndex & (cSpanMapLeafSize - 1)] = byte(sizeClass + 1);
+  gChunkCursor += cSpanSize;
+
+  gSpanLock.Unlock();
+  return span;
+}
+
+// Moves up to count blocks onto the list, returns how many were moved
+uint RefillFromCentral(uint sizeClass, FreeBlock*& head, uint count)
+{
+  CentralFreeList& central = gCentralLists[sizeClass];
+  size_t blockSize = cSmallObjectClassSizes[sizeClass];
+  uint moved = 0;
+
+  central.Lock.Lock();
+
+  while(moved < count && central.Head != nullptr)
+  {
+    FreeBlock* block = central.Head;
+    central.Head = block->Next;
+    block->Next = head;
+    head = block;
+    ++moved;
+  }
+
+  while(moved < count)
+  {
+    if(size_t(central.SpanEnd - central.SpanCursor) < blockSize)
+    {
+      byte* span = AcquireSpan(sizeClass);
+      if(span == nullptr)
+        break;
+      central.SpanCursor = span;
+      central.SpanEnd = span + cSpanSize;
+    }
+
+    FreeBlock* block = (FreeBlock*)central.SpanCursor;
+    central.SpanCursor += blockSize;
+    block->Next = head;
+    head = block;
+    ++moved;
+  }
+
+  central.Lock.Unlock();
+  return moved;
+}
+
+// Pushes a linked run of blocks (first to last) onto the shared list
+void ReleaseToCentral(uint sizeClass, FreeBlock* first, FreeBlock* last)
+{
+  CentralFreeList& central = gCentralLists[sizeClass];
+  central.Lock.Lock();
+  last->Next = central.Head;
+  central.Head = first;
+  central.Lock.Unlock();
+}
+
+//------------------------------------------------------------------ Thread Cache
+struct ThreadFreeList
+{
+  FreeBlock* Head;
+  uint Count;
+};
+
+struct ThreadCache
+{
+  ThreadFreeList Lists[cSmallObjectClassCount];
+  ThreadCache* NextFree;
+};
+
+ZeroThreadLocal ThreadCache* tThreadCache = nullptr;
+
+// Caches of exited threads are reused by new threads
+SpinLock gThreadCacheLock;
+ThreadCache* gFreeThreadCaches;
+
+ThreadCache* GetThreadCache()
+{
+  ThreadCache* cache = tThreadCache;
+  if(cache != nullptr)
+    return cache;
+
+  gThreadCacheLock.Lock();
+  cache = gFreeThreadCaches;
+  if(cache != nullptr)
+    gFreeThreadCaches = cache->NextFree;
+  gThreadCacheLock.Unlock();
+
+  if(cache == nullptr)
+  {
+    cache = (ThreadCache*)calloc(1, sizeof(ThreadCache));
+    if(cache == nullptr)
+      return nullptr;
+  }
+
+  tThreadCache = cache;
+  return cache;
+}
+
+// Moves count blocks from the front of the thread's list to the shared list
+void FlushThreadList(uint sizeClass, ThreadFreeList& list, uint count)
+{
+  if(count == 0)
+    return;
+
+  FreeBlock* first = list.Head;
+  FreeBlock* last = first;
+  for(uint i = 1; i < count; ++i)
+    last = last->Next;
+
+  list.Head = last->Next;
+  list.Count -= count;
+  ReleaseToCentral(sizeClass, first, last);
+}
+
+MemPtr SmallObjectAllocate(size_t numberOfBytes)
+{
+  if(numberOfBytes > cMaxSmallObjectSize)
+    return malloc(numberOfBytes);
+
+  uint sizeClass = GetSmallObjectClass(numberOfBytes);
+  ThreadCache* cache = GetThreadCache();
+  if(cache == nullptr)
+    return malloc(numberOfBytes);
+
+  ThreadFreeList& list = cache->Lists[sizeClass];
+  if(list.Head == nullptr)
+  {
+    list.Count += RefillFromCentral(sizeClass, list.Head, cSmallObjectBatchCounts[sizeClass]);
+    if(list.Head == nullptr)
+      return malloc(numberOfBytes);
+  }
+
+  FreeBlock* block = list.Head;
+  list.Head = block->Next;
+  --list.Count;
+  return block;
+}
+
+void SmallObjectDeallocate(MemPtr ptr)
+{
+  if(ptr == nullptr)
+    return;
+
+  uint sizeClass = GetSpanSizeClass(ptr);
+  if(sizeClass == cSmallObjectClassCount)
+  {
+    free(ptr);
+    return;
+  }
+
+  FreeBlock* block = (FreeBlock*)ptr;
+  ThreadCache* cache = GetThreadCache();
+  if(cache == nullptr)
+  {
+    ReleaseToCentral(sizeClass, block, block);
+    return;
+  }
+
+  ThreadFreeList& list = cache->Lists[sizeClass];
+  block->Next = list.Head;
+  list.Head = block;
+  ++list.Count;
+
+  // Keep a batch cached and give the rest back so that memory freed by
+  // one thread (but allocated by another) does not pile up
+  uint batchCount = cSmallObjectBatchCounts[sizeClass];
+  if(list.Count >= batchCount * 2)
+    FlushThreadList(sizeClass, list, batchCount);
+}
+
+void ReleaseThreadCache()
+{
+  ThreadCache* cache = tThreadCache;
+  if(cache == nullptr)
+    return;
+
+  tThreadCache = nullptr;
+  for(uint sizeClass = 0; sizeClass < cSmallObjectClassCount; ++sizeClass)
+  {
+    ThreadFreeList& list = cache->Lists[sizeClass];
+    FlushThreadList(sizeClass, list, list.Count);
+  }
+
+  gThreadCacheLock.Lock();
+  cache->NextFree = gFreeThreadCaches;
+  gFreeThreadCaches = cache;
+  gThreadCacheLock.Unlock();
+}
+
+}//namespace Memory
+
+}//namespace Zero
@@ -0,0 +1,40 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file SmallObjectAllocator.hpp
+/// Declaration of the thread caching small object allocator used by zAllocate.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Memory.hpp"
+
+namespace Zero
+{
+
+namespace Memory
+{
+
+/// Allocations larger than this go directly to the system heap.
+const size_t cMaxSmallObjectSize = 2048;
+
+/// Number of size classes (16 byte steps up to 128, then four steps per power of two).
+const uint cSmallObjectClassCount = 24;
+
+/// Returns the size class an allocation of the given size is served from.
+uint GetSmallObjectClass(size_t numberOfBytes);
+/// Returns the size of every block in the size class.
+size_t GetSmallObjectClassSize(uint sizeClass);
+
+/// Allocates from the calling thread's cache for the size class. Sizes larger than
+/// cMaxSmallObjectSize are allocated with malloc. Blocks are 16 byte aligned.
+MemPtr SmallObjectAllocate(size_t numberOfBytes);
+/// Frees memory from SmallObjectAllocate (on any thread). Memory that was not
+/// allocated from a small object span is passed to free.
+void SmallObjectDeallocate(MemPtr ptr);
+
+/// Returns every block cached by the calling thread to the shared free lists.
+/// Called when a thread exits, the cache is recreated if the thread allocates again.
+void ReleaseThreadCache();
+
+}//namespace Memory
+
+}//namespace Zero
@@ -48,7 +48,7 @@ StringPool::~StringPool()
 
 StringNode& StringPool::GetEmptyNode()
 {
-  static StringNode node = { 1, 0, 0,{ 0 } };
+  static StringNode node = { 1, 0, 0, 0,{ 0 } };
   return node;
 }
 
@@ -258,7 +258,7 @@ void String::initializeToDefault()
   StringPool& pool = StringPool::GetInstance();
   StringNode& node = pool.GetEmptyNode();
 #else
-  static StringNode node = { 1, 0, 0,{ 0 } };
+  static StringNode node = { 1, 0, 0, 0,{ 0 } };
 #endif
   Assign(&node);
 }
@@ -524,6 +524,7 @@ StringNode* String::AllocateNode(size_type size)
   //Make new string node
   StringNode* newNode = (StringNode*)zAllocate(nodeSize + bufferSize);
   newNode->RefCount = 1;
+  newNode->Atom = 0;
   newNode->Size = size;
   newNode->HashCode = 0;
   newNode->Data[size] = '\0';
@@ -54,6 +54,9 @@ struct StringNode
   static const size_type StringPoolFreeHashCode = (size_type)0;
 
   volatile count_type RefCount;
+  // A small id an interning table may assign to the string's contents (zero until assigned)
+  // This sits in what would otherwise be padding, see GetEventAtom
+  u32 Atom;
   size_type Size;
   size_type HashCode;
   value_type Data[1];
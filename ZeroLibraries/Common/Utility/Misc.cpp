@@ -144,6 +144,14 @@ u32 CountLeadingZeros(u32 x)
 
 #endif
 
+u32 CountSetBits(u64 x)
+{
+  x = x - ((x >> 1) & 0x5555555555555555ull);
+  x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+  return u32((x * 0x0101010101010101ull) >> 56);
+}
+
 u32 NextPowerOfTwo(u32 x)
 {
   u32 leadingZeros = CountLeadingZeros(x);
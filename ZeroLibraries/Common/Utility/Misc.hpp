@@ -121,6 +121,8 @@ bool IsBigEndian();
 u32 CountTrailingZeros(u32 x);
 /// Returns number of most significant zeros
 u32 CountLeadingZeros(u32 x);
+/// Returns the number of set bits
+u32 CountSetBits(u64 x);
 
 /// Will result in zero if most significant bit is set
 u32 NextPowerOfTwo(u32 x);
@@ -61,6 +61,7 @@ namespace Zero
 #include "ProtocolMessageData.hpp"
 #include "PeerLink.hpp"
 #include "Peer.hpp"
+#include "PeerReactor.hpp"
 
 // Replicator Forward Declarations
 namespace Zero
@@ -53,4 +53,12 @@ static const Bits MinPacketHeaderBits = ProtocolIdBits /// Packet protocol ID
 /// Maximum packet header size
 static const Bits MaxPacketHeaderBits = MinPacketHeaderBits
                                       + PacketSequenceIdBits; /// Packet sequence ID
+
+//---------------------------------------------------------------------------------//
+//                               Packet Pooling                                    //
+//---------------------------------------------------------------------------------//
+
+/// Maximum number of raw incoming packets (and their data buffers) each peer keeps for reuse
+static const uint MaxPooledRawPackets = 1024;
+
 } // namespace Zero
@@ -28,6 +28,8 @@ void Peer::ResetSession()
   mIpv4RawPackets.Clear();
   mIpv6RawPackets.Clear();
   mSendBitStream.Clear(false);
+  mBatchSends     = false;
+  mSendQueueCount = 0;
 
   InitializeStats();
 }
@@ -49,10 +51,6 @@ Peer::Peer(ProcessReceivedCustomPacketFn processReceivedCustomPacketFn, ProcessR
 
     /// Thread Data
     mFatalError(false),
-    mIpv4ReceiveThread(),
-    mExitIpv4ReceiveThread(false),
-    mIpv6ReceiveThread(),
-    mExitIpv6ReceiveThread(false),
 
     /// State Data
     mLocalTimer(),
@@ -66,6 +64,13 @@ Peer::Peer(ProcessReceivedCustomPacketFn processReceivedCustomPacketFn, ProcessR
     mIpv6RawPackets(),
     mIpv6RawPacketsLock(),
     mSendBitStream(),
+    mReceiveBatch(),
+    mRawPacketPool(),
+    mRawPacketPoolLock(),
+    mBatchSends(false),
+    mSendQueue(),
+    mSendQueueCount(0),
+    mSendDatagrams(),
     mReceiveStatsLock(),
     mReleasedCustomPackets(),
     mReleasedCustomPacketsLock(),
@@ -147,9 +152,7 @@ const IpAddress& Peer::GetLocalIpv6Address() const
 bool Peer::IsOpen() const
 {
   return mIpv4Socket.IsOpen()
-      || mIpv6Socket.IsOpen()
-      || !mIpv4ReceiveThread.IsCompleted()
-      || !mIpv6ReceiveThread.IsCompleted();
+      || mIpv6Socket.IsOpen();
 }
 
 InternetProtocol::Enum Peer::GetInternetProtocol() const
@@ -191,9 +194,6 @@ void Peer::Open(Status& status, ushort port, InternetProtocol::Enum internetProt
       mIpv4Socket.Bind(status, ipAddress);
       if(status.Succeeded()) // Successful?
       {
-        // Set IPv4 socket to blocking mode
-        mIpv4Socket.SetBlocking(status, true);
-
         // Enable socket broadcast capability
         bool canBroadcast = true;
         mIpv4Socket.SetSocketOption(status, SocketOption::CanBroadcast, canBroadcast);
@@ -223,11 +223,6 @@ void Peer::Open(Status& status, ushort port, InternetProtocol::Enum internetProt
 
       // Bind IPv6 socket
       mIpv6Socket.Bind(status, ipAddress);
-      if(status.Succeeded()) // Successful?
-      {
-        // Set IPv6 socket to blocking mode
-        mIpv6Socket.SetBlocking(status, true);
-      }
     }
   }
   if(status.Failed()) // Unable?
@@ -270,37 +265,31 @@ void Peer::Open(Status& status, ushort port, InternetProtocol::Enum internetProt
   }
 
   //
-  // Launch Threads
+  // Register Sockets
   //
 
   // Using IPv4 socket?
   if(mIpv4Socket.IsOpen())
   {
-    // Launch IPv4 receive thread
-    mExitIpv4ReceiveThread = false;
-    bool result = mIpv4ReceiveThread.Initialize(Thread::ObjectEntryCreator<Peer, &Peer::Ipv4ReceiveThreadFn>, this, "PeerIpv4ReceiveThread");
-    if(!result) // Unable?
+    // Receive IPv4 packets on the shared reactor thread
+    PeerReactor::Register(status, this, mIpv4Socket, InternetProtocol::V4);
+    if(status.Failed()) // Unable?
     {
-      status.SetFailed("Unable to launch peer IPv4 receive thread");
       Close();
       return;
     }
-    mIpv4ReceiveThread.Resume();
   }
 
   // Using IPv6 socket?
   if(mIpv6Socket.IsOpen())
   {
-    // Launch IPv6 receive thread
-    mExitIpv6ReceiveThread = false;
-    bool result = mIpv6ReceiveThread.Initialize(Thread::ObjectEntryCreator<Peer, &Peer::Ipv6ReceiveThreadFn>, this, "PeerIpv6ReceiveThread");
-    if(!result) // Unable?
+    // Receive IPv6 packets on the shared reactor thread
+    PeerReactor::Register(status, this, mIpv6Socket, InternetProtocol::V6);
+    if(status.Failed()) // Unable?
     {
-      status.SetFailed("Unable to launch peer IPv6 receive thread");
       Close();
       return;
     }
-    mIpv6ReceiveThread.Resume();
   }
 
   // Update once to initialize links and plugins
@@ -343,28 +332,6 @@ void Peer::Close()
   Assert(mPlugins.Empty());
   Assert(mRemovedPlugins.Empty());
 
-  //
-  // Unblock Receive Threads
-  //
-
-  // IPv4 receive thread running?
-  if(!mIpv4ReceiveThread.IsCompleted())
-  {
-    mExitIpv4ReceiveThread = true;
-    Assert(mIpv4Address.IsValid());
-    OutPacket packet(mIpv4Address);
-    SendPacket(packet);
-  }
-
-  // IPv6 receive thread running?
-  if(!mIpv6ReceiveThread.IsCompleted())
-  {
-    mExitIpv6ReceiveThread = true;
-    Assert(mIpv6Address.IsValid());
-    OutPacket packet(mIpv6Address);
-    SendPacket(packet);
-  }
-
   //
   // Close Sockets
   //
@@ -372,6 +339,9 @@ void Peer::Close()
   // IPv4 socket open?
   if(mIpv4Socket.IsOpen())
   {
+    // Stop receiving on the reactor thread (before the socket handle can be reused)
+    PeerReactor::Unregister(this, mIpv4Socket);
+
     Status status;
     mIpv4Socket.Close(status);
     Assert(!mIpv4Socket.IsOpen());
@@ -380,35 +350,14 @@ void Peer::Close()
   // IPv6 socket open?
   if(mIpv6Socket.IsOpen())
   {
+    // Stop receiving on the reactor thread (before the socket handle can be reused)
+    PeerReactor::Unregister(this, mIpv6Socket);
+
     Status status;
     mIpv6Socket.Close(status);
     Assert(!mIpv6Socket.IsOpen());
   }
 
-  //
-  // Close Receive Threads
-  //
-
-  // IPv4 receive thread running?
-  if(!mIpv4ReceiveThread.IsCompleted())
-  {
-    // Close IPv4 receive thread
-    mExitIpv4ReceiveThread = true;
-    mIpv4ReceiveThread.WaitForCompletion();
-    mIpv4ReceiveThread.Close();
-    Assert(mIpv4ReceiveThread.IsCompleted());
-  }
-
-  // IPv6 receive thread running?
-  if(!mIpv6ReceiveThread.IsCompleted())
-  {
-    // Close IPv6 receive thread
-    mExitIpv6ReceiveThread = true;
-    mIpv6ReceiveThread.WaitForCompletion();
-    mIpv6ReceiveThread.Close();
-    Assert(mIpv6ReceiveThread.IsCompleted());
-  }
-
   // Reset all peer session data
   ResetSession();
 }
@@ -471,10 +420,18 @@ bool Peer::Update()
   UpdateAndGetLocalTime();
   ++mLocalFrameId;
 
+  // Queue packets sent during the update (updates may be nested)
+  bool wasBatchingSends = mBatchSends;
+  mBatchSends = true;
+
   // Update peer state and process received custom packets
   UpdatePeerState();
   ProcessReceivedCustomPackets();
 
+  // Send queued packets in batches
+  FlushSendQueue();
+  mBatchSends = wasBatchingSends;
+
   // Success
   return true;
 }
@@ -805,6 +762,21 @@ bool Peer::SendPacket(OutPacket& outPacket)
   if(!PluginEventOnPacketSend(outPacket))
     return true;
 
+  // Batching sends?
+  if(mBatchSends)
+  {
+    // Reuse a previously queued packet (and its data buffer) if available
+    if(mSendQueueCount == mSendQueue.Size())
+      mSendQueue.PushBack(RawPacket());
+    RawPacket& rawPacket = mSendQueue[mSendQueueCount++];
+
+    // Write packet to queued bitstream
+    rawPacket.mIpAddress = outPacket.GetDestinationIpAddress();
+    rawPacket.mData.Clear(false);
+    rawPacket.mData.Write(outPacket);
+    return true;
+  }
+
   // Write packet to bitstream
   mSendBitStream.Write(outPacket);
 
@@ -829,6 +801,62 @@ bool Peer::SendPacket(OutPacket& outPacket)
   mSendBitStream.Clear(false);
   return (result != 0);
 }
+void Peer::FlushSendQueue()
+{
+  // Nothing queued?
+  if(mSendQueueCount == 0)
+    return;
+
+  // Send queued packets over their sockets
+  if(mIpv4Socket.IsOpen())
+    FlushSendQueue(mIpv4Socket);
+  if(mIpv6Socket.IsOpen())
+    FlushSendQueue(mIpv6Socket);
+
+  // Clear for next update (queued packets keep their data buffers)
+  mSendQueueCount = 0;
+}
+void Peer::FlushSendQueue(Socket& socket)
+{
+  // Gather queued packets destined for this socket
+  mSendDatagrams.Clear();
+  for(uint i = 0; i < mSendQueueCount; ++i)
+  {
+    RawPacket& rawPacket = mSendQueue[i];
+
+    // Choose correct socket (IPv4 or IPv6)
+    Socket& packetSocket = rawPacket.mIpAddress.GetInternetProtocol() == InternetProtocol::V4
+                         ? mIpv4Socket
+                         : mIpv6Socket;
+    if(&packetSocket != &socket)
+      continue;
+
+    SocketDatagram datagram;
+    datagram.mData    = const_cast<byte*>(rawPacket.mData.GetData());
+    datagram.mLength  = rawPacket.mData.GetBytesWritten();
+    datagram.mAddress = rawPacket.mIpAddress;
+    mSendDatagrams.PushBack(datagram);
+  }
+
+  // Send datagrams over socket in batches
+  size_t sentCount = 0;
+  while(sentCount < mSendDatagrams.Size())
+  {
+    Status status;
+    size_t result = socket.SendToBatch(status, mSendDatagrams.Data() + sentCount, mSendDatagrams.Size() - sentCount);
+
+    // Update stats
+    for(size_t i = sentCount; i < sentCount + result; ++i)
+      UpdateSendStats(mSendDatagrams[i].mLength);
+    sentCount += result;
+
+    // Unable to send a datagram? (Drop it, as an individual send would)
+    if(status.Failed())
+      ++sentCount;
+    else if(result == 0)
+      break;
+  }
+}
 
 void Peer::UpdateSendStats(Bytes sentPacketBytes)
 {
@@ -893,98 +921,114 @@ bool Peer::IsValidRawPacket(RawPacket& rawPacket)
   return true;
 }
 
-OsInt Peer::Ipv4ReceiveThreadFn()
-{
-try
+void Peer::PrepareReceiveBatch(SocketDatagram* datagrams, size_t datagramCount)
 {
   //
-  // Receive Loop
+  // Acquire Raw Packets
   //
-  RawPacket rawPacket;
-  rawPacket.mData.Reserve(EthernetMtuBytes);
-  while(!mExitIpv4ReceiveThread)
-  {
-    // Wait to receive a packet over socket
-    Status status;
-    SocketAddress sourceAddress;
-    Bytes result = mIpv4Socket.ReceiveFrom(status, rawPacket.mData.GetDataExposed(), EthernetMtuBytes, sourceAddress);
-    rawPacket.mData.SetBytesWritten(result);
-    rawPacket.mIpAddress = sourceAddress;
-    if(result && IsValidRawPacket(rawPacket)) // Successful?
-    {
-      Assert(rawPacket.mIpAddress.IsValid());
-
-      { //<>-<>-<>-<>-< IPv4 Raw Packets Locked >-<>-<>-<>-<>-
-        Lock lock(mIpv4RawPacketsLock);
+  mReceiveBatch.Clear();
+  { //<>-<>-<>-<>-< Raw Packet Pool Locked >-<>-<>-<>-<>-
+    Lock lock(mRawPacketPoolLock);
 
-        // Push raw packet copy
-        mIpv4RawPackets.PushBack(rawPacket);
+    // Reuse pooled raw packets (and their data buffers)
+    while(mReceiveBatch.Size() < datagramCount && !mRawPacketPool.Empty())
+    {
+      mReceiveBatch.PushBack(ZeroMove(mRawPacketPool.Back()));
+      mRawPacketPool.PopBack();
+    }
 
-      } //-<>-<>-<>-<>-< IPv4 Raw Packets Unlocked >-<>-<>-<>-<>
+  } //-<>-<>-<>-<>-< Raw Packet Pool Unlocked >-<>-<>-<>-<>
+  mReceiveBatch.Resize(datagramCount);
 
-      // Update stats
-      UpdateReceiveStats(result);
-    }
+  //
+  // Point Datagrams At Raw Packets
+  //
+  for(size_t i = 0; i < datagramCount; ++i)
+  {
+    RawPacket& rawPacket = mReceiveBatch[i];
+    rawPacket.mData.Reserve(EthernetMtuBytes);
 
-    // Clear for next receive
-    rawPacket.mIpAddress.Clear();
-    rawPacket.mData.Clear(false);
+    // The socket receives straight into the raw packet's data buffer
+    datagrams[i].mData     = rawPacket.mData.GetDataExposed();
+    datagrams[i].mCapacity = EthernetMtuBytes;
   }
-
-  // Success
-  return 0;
-}
-catch(const std::exception& error)
-{
-  // [Peer Event]
-  PeerEventFatalError(error.what());
-}
-catch(...)
-{
-  // [Peer Event]
-  PeerEventFatalError("Unknown IPv4 receive thread error");
-}
-  // Failure
-  return 1;
 }
-OsInt Peer::Ipv6ReceiveThreadFn()
+
+void Peer::ReceiveDatagrams(InternetProtocol::Enum internetProtocol, SocketDatagram* datagrams, size_t datagramCount)
 {
 try
 {
+  Assert(datagramCount <= mReceiveBatch.Size());
+
   //
-  // Receive Loop
+  // Validate Datagrams
   //
-  RawPacket rawPacket;
-  rawPacket.mData.Reserve(EthernetMtuBytes);
-  while(!mExitIpv6ReceiveThread)
+  size_t validCount = 0;
+  for(size_t i = 0; i < datagramCount; ++i)
   {
-    // Wait to receive a packet over socket
-    Status status;
-    Bytes result = mIpv6Socket.ReceiveFrom(status, rawPacket.mData.GetDataExposed(), EthernetMtuBytes, rawPacket.mIpAddress);
-    rawPacket.mData.SetBytesWritten(result);
-    if(result && IsValidRawPacket(rawPacket)) // Successful?
+    SocketDatagram& datagram  = datagrams[i];
+    RawPacket&      rawPacket = mReceiveBatch[i];
+
+    // Already received in place, just record the length and source
+    rawPacket.mData.SetBytesWritten(datagram.mLength);
+    rawPacket.mIpAddress = datagram.mAddress;
+    if(datagram.mLength && IsValidRawPacket(rawPacket)) // Successful?
     {
       Assert(rawPacket.mIpAddress.IsValid());
 
-      { //<>-<>-<>-<>-< IPv6 Raw Packets Locked >-<>-<>-<>-<>-
-        Lock lock(mIpv6RawPacketsLock);
-
-        // Push raw packet copy
-        mIpv6RawPackets.PushBack(rawPacket);
-
-      } //-<>-<>-<>-<>-< IPv6 Raw Packets Unlocked >-<>-<>-<>-<>
+      // Keep valid raw packets at the front of the batch (moving only swaps their buffers)
+      if(validCount != i)
+      {
+        RawPacket invalidRawPacket(ZeroMove(mReceiveBatch[validCount]));
+        mReceiveBatch[validCount] = ZeroMove(rawPacket);
+        rawPacket = ZeroMove(invalidRawPacket);
+      }
+      ++validCount;
 
       // Update stats
-      UpdateReceiveStats(result);
+      UpdateReceiveStats(datagram.mLength);
     }
+    else
+    {
+      // Clear for reuse
+      rawPacket.mIpAddress.Clear();
+      rawPacket.mData.Clear(false);
+    }
+  }
 
-    // Clear for next receive
-    rawPacket.mIpAddress.Clear();
-    rawPacket.mData.Clear(false);
+  //
+  // Push Raw Packets
+  //
+  if(validCount)
+  {
+    ThreadLock&       rawPacketsLock = (internetProtocol == InternetProtocol::V4) ? mIpv4RawPacketsLock : mIpv6RawPacketsLock;
+    Array<RawPacket>& rawPackets     = (internetProtocol == InternetProtocol::V4) ? mIpv4RawPackets     : mIpv6RawPackets;
+
+    { //<>-<>-<>-<>-< Raw Packets Locked >-<>-<>-<>-<>-
+      Lock lock(rawPacketsLock);
+
+      // Push all valid raw packets at once
+      for(size_t i = 0; i < validCount; ++i)
+        rawPackets.PushBack(ZeroMove(mReceiveBatch[i]));
+
+    } //-<>-<>-<>-<>-< Raw Packets Unlocked >-<>-<>-<>-<>
   }
 
+  //
+  // Release Unused Raw Packets
+  //
+  { //<>-<>-<>-<>-< Raw Packet Pool Locked >-<>-<>-<>-<>-
+    Lock lock(mRawPacketPoolLock);
+
+    // (Invalid raw packets and any the socket did not receive into)
+    for(size_t i = validCount; i < mReceiveBatch.Size() && mRawPacketPool.Size() < MaxPooledRawPackets; ++i)
+      mRawPacketPool.PushBack(ZeroMove(mReceiveBatch[i]));
+
+  } //-<>-<>-<>-<>-< Raw Packet Pool Unlocked >-<>-<>-<>-<>
+  mReceiveBatch.Clear();
+
   // Success
-  return 0;
+  return;
 }
 catch(const std::exception& error)
 {
@@ -994,10 +1038,29 @@ catch(const std::exception& error)
 catch(...)
 {
   // [Peer Event]
-  PeerEventFatalError("Unknown IPv6 receive thread error");
+  PeerEventFatalError("Unknown receive error");
 }
   // Failure
-  return 1;
+  mReceiveBatch.Clear();
+}
+void Peer::RecycleRawPackets(Array<RawPacket>& rawPackets)
+{
+  // Clear for reuse (keeping data buffers)
+  forRange(RawPacket& rawPacket, rawPackets.All())
+  {
+    rawPacket.mIpAddress.Clear();
+    rawPacket.mData.Clear(false);
+  }
+
+  { //<>-<>-<>-<>-< Raw Packet Pool Locked >-<>-<>-<>-<>-
+    Lock lock(mRawPacketPoolLock);
+
+    // Return to pool
+    for(uint i = 0; i < rawPackets.Size() && mRawPacketPool.Size() < MaxPooledRawPackets; ++i)
+      mRawPacketPool.PushBack(ZeroMove(rawPackets[i]));
+
+  } //-<>-<>-<>-<>-< Raw Packet Pool Unlocked >-<>-<>-<>-<>
+  rawPackets.Clear();
 }
 
 void Peer::UpdatePeerState()
@@ -1252,7 +1315,9 @@ void Peer::TranslateRawPackets(Array<RawPacket>& rawPackets, Array<InPacket>& in
     if(rawPacket.mData.Read(inPacket)) // Successful?
       inPackets.PushBack(ZeroMove(inPacket));
   }
-  rawPackets.Clear();
+
+  // Reuse raw packets for future receives
+  RecycleRawPackets(rawPackets);
 }
 
 bool Peer::PluginEventOnPacketSend(OutPacket& packet)
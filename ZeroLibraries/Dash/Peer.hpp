@@ -228,12 +228,17 @@ public:
   /// (Exclusively used by the Peer's send thread)
   TimeMs UpdateAndGetSendTime();
   /// Updates and returns the current packet receive time
-  /// (Exclusively used by the Peer's receive thread)
+  /// (Exclusively used by the peer reactor thread)
   TimeMs UpdateAndGetReceiveTime();
 
   /// Sends an outgoing packet to the network
-  /// Returns true if successful, else false
+  /// During update packets are queued and sent in batches at the end of the update
+  /// Returns true if successful (or queued), else false
   bool SendPacket(OutPacket& outPacket);
+  /// Sends all outgoing packets queued during update
+  void FlushSendQueue();
+  /// Sends the queued packets destined for the specified socket
+  void FlushSendQueue(Socket& socket);
 
   /// Updates packet send statistics
   void UpdateSendStats(Bytes sentPacketBytes);
@@ -243,10 +248,16 @@ public:
   /// Returns true if the provided raw packet is valid for our protocol, else false
   static bool IsValidRawPacket(RawPacket& rawPacket);
 
-  /// Receives incoming IPv4 packets from the network
-  OsInt Ipv4ReceiveThreadFn();
-  /// Receives incoming IPv6 packets from the network
-  OsInt Ipv6ReceiveThreadFn();
+  /// Points the datagrams at pooled raw packet data buffers to be received into
+  /// (Exclusively used by the peer reactor thread)
+  void PrepareReceiveBatch(SocketDatagram* datagrams, size_t datagramCount);
+
+  /// Takes a batch of incoming datagrams received into the prepared raw packets
+  /// (Exclusively used by the peer reactor thread)
+  void ReceiveDatagrams(InternetProtocol::Enum internetProtocol, SocketDatagram* datagrams, size_t datagramCount);
+
+  /// Returns translated raw packets to the raw packet pool
+  void RecycleRawPackets(Array<RawPacket>& rawPackets);
 
   /// Processes incoming packets, updates peer and link state, and generates outgoing packets
   void UpdatePeerState();
@@ -293,10 +304,6 @@ public:
 
   /// Thread Data
   Atomic<bool>   mFatalError;            /// Fatal error occurred?
-  mutable Thread mIpv4ReceiveThread;     /// IPv4 socket receive thread
-  Atomic<bool>   mExitIpv4ReceiveThread; /// Exit IPv4 socket receive thread?
-  mutable Thread mIpv6ReceiveThread;     /// IPv6 socket receive thread
-  Atomic<bool>   mExitIpv6ReceiveThread; /// Exit IPv6 socket receive thread?
 
   /// State Data
   Timer  mLocalTimer;   /// Local update timer
@@ -310,6 +317,13 @@ public:
   Array<RawPacket>   mIpv6RawPackets;            /// Raw incoming IPv6 packets
   mutable ThreadLock mIpv6RawPacketsLock;        /// Raw incoming IPv6 packets thread lock
   BitStream          mSendBitStream;             /// Reusable outgoing packet bitstream
+  Array<RawPacket>   mReceiveBatch;              /// Raw incoming packets being received (exclusively used by the reactor thread)
+  Array<RawPacket>   mRawPacketPool;             /// Reusable raw incoming packets (keeps their data buffers)
+  mutable ThreadLock mRawPacketPoolLock;         /// Reusable raw incoming packets thread lock
+  bool               mBatchSends;                /// Queue outgoing packets instead of sending immediately?
+  Array<RawPacket>   mSendQueue;                 /// Queued outgoing packets (entries past the count are reused)
+  uint               mSendQueueCount;            /// Number of queued outgoing packets
+  Array<SocketDatagram> mSendDatagrams;          /// Reusable outgoing datagram batch
   mutable ThreadLock mReceiveStatsLock;          /// Receive stats thread lock
   Array<InPacket>    mReleasedCustomPackets;     /// Released incoming user packets
   mutable ThreadLock mReleasedCustomPacketsLock; /// Released incoming user packets thread lock
@@ -349,6 +363,7 @@ private:
   /// Friends
   friend class PeerLink;
   friend class PeerPlugin;
+  friend class PeerReactor;
 };
 
 //---------------------------------------------------------------------------------//
@@ -0,0 +1,233 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file PeerReactor.cpp
+/// Shared thread receiving incoming datagrams for every open peer.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+
+namespace Zero
+{
+
+//---------------------------------------------------------------------------------//
+//                                 PeerReactor                                     //
+//---------------------------------------------------------------------------------//
+
+/// Shared reactor (created by the first registration, destroyed by the last unregistration)
+static PeerReactor* sReactor = nullptr;
+/// Shared reactor thread lock
+static ThreadLock   sReactorLock;
+
+/// Reactor statistics
+static Atomic<u64>  sReceiveCallCount;
+static Atomic<u64>  sReceivedDatagramCount;
+
+void PeerReactor::Register(Status& status, Peer* peer, Socket& socket, InternetProtocol::Enum internetProtocol)
+{
+//<>-<>-<>-<>-< Reactor Locked >-<>-<>-<>-<>-
+  Lock reactorLock(sReactorLock);
+
+  // The reactor drains sockets until they would block
+  socket.SetBlocking(status, false);
+  if(status.Failed()) // Unable?
+    return;
+
+  // Reactor not running?
+  if(!sReactor)
+  {
+    // Launch reactor thread
+    sReactor = new PeerReactor();
+    bool result = sReactor->mThread.Initialize(Thread::ObjectEntryCreator<PeerReactor, &PeerReactor::ReactorThreadFn>, sReactor, "PeerReactorThread");
+    if(!result) // Unable?
+    {
+      status.SetFailed("Unable to launch peer reactor thread");
+      SafeDelete(sReactor);
+      return;
+    }
+    sReactor->mThread.Resume();
+  }
+
+  // Create entry
+  Entry* entry = new Entry();
+  entry->mId               = sReactor->mNextEntryId++;
+  entry->mPeer             = peer;
+  entry->mSocket           = &socket;
+  entry->mInternetProtocol = internetProtocol;
+
+  { //<>-<>-<>-<>-< Entries Locked >-<>-<>-<>-<>-
+    Lock lock(sReactor->mEntriesLock);
+    sReactor->mEntries.PushBack(entry);
+  } //-<>-<>-<>-<>-< Entries Unlocked >-<>-<>-<>-<>
+
+  // Start waiting on socket
+  // (The poller outputs the entry ID, a freed entry's address may be reused by a later registration)
+  sReactor->mPoller.Add(status, socket, (void*)entry->mId);
+  if(status.Failed()) // Unable?
+  {
+    // Remove entry (the reactor lock is recursive)
+    Unregister(peer, socket);
+  }
+
+//-<>-<>-<>-<>-< Reactor Unlocked >-<>-<>-<>-<>
+}
+
+void PeerReactor::Unregister(Peer* peer, Socket& socket)
+{
+//<>-<>-<>-<>-< Reactor Locked >-<>-<>-<>-<>-
+  Lock reactorLock(sReactorLock);
+
+  // Reactor not running?
+  if(!sReactor)
+    return;
+
+  { //<>-<>-<>-<>-< Entries Locked >-<>-<>-<>-<>-
+    // (Waits for the reactor thread to finish receiving)
+    Lock lock(sReactor->mEntriesLock);
+
+    // Remove entry
+    for(uint i = 0; i < sReactor->mEntries.Size(); ++i)
+    {
+      Entry* entry = sReactor->mEntries[i];
+      if(entry->mPeer == peer && entry->mSocket == &socket)
+      {
+        Status status;
+        sReactor->mPoller.Remove(status, socket);
+
+        sReactor->mEntries.EraseAt(i);
+        delete entry;
+        break;
+      }
+    }
+
+    // Sockets still registered?
+    if(!sReactor->mEntries.Empty())
+      return;
+
+  } //-<>-<>-<>-<>-< Entries Unlocked >-<>-<>-<>-<>
+
+  // Close reactor thread
+  sReactor->mExitThread = true;
+  sReactor->mPoller.Wake();
+  sReactor->mThread.WaitForCompletion();
+  sReactor->mThread.Close();
+  SafeDelete(sReactor);
+
+//-<>-<>-<>-<>-< Reactor Unlocked >-<>-<>-<>-<>
+}
+
+u64 PeerReactor::GetReceiveCallCount()
+{
+  return sReceiveCallCount;
+}
+u64 PeerReactor::GetReceivedDatagramCount()
+{
+  return sReceivedDatagramCount;
+}
+
+PeerReactor::PeerReactor()
+  : mThread(),
+    mExitThread(false),
+    mPoller(),
+    mEntries(),
+    mEntriesLock(),
+    mNextEntryId(1)
+{
+}
+
+PeerReactor::~PeerReactor()
+{
+  Assert(mThread.IsCompleted());
+  Assert(mEntries.Empty());
+}
+
+PeerReactor::Entry* PeerReactor::FindEntry(size_t id) const
+{
+  forRange(Entry* entry, mEntries.All())
+    if(entry->mId == id)
+      return entry;
+
+  return nullptr;
+}
+
+void PeerReactor::ReceiveDatagrams(Entry* entry)
+{
+  for(uint batch = 0; batch < cMaxBatchesPerWake; ++batch)
+  {
+    // Point the batch at the peer's raw packet buffers so datagrams are received in place
+    entry->mPeer->PrepareReceiveBatch(mDatagrams, SocketBatchSize);
+
+    // Receive all immediately available datagrams (up to a full batch)
+    Status status;
+    size_t receivedCount = entry->mSocket->ReceiveFromBatch(status, mDatagrams, SocketBatchSize);
+    ++sReceiveCallCount;
+
+    // Let the peer process the batch (also returns the unused raw packets)
+    entry->mPeer->ReceiveDatagrams(entry->mInternetProtocol, mDatagrams, receivedCount);
+    if(receivedCount == 0) // Nothing received? (Would block or failed)
+      return;
+
+    // Update stats
+    sReceivedDatagramCount.FetchAdd(receivedCount);
+
+    // Clear for next receive
+    for(size_t i = 0; i < receivedCount; ++i)
+    {
+      mDatagrams[i].mAddress.Clear();
+      mDatagrams[i].mLength = 0;
+    }
+
+    // Socket drained?
+    if(receivedCount < SocketBatchSize)
+      return;
+  }
+
+  // More datagrams remain, the (level triggered) poller will report the socket again
+}
+
+OsInt PeerReactor::ReactorThreadFn()
+{
+  void* ready[SocketBatchSize];
+  bool waitFailed = false;
+  while(!mExitThread)
+  {
+    // Wait for incoming data on any registered socket
+    Status status;
+    size_t readyCount = mPoller.Wait(status, ready, SocketBatchSize, cWaitTimeoutMs);
+    if(status.Failed()) // Unable?
+    {
+      // Report once per run of failures
+      if(!waitFailed)
+        DebugPrint("Peer reactor failed to wait on sockets: %s", status.Message.c_str());
+      waitFailed = true;
+
+      // Back off instead of spinning on a persistent error
+      Os::Sleep(cWaitFailureBackoffMs);
+      continue;
+    }
+    waitFailed = false;
+
+    if(readyCount == 0) // Timed out or woken?
+      continue;
+
+    //<>-<>-<>-<>-< Entries Locked >-<>-<>-<>-<>-
+    Lock lock(mEntriesLock);
+
+    // Receive from every ready socket
+    for(size_t i = 0; i < readyCount; ++i)
+    {
+      // Unregistered while we were waiting?
+      Entry* entry = FindEntry((size_t)ready[i]);
+      if(!entry)
+        continue;
+
+      ReceiveDatagrams(entry);
+    }
+
+    //-<>-<>-<>-<>-< Entries Unlocked >-<>-<>-<>-<>
+  }
+
+  // Success
+  return 0;
+}
+
+} // namespace Zero
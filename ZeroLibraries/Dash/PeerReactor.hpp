@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file PeerReactor.hpp
+/// Shared thread receiving incoming datagrams for every open peer.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+namespace Zero
+{
+
+//---------------------------------------------------------------------------------//
+//                                 PeerReactor                                     //
+//---------------------------------------------------------------------------------//
+
+/// Receives incoming datagrams for every open peer on a single shared thread
+/// Waits on all peer sockets at once and receives datagrams in batches directly into the peer's pooled raw packets
+/// The reactor thread is started when the first socket is registered and stopped when the last is unregistered
+class PeerReactor
+{
+public:
+  /// Maximum number of batches received from one socket before servicing other sockets
+  static const uint cMaxBatchesPerWake = 16;
+  /// Wait timeout used to periodically check for shutdown
+  static const uint cWaitTimeoutMs = 500;
+  /// Time slept after a failed wait before waiting again
+  static const uint cWaitFailureBackoffMs = 100;
+
+  /// Registers the peer's open socket, the peer will receive all of the socket's incoming datagrams
+  /// The socket is set to non-blocking mode
+  static void Register(Status& status, Peer* peer, Socket& socket, InternetProtocol::Enum internetProtocol);
+
+  /// Unregisters the peer's socket
+  /// Once this returns the reactor thread will not call the peer for this socket again
+  static void Unregister(Peer* peer, Socket& socket);
+
+  /// Returns the number of receive system calls made by the reactor thread (since the process started)
+  static u64 GetReceiveCallCount();
+  /// Returns the number of datagrams received by the reactor thread (since the process started)
+  /// Compared against the receive call count this shows how well receives are being batched
+  static u64 GetReceivedDatagramCount();
+
+private:
+  /// Registered socket
+  struct Entry
+  {
+    size_t                 mId; /// Unique registration ID (never reused, given to the poller instead of the entry pointer)
+    Peer*                  mPeer;
+    Socket*                mSocket;
+    InternetProtocol::Enum mInternetProtocol;
+  };
+
+  /// Creates the reactor (does not start the thread)
+  PeerReactor();
+  /// Destroys the reactor (the thread must be stopped)
+  ~PeerReactor();
+
+  /// Returns the registered entry with the specified ID, else nullptr
+  Entry* FindEntry(size_t id) const;
+
+  /// Receives every datagram available on the registered socket (up to cMaxBatchesPerWake batches)
+  void ReceiveDatagrams(Entry* entry);
+
+  /// Waits on and receives from all registered sockets
+  OsInt ReactorThreadFn();
+
+  /// Thread Data
+  Thread         mThread;     /// Reactor thread
+  Atomic<bool>   mExitThread; /// Exit reactor thread?
+  SocketPoller   mPoller;     /// Waits on all registered sockets
+
+  /// Registration Data
+  Array<Entry*>      mEntries;     /// Registered sockets
+  mutable ThreadLock mEntriesLock; /// Registered sockets thread lock (held while receiving)
+  size_t             mNextEntryId; /// Next registration ID
+
+  /// Packet Data
+  SocketDatagram mDatagrams[SocketBatchSize]; /// Reusable receive batch (pointed at the peer's raw packet buffers)
+};
+
+} // namespace Zero
@@ -1937,6 +1937,8 @@ void Replicator::OnUpdate()
 
   // For all links
   PeerLinkSet links = GetLinks();
+  // Replicated bytes per link is ReplicatedBytes / ReplicatorLinks
+  ProfileGauge("Dash.ReplicatorLinks", links.Size());
   forRange(PeerLink* link, links.All())
   {
     // Get replicator link
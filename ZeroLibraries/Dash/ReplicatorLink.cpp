@@ -28,7 +28,8 @@ ReplicatorLink::ReplicatorLink(Replicator* replicator)
     mLastConnectResponseData(),
     mShouldSkipChangeReplication(false),
     mLastFrameFillSkipNotificationTime(0),
-    mLastFrameFillWarningNotificationTime(0)
+    mLastFrameFillWarningNotificationTime(0),
+    mReplicatedBytes(0)
 {
 }
 
@@ -187,6 +188,11 @@ bool ReplicatorLink::ShouldSkipChangeReplication() const
   return mShouldSkipChangeReplication;
 }
 
+Bytes ReplicatorLink::GetReplicatedBytes() const
+{
+  return mReplicatedBytes;
+}
+
 //
 // Internal
 //
@@ -443,6 +449,20 @@ void ReplicatorLink::SetReplicatorId(ReplicatorId replicatorId)
 // Replication Helpers
 //
 
+#if ZPROFILE_ENABLED
+/// One record shared by every send path (a ProfileCounter at each would register the name several times)
+Profile::CounterRecord gReplicatedBytesCounter("Dash.ReplicatedBytes");
+#endif
+
+void ReplicatorLink::CountReplicatedBytes(const Message& message)
+{
+  Bytes bytes = message.GetData().GetBytesWritten();
+  mReplicatedBytes += bytes;
+#if ZPROFILE_ENABLED
+  gReplicatedBytesCounter.AddLocal((s64)bytes);
+#endif
+}
+
 bool ReplicatorLink::SerializeSpawn(const ReplicaArray& replicas, Message& message, TimeMs timestamp)
 {
   Assert(GetReplicator()->GetRole() == Role::Server);
@@ -546,6 +566,7 @@ bool ReplicatorLink::SendSpawn(const ReplicaArray& replicas, TimeMs timestamp)
 
   // Send spawn message
   Assert(GetCommandChannelId());
+  CountReplicatedBytes(message);
   Status status;
   LinkPlugin::Send(status, ZeroMove(message), true, GetCommandChannelId());
   if(status.Failed()) // Unable?
@@ -702,6 +723,7 @@ bool ReplicatorLink::SendClone(const ReplicaArray& replicas, TimeMs timestamp)
 
   // Send clone message
   Assert(GetCommandChannelId());
+  CountReplicatedBytes(message);
   Status status;
   LinkPlugin::Send(status, ZeroMove(message), true, GetCommandChannelId());
   if(status.Failed()) // Unable?
@@ -1241,6 +1263,8 @@ bool ReplicatorLink::SendChange(ReplicaChannel* replicaChannel, Message& message
   }
 
   // Send change message
+  CountReplicatedBytes(message);
+  ProfileCounter("Dash.ReplicaChanges", 1);
   Status status;
   LinkPlugin::Send(status, message, (replicaChannelType->GetReliabilityMode() == ReliabilityMode::Reliable), channelId, false);
   if(status.Failed()) // Unable?
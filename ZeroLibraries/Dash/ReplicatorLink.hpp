@@ -81,6 +81,9 @@ public:
   /// Returns true if change replication should be skipped for this link
   bool ShouldSkipChangeReplication() const;
 
+  /// Returns the number of replication message bytes (spawns, clones and changes) sent over this link
+  Bytes GetReplicatedBytes() const;
+
   //
   // Internal
   //
@@ -132,6 +135,9 @@ public:
   // Replication Helpers
   //
 
+  /// Counts a replication message about to be sent for this link and the Dash.ReplicatedBytes profile counter
+  void CountReplicatedBytes(const Message& message);
+
   /// [Server] Serializes a spawn command
   /// Returns true if successful, else false
   bool SerializeSpawn(const ReplicaArray& replicas, Message& message, TimeMs timestamp);
@@ -315,6 +321,7 @@ public:
   bool                     mShouldSkipChangeReplication;          /// Should skip change replication? (Updated at the start of every frame)
   TimeMs                   mLastFrameFillSkipNotificationTime;    /// Last frame fill skip notification time
   TimeMs                   mLastFrameFillWarningNotificationTime; /// Last frame fill warning notification time
+  Bytes                    mReplicatedBytes;                      /// Replication message bytes sent
 
 private:
   /// No copy constructor
@@ -71,7 +71,8 @@ public:
   Vec4 mColor;
 };
 
-typedef Array<Vertex> DebugVertexArray;
+// Vertices are generated and consumed while extracting a frame
+typedef Array<Vertex, FrameAllocator> DebugVertexArray;
 
 class DebugViewData
 {
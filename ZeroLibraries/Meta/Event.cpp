@@ -8,6 +8,7 @@
 ///
 ///////////////////////////////////////////////////////////////////////////////
 #include "Precompiled.hpp"
+#include "Support/ProfileCounter.hpp"
 
 namespace Zero
 {
@@ -29,6 +30,68 @@ UseEventMemoryPool(EventDispatchList);
 UseEventMemoryPool(EventReceiver);
 UseEventMemoryPool(EventDispatcher);
 
+//------------------------------------------------------------------- Event Atom
+// Events are dispatched from any thread so the table is locked, but only when
+// a name is seen for the first time (after that the atom is read off the string).
+struct EventAtomTable
+{
+  EventAtomTable()
+  {
+    // Atom zero means the string hasn't been interned
+    mNames.PushBack(String());
+  }
+
+  static EventAtomTable& GetInstance()
+  {
+    static EventAtomTable table;
+    return table;
+  }
+
+  SpinLock mLock;
+  HashMap<String, EventAtom> mAtoms;
+  Array<String> mNames;
+};
+
+EventAtom GetEventAtom(StringParam eventId)
+{
+  StringNode* node = eventId.GetNode();
+  EventAtom atom = node->Atom;
+  if(atom != 0)
+    return atom;
+
+  EventAtomTable& table = EventAtomTable::GetInstance();
+  table.mLock.Lock();
+  atom = table.mAtoms.FindValue(eventId, 0);
+  if(atom == 0)
+  {
+    atom = (EventAtom)table.mNames.Size();
+    table.mNames.PushBack(eventId);
+    table.mAtoms.Insert(eventId, atom);
+  }
+  table.mLock.Unlock();
+
+  // The table holds a reference to the name so a pooled string keeps its atom,
+  // strings that aren't pooled will find it in the table again
+  node->Atom = atom;
+  return atom;
+}
+
+String GetEventName(EventAtom atom)
+{
+  EventAtomTable& table = EventAtomTable::GetInstance();
+  table.mLock.Lock();
+  String name = atom < table.mNames.Size() ? table.mNames[atom] : String();
+  table.mLock.Unlock();
+  return name;
+}
+
+String RegisterEventName(cstr eventId)
+{
+  String name(eventId);
+  GetEventAtom(name);
+  return name;
+}
+
 namespace Events
 {
   DefineEvent(ObjectDestroyed);
@@ -96,7 +159,8 @@ Object* ObjectEvent::GetSource()
 }
 
 //------------------------------------------------------------- Event Connection
-Array<Delegate> EventConnection::sDelayDestructDelegates;
+// Per thread as connections are destroyed on every thread that updates spaces
+ZeroThreadLocal Array<Delegate>* tDelayDestructDelegates = nullptr;
 
 EventConnection::EventConnection()
   :ThisObject(NULL),
@@ -165,9 +229,17 @@ void EventConnection::ConnectToReceiverAndDispatcher(
   receiver->Connect(this);
 }
 
+void EventConnection::AddDelayDestructDelegate(DelegateParam delegate)
+{
+  if(tDelayDestructDelegates == nullptr)
+    tDelayDestructDelegates = new Array<Delegate>();
+  tDelayDestructDelegates->PushBack(delegate);
+}
+
 void EventConnection::DelayDestructDelegates()
 {
-  sDelayDestructDelegates.Clear();
+  if(tDelayDestructDelegates != nullptr)
+    tDelayDestructDelegates->Clear();
 }
 
 //----------------------------------------------------------------- Event Signal
@@ -360,29 +432,30 @@ EventDispatcher::~EventDispatcher()
   EventConnection::DelayDestructDelegates();
 }
 
+EventDispatchList* EventDispatcher::FindList(EventAtom eventAtom)
+{
+  // Most objects have nothing connected to them
+  if(mEvents.Empty())
+    return nullptr;
+  return mEvents.FindValue(eventAtom, nullptr);
+}
+
 void EventDispatcher::DisconnectEvent(StringParam eventId, ObjPtr thisObject)
 {
-  EventMapType::range r = mEvents.Find(eventId);
-  if(!r.Empty())
-  {
-    r.Front().second->Disconnect(thisObject);
-  }
+  if(EventDispatchList* list = FindList(GetEventAtom(eventId)))
+    list->Disconnect(thisObject);
 }
 
 bool EventDispatcher::IsConnected(StringParam eventId, ObjPtr thisObject)
 {
-  EventMapType::range r = mEvents.Find(eventId);
-  if(!r.Empty())
-  {
-    return r.Front().second->IsConnected(thisObject);
-  }
+  if(EventDispatchList* list = FindList(GetEventAtom(eventId)))
+    return list->IsConnected(thisObject);
   return false;
 }
 
 bool EventDispatcher::IsAnyConnected(StringParam eventId)
 {
-  EventMapType::range r = mEvents.Find(eventId);
-  return !r.Empty();
+  return FindList(GetEventAtom(eventId)) != nullptr;
 }
 
 void EventDispatcher::Disconnect(ObjPtr thisObject)
@@ -405,19 +478,13 @@ void EventDispatcher::Dispatch(StringParam eventId, Event* event)
   if(event->mTerminated)
     return;
 
-  BoundType* sentEventType = ZilchVirtualTypeId(event);
-
-  // Validate that, if this event is bound, we're actually sending the proper event!
-  BoundType* boundEventType = MetaDatabase::GetInstance()->mEventMap.FindValue(eventId, nullptr);
-
-  if (CheckAllEventsBound)
-  {
-    // Comment this out if there are valid cases!
-    //ErrorIf(boundEventType == nullptr, "Attempting to dispatch an event that is not bound anywhere, we should bind this!");
-  }
+  ProfileCounter("Events.Dispatched", 1);
 
   if (CheckEventDispatchAsBoundType)
   {
+    // Validate that, if this event is bound, we're actually sending the proper event!
+    BoundType* sentEventType = ZilchVirtualTypeId(event);
+    BoundType* boundEventType = MetaDatabase::GetInstance()->mEventMap.FindValue(eventId, nullptr);
     if(boundEventType)
     {
       // The event type that we're sending should be either more derived or the same type
@@ -431,45 +498,45 @@ void EventDispatcher::Dispatch(StringParam eventId, Event* event)
     }
   }
 
+  EventDispatchList* list = FindList(GetEventAtom(eventId));
+  if(list == nullptr)
+    return;
+
+  // Events are usually sent again under the id they already have
+  // (dispatching down or up a hierarchy), only swap the id when it differs
+  if(event->EventId == eventId)
+  {
+    list->Dispatch(event);
+    return;
+  }
+
   // Store the event Id so we can restore it after
   String previousEventId = event->EventId;
 
   event->EventId = eventId;
 
-  EventMapType::range r = mEvents.Find(eventId);
-  if(!r.Empty())
-  {
-    //Object is listening to this signal.
-    //Signal all objects in the signal chain.
-    r.Front().second->Dispatch(event);
-  }
-  else
-  {
-    //do nothing
-  }
+  //Object is listening to this signal.
+  //Signal all objects in the signal chain.
+  list->Dispatch(event);
 
   event->EventId = previousEventId;
 }
 
 bool EventDispatcher::HasReceivers(StringParam eventId)
 {
-  return !mEvents.Find(eventId).Empty();
+  return FindList(GetEventAtom(eventId)) != nullptr;
 }
 
 void EventDispatcher::Connect(StringParam eventId, EventConnection* connection)
 {
   //Check to see if the signal has been mapped
-  EventMapType::range r = mEvents.Find(eventId);
-  EventDispatchList* list = nullptr;
-  if(!r.Empty())
-  {
-    list = r.Front().second;
-  }
-  else
+  EventAtom eventAtom = GetEventAtom(eventId);
+  EventDispatchList* list = FindList(eventAtom);
+  if(list == nullptr)
   {
     //Event with that eventId not yet mapped. Make a new list and map the event id
     list = new EventDispatchList();
-    mEvents.Insert(eventId, list);
+    mEvents.Insert(eventAtom, list);
   }
 
   //Bind the connection to the event list
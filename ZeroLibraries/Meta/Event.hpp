@@ -15,6 +15,19 @@ namespace Zero
 class EventReceiver;
 class EventDispatcher;
 
+//------------------------------------------------------------------- Event Atom
+///Event names are interned into small integers. Dispatchers are keyed by the
+///atom and the atom is cached on the pooled string, so dispatching with an
+///event name never hashes or compares the name. Zero is never assigned.
+typedef u32 EventAtom;
+
+///Returns the atom for the event name, interning it the first time it is seen.
+EventAtom GetEventAtom(StringParam eventId);
+///Returns the event name the atom was interned from.
+String GetEventName(EventAtom atom);
+///Interns the event name at startup (used by DefineEvent).
+String RegisterEventName(cstr eventId);
+
 //------------------------------------------------------------------------ Event
 
 ///Base event class. All events types inherit from this class.
@@ -107,9 +120,9 @@ public:
   /// Name identifier of the event, used by receiver since its connections aren't mapped
   String mEventId;
 
-  // Keeps handles alive until a safe time for destruction.
-  static Array<Delegate> sDelayDestructDelegates;
-  // Clears static array of delegates.
+  // Keeps handles alive until a safe time for destruction (kept per thread).
+  static void AddDelayDestructDelegate(DelegateParam delegate);
+  // Clears the calling thread's delayed delegates.
   static void DelayDestructDelegates();
 };
 
@@ -209,7 +222,9 @@ public:
   bool IsAnyConnected(StringParam eventId);
 
 private:
-  typedef HashMap<String, EventDispatchList*> EventMapType;
+  EventDispatchList* FindList(EventAtom eventAtom);
+
+  typedef HashMap<EventAtom, EventDispatchList*> EventMapType;
   EventMapType mEvents;
 };
 
@@ -256,7 +271,7 @@ inline void Connect(targetType* dispatcher, StringParam eventId,
 
 #define DeclareEvent(name) extern const String name
 
-#define DefineEvent(name) const String name = #name
+#define DefineEvent(name) const String name = RegisterEventName(#name)
 
 #define ConnectThisTo(target, eventname, handle) \
   do { Zero::Connect(target, eventname, this, &ZilchSelf::handle); } while (false)
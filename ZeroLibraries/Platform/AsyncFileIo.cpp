@@ -0,0 +1,319 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AsyncFileIo.cpp
+/// Implementation of the asynchronous file io service and the thread pool backend.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "AsyncFileIo.hpp"
+
+namespace Zero
+{
+
+// Blocking file io is mostly waiting, so the pool is not tied to the number of processors
+const uint cMinimumFileIoWorkers = 2;
+const uint cMaximumFileIoWorkers = 8;
+
+//----------------------------------------------------------- Async File Request
+AsyncFileRequest::AsyncFileRequest()
+{
+  Operation = AsyncFileOperation::Read;
+  Offset = 0;
+  ReadSize = 0;
+  OwnsData = false;
+  BytesTransferred = 0;
+  mBatch = nullptr;
+}
+
+AsyncFileRequest::~AsyncFileRequest()
+{
+  if(OwnsData)
+    zDeallocate(Data.Data);
+}
+
+DataBlock AsyncFileRequest::TakeData()
+{
+  DataBlock data = Data;
+  Data = DataBlock();
+  OwnsData = false;
+  return data;
+}
+
+//------------------------------------------------------------- Async File Batch
+AsyncFileBatch::AsyncFileBatch()
+{
+  mOwner = nullptr;
+  mCallback = nullptr;
+  mUserData = nullptr;
+  mCompleted = false;
+  // Manual reset so every waiter is released and later waits return immediately
+  mCompletedEvent.Initialize(true, false);
+}
+
+AsyncFileBatch::~AsyncFileBatch()
+{
+  ErrorIf(mOwner != nullptr && !IsCompleted(), "Async file batch destroyed before it completed.");
+  DeleteObjectsInContainer(Requests);
+}
+
+AsyncFileRequest* AsyncFileBatch::AddRead(StringParam filePath, u64 offset, size_t size)
+{
+  ErrorIf(mOwner != nullptr, "Requests cannot be added to a batch that has been submitted.");
+
+  AsyncFileRequest* request = new AsyncFileRequest();
+  request->Operation = AsyncFileOperation::Read;
+  request->FilePath = filePath;
+  request->Offset = offset;
+  request->ReadSize = size;
+  request->OwnsData = true;
+  request->mBatch = this;
+  Requests.PushBack(request);
+  return request;
+}
+
+AsyncFileRequest* AsyncFileBatch::AddWrite(StringParam filePath, DataBlock data, bool takeOwnership)
+{
+  ErrorIf(mOwner != nullptr, "Requests cannot be added to a batch that has been submitted.");
+
+  AsyncFileRequest* request = new AsyncFileRequest();
+  request->Operation = AsyncFileOperation::Write;
+  request->FilePath = filePath;
+  request->Data = data;
+  request->OwnsData = takeOwnership;
+  request->mBatch = this;
+  Requests.PushBack(request);
+  return request;
+}
+
+bool AsyncFileBatch::IsCompleted()
+{
+  return mCompleted.Load();
+}
+
+void AsyncFileBatch::Wait()
+{
+  ErrorIf(mOwner == nullptr, "Waiting on a batch that was never submitted.");
+  mCompletedEvent.Wait();
+
+  // The io thread signals just before it lets go of the batch
+  while(!mCompleted.Load())
+    Os::Sleep(0);
+}
+
+bool AsyncFileBatch::Succeeded()
+{
+  forRange(AsyncFileRequest* request, Requests.All())
+  {
+    if(request->Result.Failed())
+      return false;
+  }
+  return true;
+}
+
+void AsyncFileBatch::RequestCompleted()
+{
+  if(--mRemaining != 0)
+    return;
+
+  // The batch may be deleted as soon as completion is published or it is handed to the callback
+  AsyncFileIo* owner = mOwner;
+  CompletionCallback callback = mCallback;
+  void* userData = mUserData;
+
+  mCompletedEvent.Signal();
+  mCompleted.Store(true);
+  if(callback)
+    callback(this, userData);
+
+  // Counted last so shutting down the owner waits for the callback as well
+  --owner->mOutstandingBatches;
+}
+
+//------------------------------------------------------ Thread Pool File Backend
+/// Fallback backend, worker threads pull requests off of a queue and do blocking io.
+class ThreadPoolFileBackend : public AsyncFileBackend
+{
+public:
+  ThreadPoolFileBackend(uint workerCount);
+  ~ThreadPoolFileBackend();
+
+  cstr GetName() override { return "ThreadPool"; }
+  void Start(AsyncFileRequest* request) override;
+
+  OsInt WorkerThreadEntry();
+
+private:
+  ThreadLock mLock;
+  // Requests are taken from the front starting at mPendingStart
+  Array<AsyncFileRequest*> mPending;
+  uint mPendingStart;
+  Semaphore mPendingCount;
+  Array<Thread*> mWorkers;
+  volatile bool mShutdown;
+};
+
+ThreadPoolFileBackend::ThreadPoolFileBackend(uint workerCount)
+{
+  mPendingStart = 0;
+  mShutdown = false;
+
+  mWorkers.Resize(workerCount);
+  for(uint i = 0; i < workerCount; ++i)
+  {
+    mWorkers[i] = new Thread();
+    mWorkers[i]->Initialize(Thread::ObjectEntryCreator<ThreadPoolFileBackend, &ThreadPoolFileBackend::WorkerThreadEntry>,
+                            this, String::Format("FileIoWorker%u", i));
+    mWorkers[i]->Resume();
+  }
+}
+
+ThreadPoolFileBackend::~ThreadPoolFileBackend()
+{
+  mShutdown = true;
+
+  // Wake every worker without queuing any work
+  for(uint i = 0; i < mWorkers.Size(); ++i)
+    mPendingCount.Increment();
+
+  for(uint i = 0; i < mWorkers.Size(); ++i)
+    mWorkers[i]->WaitForCompletion();
+
+  DeleteObjectsInContainer(mWorkers);
+}
+
+void ThreadPoolFileBackend::Start(AsyncFileRequest* request)
+{
+  mLock.Lock();
+  mPending.PushBack(request);
+  mLock.Unlock();
+
+  mPendingCount.Increment();
+}
+
+OsInt ThreadPoolFileBackend::WorkerThreadEntry()
+{
+  for(;;)
+  {
+    mPendingCount.WaitAndDecrement();
+
+    AsyncFileRequest* request = nullptr;
+    mLock.Lock();
+    if(mPendingStart < mPending.Size())
+    {
+      request = mPending[mPendingStart++];
+      if(mPendingStart == mPending.Size())
+      {
+        mPending.Clear();
+        mPendingStart = 0;
+      }
+    }
+    mLock.Unlock();
+
+    // Outstanding requests are always finished before shutting down
+    if(request == nullptr)
+    {
+      if(mShutdown)
+        return 0;
+      continue;
+    }
+
+    AsyncFileIo::ExecuteBlocking(request);
+    AsyncFileIo::CompleteRequest(request);
+  }
+}
+
+//---------------------------------------------------------------- Async File Io
+AsyncFileIo::AsyncFileIo(uint workerCount)
+{
+  mBackend = CreatePlatformAsyncFileBackend();
+
+  if(mBackend == nullptr)
+  {
+    if(workerCount == 0)
+    {
+      workerCount = Os::GetProcessorCount();
+      if(workerCount < cMinimumFileIoWorkers)
+        workerCount = cMinimumFileIoWorkers;
+      if(workerCount > cMaximumFileIoWorkers)
+        workerCount = cMaximumFileIoWorkers;
+    }
+    mBackend = new ThreadPoolFileBackend(workerCount);
+  }
+}
+
+AsyncFileIo::~AsyncFileIo()
+{
+  while(mOutstandingBatches.Load() != 0)
+    Os::Sleep(1);
+
+  SafeDelete(mBackend);
+}
+
+void AsyncFileIo::Submit(AsyncFileBatch* batch, AsyncFileBatch::CompletionCallback callback, void* userData)
+{
+  ErrorIf(batch->mOwner != nullptr, "Async file batch was already submitted.");
+
+  batch->mOwner = this;
+  batch->mCallback = callback;
+  batch->mUserData = userData;
+  ++mOutstandingBatches;
+
+  // Hold an extra count so the batch can't complete while requests are still being started
+  batch->mRemaining.Store((s32)batch->Requests.Size() + 1);
+  forRange(AsyncFileRequest* request, batch->Requests.All())
+    mBackend->Start(request);
+  mBackend->Flush();
+
+  batch->RequestCompleted();
+}
+
+cstr AsyncFileIo::GetBackendName()
+{
+  return mBackend->GetName();
+}
+
+void AsyncFileIo::CompleteRequest(AsyncFileRequest* request)
+{
+  request->mBatch->RequestCompleted();
+}
+
+void AsyncFileIo::ExecuteBlocking(AsyncFileRequest* request)
+{
+  File file;
+  Status& status = request->Result;
+
+  if(request->Operation == AsyncFileOperation::Write)
+  {
+    if(!file.Open(request->FilePath, FileMode::Write, FileAccessPattern::Sequential, FileShare::Unspecified, &status))
+      return;
+
+    request->BytesTransferred = file.Write(request->Data.Data, request->Data.Size);
+    if(request->BytesTransferred != request->Data.Size)
+      status.SetFailed(String::Format("Failed to write file '%s'.", request->FilePath.c_str()));
+    return;
+  }
+
+  if(!file.Open(request->FilePath, FileMode::Read, FileAccessPattern::Sequential, FileShare::Unspecified, &status))
+    return;
+
+  u64 fileSize = (u64)file.Size();
+  if(request->Offset > fileSize)
+  {
+    status.SetFailed(String::Format("Read offset is past the end of file '%s'.", request->FilePath.c_str()));
+    return;
+  }
+
+  size_t size = (size_t)(fileSize - request->Offset);
+  if(request->ReadSize != 0 && request->ReadSize < size)
+    size = request->ReadSize;
+
+  if(request->Offset != 0)
+    file.Seek(request->Offset);
+
+  request->Data.Data = (byte*)zAllocate(size);
+  request->Data.Size = size;
+  request->OwnsData = true;
+  request->BytesTransferred = file.Read(status, request->Data.Data, size);
+}
+
+}//namespace Zero
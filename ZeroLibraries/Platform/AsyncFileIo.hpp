@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AsyncFileIo.hpp
+/// Declaration of the asynchronous file io service.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Thread.hpp"
+#include "ThreadSync.hpp"
+#include "File.hpp"
+
+namespace Zero
+{
+
+class AsyncFileBatch;
+class AsyncFileBackend;
+class AsyncFileIo;
+
+DeclareEnum2(AsyncFileOperation, Read, Write);
+
+//----------------------------------------------------------- Async File Request
+/// A single read or write of a file. Reads allocate Data (with zAllocate) to hold
+/// the bytes read, writes create or truncate the file and write all of Data.
+class ZeroShared AsyncFileRequest
+{
+public:
+  AsyncFileRequest();
+  ~AsyncFileRequest();
+
+  /// Takes ownership of the data (the caller must free it with zDeallocate).
+  DataBlock TakeData();
+
+  AsyncFileOperation::Enum Operation;
+  String FilePath;
+
+  /// Reads start at this offset in the file.
+  u64 Offset;
+  /// Number of bytes to read, zero reads to the end of the file.
+  size_t ReadSize;
+
+  /// Read: the bytes read. Write: the bytes to write.
+  DataBlock Data;
+  /// Whether the request frees Data when it is destroyed.
+  bool OwnsData;
+
+  /// Filled out once the request has completed.
+  Status Result;
+  size_t BytesTransferred;
+
+private:
+  friend class AsyncFileBatch;
+  friend class AsyncFileIo;
+  AsyncFileBatch* mBatch;
+};
+
+//------------------------------------------------------------- Async File Batch
+/// A group of requests submitted together. The batch completes once every one
+/// of its requests has completed, it can be polled or waited on like a future.
+class ZeroShared AsyncFileBatch
+{
+public:
+  /// Called on an io thread once every request has completed.
+  typedef void (*CompletionCallback)(AsyncFileBatch* batch, void* userData);
+
+  AsyncFileBatch();
+  ~AsyncFileBatch();
+
+  /// Reads size bytes starting at offset (zero size reads to the end of the file).
+  AsyncFileRequest* AddRead(StringParam filePath, u64 offset = 0, size_t size = 0);
+  /// Writes the data to the file. If the batch takes ownership the data is
+  /// freed with zDeallocate when the batch is destroyed.
+  AsyncFileRequest* AddWrite(StringParam filePath, DataBlock data, bool takeOwnership);
+
+  /// Have all requests completed? Safe to call from any thread.
+  bool IsCompleted();
+  /// Blocks the calling thread until every request has completed.
+  void Wait();
+  /// Did every request succeed? Only valid once completed.
+  bool Succeeded();
+
+  Array<AsyncFileRequest*> Requests;
+
+private:
+  friend class AsyncFileIo;
+  void RequestCompleted();
+
+  AsyncFileIo* mOwner;
+  Atomic<s32> mRemaining;
+  OsEvent mCompletedEvent;
+  /// Stored after the event is signaled, once it is set the io thread no longer
+  /// touches the batch (unless it has a callback, which then owns the batch)
+  Atomic<bool> mCompleted;
+  CompletionCallback mCallback;
+  void* mUserData;
+};
+
+//---------------------------------------------------------------- Async File Io
+/// Runs file reads and writes off of the calling thread. Uses io_uring on Linux
+/// when the kernel supports it and otherwise falls back to a pool of threads
+/// doing blocking file io.
+class ZeroShared AsyncFileIo
+{
+public:
+  /// A worker count of zero picks a count based on the number of processors.
+  AsyncFileIo(uint workerCount = 0);
+  /// Waits for all outstanding requests to complete.
+  ~AsyncFileIo();
+
+  /// Starts every request in the batch. Once all of them have completed the batch
+  /// is marked completed and then the callback (if any) is called on an io thread.
+  /// A batch with a callback belongs to the callback from then on, otherwise the
+  /// batch must be kept alive until it has completed.
+  void Submit(AsyncFileBatch* batch, AsyncFileBatch::CompletionCallback callback = nullptr, void* userData = nullptr);
+
+  /// Name of the backend in use (for diagnostics).
+  cstr GetBackendName();
+
+  /// Called by backends when a request has finished (from any thread).
+  static void CompleteRequest(AsyncFileRequest* request);
+
+  /// Performs the request with blocking file io on the calling thread.
+  static void ExecuteBlocking(AsyncFileRequest* request);
+
+private:
+  friend class AsyncFileBatch;
+  AsyncFileBackend* mBackend;
+  // Batches that have been submitted but not completed
+  Atomic<s32> mOutstandingBatches;
+};
+
+//------------------------------------------------------------ Async File Backend
+class AsyncFileBackend
+{
+public:
+  virtual ~AsyncFileBackend() {}
+  virtual cstr GetName() = 0;
+  /// Starts the request, AsyncFileIo::CompleteRequest must be called once it is done.
+  virtual void Start(AsyncFileRequest* request) = 0;
+  /// Called once every request of a batch has been started, backends that
+  /// queue requests instead of starting them right away submit them here.
+  virtual void Flush() {}
+};
+
+/// Creates the platform specific backend, returns null if the platform has none
+/// (or it is not supported by the running system).
+AsyncFileBackend* CreatePlatformAsyncFileBackend();
+
+}//namespace Zero
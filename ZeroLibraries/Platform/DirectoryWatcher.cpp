@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// Authors: Chris Peters, Joshua Claeys
+/// Copyright 2010-2015, DigiPen Institute of Technology
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "DirectoryWatcher.hpp"
+
+namespace Zero
+{
+
+//******************************************************************************
+DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, CallbackFunction callback, void* callbackInstance)
+{
+  mCallback = callback;
+  mBatchCallback = nullptr;
+  Initialize(directoryToWatch, callbackInstance);
+}
+
+//******************************************************************************
+DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, BatchCallbackFunction batchCallback, void* callbackInstance)
+{
+  mCallback = nullptr;
+  mBatchCallback = batchCallback;
+  Initialize(directoryToWatch, callbackInstance);
+}
+
+//******************************************************************************
+DirectoryWatcher::~DirectoryWatcher()
+{
+  Shutdown();
+}
+
+//******************************************************************************
+void DirectoryWatcher::Initialize(cstr directoryToWatch, void* callbackInstance)
+{
+  ZeroCStringCopy(mDirectoryToWatch, File::MaxPath, directoryToWatch, strlen(directoryToWatch));
+
+  mCallbackInstance = callbackInstance;
+  mShutdown = false;
+
+  // The cancel event must exist before the thread can wait on it
+  mCancelEvent.Initialize(true, false);
+  mWorkThread.Initialize(Thread::ObjectEntryCreator<DirectoryWatcher, &DirectoryWatcher::RunThreadEntryPoint>, this, "DirectoryWatcherWorker");
+  mWorkThread.Resume();
+}
+
+//******************************************************************************
+void DirectoryWatcher::Shutdown()
+{
+  mShutdown = true;
+  mCancelEvent.Signal();
+  mWorkThread.WaitForCompletion();
+}
+
+//******************************************************************************
+void DirectoryWatcher::DispatchOperations(Array<FileOperationInfo>& operations)
+{
+  if(operations.Empty())
+    return;
+
+  if(mBatchCallback)
+  {
+    (*mBatchCallback)(mCallbackInstance, operations);
+    return;
+  }
+
+  forRange(FileOperationInfo& info, operations.All())
+    (*mCallback)(mCallbackInstance, info);
+}
+
+//******************************************************************************
+void DirectoryWatcher::CoalesceOperations(Array<FileOperationInfo>& operations)
+{
+  // Index of the net operation for each file name in the results
+  HashMap<String, uint> fileToResult;
+  Array<FileOperationInfo> results;
+  // Entries that cancelled out (added then removed) are flagged and dropped at the end
+  Array<bool> dropped;
+
+  forRange(FileOperationInfo& info, operations.All())
+  {
+    // A rename out of a file that was added in this change set is just an add of the new name
+    if(info.Operation == Renamed)
+    {
+      uint* oldIndex = fileToResult.FindPointer(info.OldFileName);
+      if(oldIndex != nullptr && !dropped[*oldIndex])
+      {
+        FileOperationInfo& previous = results[*oldIndex];
+        dropped[*oldIndex] = true;
+        fileToResult.Erase(info.OldFileName);
+
+        FileOperationInfo renamed = info;
+        if(previous.Operation == Added)
+        {
+          renamed.Operation = Added;
+          renamed.OldFileName = String();
+        }
+        else if(previous.Operation == Renamed)
+        {
+          // Chained renames keep the original name
+          renamed.OldFileName = previous.OldFileName;
+        }
+
+        fileToResult[renamed.FileName] = results.Size();
+        results.PushBack(renamed);
+        dropped.PushBack(false);
+        continue;
+      }
+    }
+
+    uint* index = fileToResult.FindPointer(info.FileName);
+    if(index == nullptr || dropped[*index])
+    {
+      fileToResult[info.FileName] = results.Size();
+      results.PushBack(info);
+      dropped.PushBack(false);
+      continue;
+    }
+
+    FileOperationInfo& previous = results[*index];
+    switch(info.Operation)
+    {
+      case Added:
+        // Deleted then recreated (common for atomic saves) is a modification
+        if(previous.Operation == Removed)
+          previous.Operation = Modified;
+        break;
+
+      case Modified:
+        // Added or renamed already implies the contents changed
+        break;
+
+      case Removed:
+        if(previous.Operation == Added)
+        {
+          dropped[*index] = true;
+        }
+        else if(previous.Operation == Renamed)
+        {
+          // The renamed file is gone, what is left is the removal of its original name
+          uint resultIndex = *index;
+          String oldFileName = previous.OldFileName;
+          fileToResult.Erase(info.FileName);
+
+          // Unless the original name was added again in between, then that file replaced it
+          uint* oldIndex = fileToResult.FindPointer(oldFileName);
+          if(oldIndex != nullptr && !dropped[*oldIndex] && results[*oldIndex].Operation == Added)
+          {
+            results[*oldIndex].Operation = Modified;
+            dropped[resultIndex] = true;
+            break;
+          }
+
+          previous.Operation = Removed;
+          previous.FileName = oldFileName;
+          previous.OldFileName = String();
+          fileToResult[oldFileName] = resultIndex;
+        }
+        else
+        {
+          previous.Operation = Removed;
+        }
+        break;
+
+      case Renamed:
+        previous = info;
+        break;
+    }
+  }
+
+  operations.Clear();
+  for(uint i = 0; i < results.Size(); ++i)
+  {
+    if(!dropped[i])
+      operations.PushBack(results[i]);
+  }
+}
+
+}//namespace Zero
@@ -34,8 +34,16 @@ public:
   };
 
   typedef OsInt (*CallbackFunction)(void* callbackInstance, FileOperationInfo& info);
+  // Receives all the operations of one change set at once. Bursts of changes
+  // (such as an editor save or a source control update) are coalesced so each
+  // file appears once with its net operation.
+  typedef OsInt (*BatchCallbackFunction)(void* callbackInstance, Array<FileOperationInfo>& operations);
+
+  // How long the watcher waits for more changes before reporting a change set.
+  static const uint cCoalesceIntervalMs = 100;
 
   DirectoryWatcher(cstr directoryToWatch, CallbackFunction callback, void* callbackInstance);
+  DirectoryWatcher(cstr directoryToWatch, BatchCallbackFunction batchCallback, void* callbackInstance);
   ~DirectoryWatcher();
   void Shutdown();
 
@@ -47,15 +55,34 @@ public:
     return returnValue;
   }
 
+  template<typename classType, OsInt (classType::*MemberFunction)(Array<FileOperationInfo>& operations)>
+  static OsInt BatchCallBackCreator(void* objectInstance, Array<FileOperationInfo>& operations)
+  {
+    classType* object = (classType*)objectInstance;
+    OsInt returnValue = (object->*MemberFunction)(operations);
+    return returnValue;
+  }
+
+  // Merges operations on the same file so only the net change remains
+  // (e.g. added then modified is added, added then removed is dropped).
+  static void CoalesceOperations(Array<FileOperationInfo>& operations);
+
 private:
+  void Initialize(cstr directoryToWatch, void* callbackInstance);
+  // Sends a change set to the batch callback or to the per file callback.
+  void DispatchOperations(Array<FileOperationInfo>& operations);
+
   // Note: The directory watcher currently has no private data
   // because it stores everything on the stack of its thread
   char mDirectoryToWatch[File::MaxPath];
   CallbackFunction mCallback;
+  BatchCallbackFunction mBatchCallback;
   void* mCallbackInstance;
   OsInt RunThreadEntryPoint();
   Thread mWorkThread;
   OsEvent mCancelEvent;
+  // Set when shutting down for platforms that poll instead of waiting on the cancel event
+  volatile bool mShutdown;
 };
 
 }//namespace Zero
@@ -13,17 +13,10 @@
 namespace Zero
 {
 
-DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, CallbackFunction callback, void* callbackInstance)
+OsInt DirectoryWatcher::RunThreadEntryPoint()
 {
   Error("Not implemented");
-}
-
-DirectoryWatcher::~DirectoryWatcher()
-{
-}
-
-void DirectoryWatcher::Shutdown()
-{
+  return 0;
 }
 
 }//namespace Zero
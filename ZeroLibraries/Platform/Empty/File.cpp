@@ -107,4 +107,44 @@ void File::Flush()
   ZeroGetPrivateData(FilePrivateData);
 }
 
+//----------------------------------------------------------- Mapped File
+struct MappedFilePrivateData
+{
+};
+
+MappedFile::MappedFile()
+{
+  ZeroConstructPrivateData(MappedFilePrivateData);
+}
+
+MappedFile::~MappedFile()
+{
+  ZeroDestructPrivateData(MappedFilePrivateData);
+}
+
+bool MappedFile::Open(Status& status, StringParam filePath, FileAccessPattern::Enum accessPattern)
+{
+  status.SetFailed("Not implemented");
+  return false;
+}
+
+void MappedFile::Close()
+{
+}
+
+bool MappedFile::IsOpen()
+{
+  return false;
+}
+
+DataBlock MappedFile::GetBlock()
+{
+  return DataBlock();
+}
+
+size_t MappedFile::Size()
+{
+  return 0;
+}
+
 }//namespace Zero
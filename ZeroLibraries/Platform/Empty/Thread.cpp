@@ -82,4 +82,10 @@ OsHandle Thread::GetThreadHandle()
   return NULL;
 }
 
+bool Thread::SetProcessorAffinity(u64 processorMask)
+{
+  ZeroGetPrivateData(Thread);
+  return false;
+}
+
 }//namespace Zero
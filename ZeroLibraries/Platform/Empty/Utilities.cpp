@@ -27,6 +27,11 @@ void SetTimerFrequency(uint ms)
   Error("Not implemented");
 }
 
+uint GetProcessorCount()
+{
+  return 1;
+}
+
 String UserName()
 {
   return "User";
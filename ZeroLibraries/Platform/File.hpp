@@ -108,6 +108,32 @@ private:
   FileMode::Enum mFileMode;
 };
 
+//------------------------------------------------------------------ Mapped File
+/// Read only memory mapping of an entire file. The block returned by GetBlock
+/// points directly at the mapped pages (no copy is made), so it must never be
+/// freed and is only valid until the mapped file is closed or destroyed.
+class ZeroShared MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+  /// Maps the whole file for reading. Opening an empty file succeeds with an empty block.
+  bool Open(Status& status, StringParam filePath, FileAccessPattern::Enum accessPattern = FileAccessPattern::Sequential);
+
+  /// Unmaps the file, any blocks previously returned are no longer valid
+  void Close();
+
+  bool IsOpen();
+
+  /// The mapped contents of the file (read only)
+  DataBlock GetBlock();
+  size_t Size();
+
+private:
+  ZeroDeclarePrivateData(MappedFile, 32);
+};
+
 class FileStream : public Stream
 {
 public:
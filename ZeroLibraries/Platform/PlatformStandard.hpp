@@ -51,4 +51,5 @@ public:
 #include "Timer.hpp"
 #include "TimerBlock.hpp"
 #include "DirectoryWatcher.hpp"
+#include "AsyncFileIo.hpp"
 #include "ConsoleListeners.hpp"
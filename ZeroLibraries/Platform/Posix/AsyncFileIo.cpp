@@ -0,0 +1,478 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AsyncFileIo.cpp
+/// io_uring backend for the asynchronous file io service.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Platform/AsyncFileIo.hpp"
+
+#if defined(__linux__)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+namespace Zero
+{
+
+#if defined(__linux__)
+
+// Number of submission queue entries (the completion queue gets twice as many)
+const uint cRingEntries = 256;
+
+// Completion posted on shutdown to wake the completion thread
+const u64 cShutdownUserData = 0;
+
+//---------------------------------------------------------------- Uring Operation
+/// State of a request while it is in flight. Reads and writes may complete
+/// partially in which case the remaining range is resubmitted.
+struct UringOperation
+{
+  AsyncFileRequest* mRequest;
+  int mFd;
+  // The remaining range of the buffer and where it goes in the file
+  iovec mVector;
+  u64 mOffset;
+  // Whether the kernel currently owns the operation
+  bool mSubmitted;
+};
+
+//------------------------------------------------------------ Uring File Backend
+/// Submits requests to an io_uring instance (raw syscalls, no liburing dependency)
+/// and reaps the completions on a dedicated thread. Files are opened on the
+/// submitting thread, all reads and writes are done by the kernel. The requests
+/// of a batch are queued and handed to the kernel with a single system call.
+class UringFileBackend : public AsyncFileBackend
+{
+public:
+  UringFileBackend();
+  ~UringFileBackend();
+
+  /// Returns false if io_uring is not supported by the running kernel.
+  bool Initialize();
+
+  cstr GetName() override { return "io_uring"; }
+  void Start(AsyncFileRequest* request) override;
+  void Flush() override;
+
+  OsInt CompletionThreadEntry();
+
+private:
+  /// Queues the operation or defers it if the completion queue could overflow (lock must be held).
+  void Queue(UringOperation* operation);
+  /// Writes the submission entry, it is not seen by the kernel until SubmitQueued (lock must be held).
+  void QueueEntry(u8 opcode, int fd, void* address, u32 length, u64 offset, u64 userData);
+  /// Enters the ring once for every queued submission entry (lock must be held).
+  void SubmitQueued();
+  void HandleCompletion(UringOperation* operation, int result);
+  void Finish(UringOperation* operation);
+  void UnmapRings();
+
+  int mRingFd;
+
+  void* mSqRing;
+  size_t mSqRingSize;
+  void* mCqRing;
+  size_t mCqRingSize;
+  io_uring_sqe* mSqes;
+  size_t mSqesSize;
+
+  unsigned* mSqHead;
+  unsigned* mSqTail;
+  unsigned* mSqArray;
+  unsigned mSqMask;
+  unsigned mSqEntries;
+
+  unsigned* mCqHead;
+  unsigned* mCqTail;
+  io_uring_cqe* mCqes;
+  unsigned mCqMask;
+  unsigned mCqEntries;
+
+  ThreadLock mLock;
+  // Submission entries written since the ring was last entered
+  unsigned mQueuedEntries;
+  // Operations owned by the kernel, kept below the completion queue size
+  uint mInFlight;
+  // Operations waiting for room in the completion queue
+  Array<UringOperation*> mDeferred;
+  Thread mCompletionThread;
+};
+
+UringFileBackend::UringFileBackend()
+{
+  mRingFd = -1;
+  mSqRing = MAP_FAILED;
+  mSqRingSize = 0;
+  mCqRing = MAP_FAILED;
+  mCqRingSize = 0;
+  mSqes = (io_uring_sqe*)MAP_FAILED;
+  mSqesSize = 0;
+  mQueuedEntries = 0;
+  mInFlight = 0;
+}
+
+UringFileBackend::~UringFileBackend()
+{
+  if(mCompletionThread.IsValid())
+  {
+    mLock.Lock();
+    QueueEntry(IORING_OP_NOP, -1, nullptr, 0, 0, cShutdownUserData);
+    SubmitQueued();
+    mLock.Unlock();
+    mCompletionThread.WaitForCompletion();
+  }
+
+  UnmapRings();
+  if(mRingFd != -1)
+    close(mRingFd);
+}
+
+bool UringFileBackend::Initialize()
+{
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+
+  mRingFd = (int)syscall(__NR_io_uring_setup, cRingEntries, &params);
+  if(mRingFd < 0)
+  {
+    // Not supported by the kernel or blocked (common in containers)
+    mRingFd = -1;
+    return false;
+  }
+
+  mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+  // Newer kernels share one mapping for both rings
+  bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if(singleMapping)
+  {
+    if(mCqRingSize > mSqRingSize)
+      mSqRingSize = mCqRingSize;
+    mCqRingSize = mSqRingSize;
+  }
+
+  mSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQ_RING);
+  if(mSqRing == MAP_FAILED)
+  {
+    UnmapRings();
+    return false;
+  }
+
+  if(singleMapping)
+  {
+    mCqRing = mSqRing;
+  }
+  else
+  {
+    mCqRing = mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_CQ_RING);
+    if(mCqRing == MAP_FAILED)
+    {
+      UnmapRings();
+      return false;
+    }
+  }
+
+  mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  mSqes = (io_uring_sqe*)mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mRingFd, IORING_OFF_SQES);
+  if(mSqes == MAP_FAILED)
+  {
+    UnmapRings();
+    return false;
+  }
+
+  byte* sqRing = (byte*)mSqRing;
+  mSqHead = (unsigned*)(sqRing + params.sq_off.head);
+  mSqTail = (unsigned*)(sqRing + params.sq_off.tail);
+  mSqArray = (unsigned*)(sqRing + params.sq_off.array);
+  mSqMask = *(unsigned*)(sqRing + params.sq_off.ring_mask);
+  mSqEntries = params.sq_entries;
+
+  byte* cqRing = (byte*)mCqRing;
+  mCqHead = (unsigned*)(cqRing + params.cq_off.head);
+  mCqTail = (unsigned*)(cqRing + params.cq_off.tail);
+  mCqes = (io_uring_cqe*)(cqRing + params.cq_off.cqes);
+  mCqMask = *(unsigned*)(cqRing + params.cq_off.ring_mask);
+  mCqEntries = params.cq_entries;
+
+  mCompletionThread.Initialize(Thread::ObjectEntryCreator<UringFileBackend, &UringFileBackend::CompletionThreadEntry>,
+                               this, "FileIoCompletion");
+  mCompletionThread.Resume();
+  return true;
+}
+
+void UringFileBackend::UnmapRings()
+{
+  if(mSqes != MAP_FAILED)
+    munmap(mSqes, mSqesSize);
+  if(mCqRing != MAP_FAILED && mCqRing != mSqRing)
+    munmap(mCqRing, mCqRingSize);
+  if(mSqRing != MAP_FAILED)
+    munmap(mSqRing, mSqRingSize);
+
+  mSqes = (io_uring_sqe*)MAP_FAILED;
+  mCqRing = MAP_FAILED;
+  mSqRing = MAP_FAILED;
+}
+
+void UringFileBackend::Start(AsyncFileRequest* request)
+{
+  Status& status = request->Result;
+  bool isRead = request->Operation == AsyncFileOperation::Read;
+
+  int fd;
+  if(isRead)
+    fd = open(request->FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+  else
+    fd = open(request->FilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+
+  if(fd == -1)
+  {
+    status.SetFailed(String::Format("Failed to open file '%s'.", request->FilePath.c_str()), errno);
+    AsyncFileIo::CompleteRequest(request);
+    return;
+  }
+
+  UringOperation* operation = new UringOperation();
+  operation->mRequest = request;
+  operation->mFd = fd;
+  operation->mOffset = 0;
+  operation->mSubmitted = false;
+
+  if(isRead)
+  {
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+      status.SetFailed(String::Format("Failed to get the size of file '%s'.", request->FilePath.c_str()), errno);
+      Finish(operation);
+      return;
+    }
+
+    u64 fileSize = (u64)st.st_size;
+    if(request->Offset > fileSize)
+    {
+      status.SetFailed(String::Format("Read offset is past the end of file '%s'.", request->FilePath.c_str()));
+      Finish(operation);
+      return;
+    }
+
+    size_t size = (size_t)(fileSize - request->Offset);
+    if(request->ReadSize != 0 && request->ReadSize < size)
+      size = request->ReadSize;
+
+    request->Data.Data = (byte*)zAllocate(size);
+    request->Data.Size = size;
+    request->OwnsData = true;
+    operation->mOffset = request->Offset;
+  }
+
+  operation->mVector.iov_base = request->Data.Data;
+  operation->mVector.iov_len = request->Data.Size;
+
+  // Nothing for the kernel to do
+  if(operation->mVector.iov_len == 0)
+  {
+    Finish(operation);
+    return;
+  }
+
+  // Submitted along with the rest of the batch in Flush
+  mLock.Lock();
+  Queue(operation);
+  mLock.Unlock();
+}
+
+void UringFileBackend::Flush()
+{
+  mLock.Lock();
+  SubmitQueued();
+  mLock.Unlock();
+}
+
+void UringFileBackend::Queue(UringOperation* operation)
+{
+  // Keeping in flight operations below the completion queue size means completions are never dropped
+  if(mInFlight >= mCqEntries)
+  {
+    mDeferred.PushBack(operation);
+    return;
+  }
+
+  ++mInFlight;
+  operation->mSubmitted = true;
+  u8 opcode = operation->mRequest->Operation == AsyncFileOperation::Read ? IORING_OP_READV : IORING_OP_WRITEV;
+  QueueEntry(opcode, operation->mFd, &operation->mVector, 1, operation->mOffset, (u64)operation);
+}
+
+void UringFileBackend::QueueEntry(u8 opcode, int fd, void* address, u32 length, u64 offset, u64 userData)
+{
+  // Batches can be larger than the submission queue, hand what is queued to the kernel to make room
+  // (without a polling thread the kernel consumes the entries during the enter call)
+  if(*mSqTail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE) >= mSqEntries)
+    SubmitQueued();
+
+  unsigned tail = *mSqTail;
+  ErrorIf(tail - __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE) >= mSqEntries, "io_uring submission queue is full.");
+
+  unsigned index = tail & mSqMask;
+  io_uring_sqe* entry = &mSqes[index];
+  memset(entry, 0, sizeof(io_uring_sqe));
+  entry->opcode = opcode;
+  entry->fd = fd;
+  entry->addr = (u64)address;
+  entry->len = length;
+  entry->off = offset;
+  entry->user_data = userData;
+
+  mSqArray[index] = index;
+  // The entry must be visible to the kernel before the new tail is
+  __atomic_store_n(mSqTail, tail + 1, __ATOMIC_RELEASE);
+  ++mQueuedEntries;
+}
+
+void UringFileBackend::SubmitQueued()
+{
+  while(mQueuedEntries != 0)
+  {
+    int result = (int)syscall(__NR_io_uring_enter, mRingFd, mQueuedEntries, 0, 0, nullptr, 0);
+    if(result < 0 && errno == EINTR)
+      continue;
+
+    if(result <= 0)
+    {
+      Error("Failed to submit to io_uring (error %d).", result < 0 ? errno : 0);
+      return;
+    }
+
+    // The kernel may consume fewer entries than were queued
+    mQueuedEntries -= (unsigned)result;
+  }
+}
+
+OsInt UringFileBackend::CompletionThreadEntry()
+{
+  bool shutdown = false;
+  while(!shutdown)
+  {
+    int result = (int)syscall(__NR_io_uring_enter, mRingFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    if(result < 0 && errno != EINTR)
+    {
+      Error("Failed to wait on io_uring (error %d).", errno);
+      return (OsInt)-1;
+    }
+
+    // Only this thread consumes completions
+    unsigned head = *mCqHead;
+    unsigned tail = __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE);
+    while(head != tail)
+    {
+      io_uring_cqe* completion = &mCqes[head & mCqMask];
+      u64 userData = completion->user_data;
+      int completionResult = completion->res;
+
+      // Give the slot back to the kernel before handling it (the handler may submit more)
+      ++head;
+      __atomic_store_n(mCqHead, head, __ATOMIC_RELEASE);
+
+      if(userData == cShutdownUserData)
+        shutdown = true;
+      else
+        HandleCompletion((UringOperation*)userData, completionResult);
+    }
+  }
+
+  return 0;
+}
+
+void UringFileBackend::HandleCompletion(UringOperation* operation, int result)
+{
+  AsyncFileRequest* request = operation->mRequest;
+
+  if(result < 0)
+  {
+    request->Result.SetFailed(String::Format("Failed to %s file '%s'.",
+      request->Operation == AsyncFileOperation::Read ? "read" : "write", request->FilePath.c_str()), -result);
+    Finish(operation);
+    return;
+  }
+
+  size_t transferred = (size_t)result;
+  request->BytesTransferred += transferred;
+  operation->mVector.iov_base = (byte*)operation->mVector.iov_base + transferred;
+  operation->mVector.iov_len -= transferred;
+  operation->mOffset += transferred;
+
+  // Done, or the file got shorter since we opened it
+  if(operation->mVector.iov_len == 0 || transferred == 0)
+  {
+    if(request->Operation == AsyncFileOperation::Read)
+      request->Data.Size = request->BytesTransferred;
+    else if(request->BytesTransferred != request->Data.Size)
+      request->Result.SetFailed(String::Format("Failed to write file '%s'.", request->FilePath.c_str()));
+
+    Finish(operation);
+    return;
+  }
+
+  // Partial transfer, submit the rest (stays in flight)
+  mLock.Lock();
+  --mInFlight;
+  operation->mSubmitted = false;
+  Queue(operation);
+  SubmitQueued();
+  mLock.Unlock();
+}
+
+void UringFileBackend::Finish(UringOperation* operation)
+{
+  // Operations that were handed to the kernel free up room for deferred ones
+  if(operation->mSubmitted)
+  {
+    mLock.Lock();
+    --mInFlight;
+    while(!mDeferred.Empty() && mInFlight < mCqEntries)
+    {
+      UringOperation* deferred = mDeferred.Front();
+      mDeferred.EraseAt(0);
+      Queue(deferred);
+    }
+    SubmitQueued();
+    mLock.Unlock();
+  }
+
+  AsyncFileRequest* request = operation->mRequest;
+  close(operation->mFd);
+  delete operation;
+
+  AsyncFileIo::CompleteRequest(request);
+}
+
+AsyncFileBackend* CreatePlatformAsyncFileBackend()
+{
+  UringFileBackend* backend = new UringFileBackend();
+  if(!backend->Initialize())
+  {
+    delete backend;
+    return nullptr;
+  }
+  return backend;
+}
+
+#else
+
+AsyncFileBackend* CreatePlatformAsyncFileBackend()
+{
+  // Use the thread pool
+  return nullptr;
+}
+
+#endif
+
+}//namespace Zero
@@ -0,0 +1,114 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file DebugSymbolInformation.cpp
+/// Call stack capture and symbol look-up with backtrace and dladdr.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Platform/DebugSymbolInformation.hpp"
+
+#include <execinfo.h>
+#include <dlfcn.h>
+#include <cxxabi.h>
+
+// Symbol names are only found for exported symbols, link executables
+// with -rdynamic so functions in the executable itself are named.
+
+namespace Zero
+{
+
+String CallStackSymbolInfos::ToString() const
+{
+  StringBuilder builder;
+
+  for(size_t i = 0; i < mCaptureSymbolCount; ++i)
+  {
+    const SymbolInfo& symbolInfo = mSymbols[i];
+    builder.Append(String::Format("%p (%s): %s\n", symbolInfo.mAddress, symbolInfo.mModuleName.c_str(), symbolInfo.mSymbolName.c_str()));
+  }
+
+  return builder.ToString();
+}
+
+void GetSymbolInfo(OsInt processHandle, SymbolInfo& symbolInfo)
+{
+  symbolInfo.mLineNumber = 0;
+
+  Dl_info info;
+  if(dladdr(symbolInfo.mAddress, &info) == 0)
+    return;
+
+  if(info.dli_fname != nullptr)
+  {
+    symbolInfo.mModulePath = info.dli_fname;
+    cstr moduleName = strrchr(info.dli_fname, '/');
+    symbolInfo.mModuleName = moduleName ? moduleName + 1 : info.dli_fname;
+  }
+
+  if(info.dli_sname != nullptr)
+  {
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    symbolInfo.mSymbolName = (status == 0 && demangled) ? demangled : info.dli_sname;
+    free(demangled);
+  }
+}
+
+size_t GetStackAddresses(CallStackAddresses& callStack, size_t stacksToCapture, size_t framesToSkip)
+{
+  // Backtrace can not skip frames, capture the skipped frames and remove them after
+  void* addresses[CallStackAddresses::mMaxCallstacks + 16];
+  size_t maxFrames = stacksToCapture + framesToSkip;
+  if(maxFrames > CallStackAddresses::mMaxCallstacks + 16)
+    maxFrames = CallStackAddresses::mMaxCallstacks + 16;
+
+  size_t captured = (size_t)backtrace(addresses, (int)maxFrames);
+  size_t count = captured > framesToSkip ? captured - framesToSkip : 0;
+  if(count > stacksToCapture)
+    count = stacksToCapture;
+  if(count > (size_t)CallStackAddresses::mMaxCallstacks)
+    count = CallStackAddresses::mMaxCallstacks;
+
+  memcpy(callStack.mAddresses, addresses + framesToSkip, count * sizeof(void*));
+  callStack.mCaptureFrameCount = count;
+  return count;
+}
+
+void GetStackInfo(CallStackAddresses& callStackAddresses, CallStackSymbolInfos& callStackSymbols)
+{
+  callStackSymbols.mCaptureSymbolCount = callStackAddresses.mCaptureFrameCount;
+  for(size_t i = 0; i < callStackAddresses.mCaptureFrameCount; ++i)
+  {
+    SymbolInfo& symbolInfo = callStackSymbols.mSymbols[i];
+    symbolInfo.mAddress = callStackAddresses.mAddresses[i];
+    GetSymbolInfo(0, symbolInfo);
+  }
+}
+
+void SimpleStackWalker::ShowCallstack(void* context, StringParam extraSymbolPaths, int stacksToSkip)
+{
+  // Walking a crash context is not supported, the current stack is always shown
+  CallStackAddresses callStack;
+  GetStackAddresses(callStack, CallStackAddresses::mMaxCallstacks, stacksToSkip + 1);
+
+  for(size_t i = 0; i < callStack.mCaptureFrameCount; ++i)
+  {
+    SymbolInfo symbolInfo;
+    symbolInfo.mAddress = callStack.mAddresses[i];
+    GetSymbolInfo(0, symbolInfo);
+
+    AddSymbolInformation(symbolInfo);
+  }
+}
+
+void SimpleStackWalker::AddSymbolInformation(SymbolInfo& symbolInfo)
+{
+  mBuilder.Append(String::Format("%p (%s): %s\n", symbolInfo.mAddress, symbolInfo.mModuleName.c_str(), symbolInfo.mSymbolName.c_str()));
+}
+
+String SimpleStackWalker::GetFinalOutput()
+{
+  return mBuilder.ToString();
+}
+
+}//namespace Zero
@@ -1,38 +1,316 @@
 ///////////////////////////////////////////////////////////////////////////////
 ///
-/// \file DirectoryWatcher.hpp
-/// 
-/// 
+/// \file DirectoryWatcher.cpp
+/// Recursive inotify based implementation of the DirectoryWatcher.
+///
 /// Authors: Chris Peters
 /// Copyright 2010, DigiPen Institute of Technology
 ///
 ///////////////////////////////////////////////////////////////////////////////
 #include "Precompiled.hpp"
 #include "Platform/DirectoryWatcher.hpp"
+#include "Containers/HashMap.hpp"
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <poll.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
 
 namespace Zero
 {
 
-DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, CallbackFunction callback, void* callbackInstance)
+#if defined(__linux__)
+
+// Defined in Timer.cpp
+u64 GetTimeNanosecond();
+
+// Every sub directory needs its own watch, this maps
+// watch descriptors to paths relative to the watched root
+typedef HashMap<int, String> WatchMap;
+
+const uint cWatchMask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE |
+                        IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF;
+
+// A change set is reported at most this long after its first change,
+// even if changes keep arriving (e.g. a long source control update)
+const uint cMaxBatchLatencyMs = 1000;
+
+String CombineRelative(StringParam directory, StringParam name)
 {
-  ZeroCStringCopy(mDirectoryToWatch, File::MaxPath, directoryToWatch, strlen(directoryToWatch));
-  mCallbackInstance = callbackInstance;
-  mCallback = callback;
+  if(directory.Empty())
+    return name;
+  return String::Format("%s/%s", directory.c_str(), name.c_str());
 }
 
-DirectoryWatcher::~DirectoryWatcher()
+// A move from event waiting for its matching move to event (by cookie)
+struct MovedFromInfo
+{
+  String FileName;
+  // Set once the move has been carried over a flushed change set
+  bool Carried;
+};
+
+// Adds a watch for the directory and all of its sub directories. Files found are
+// added to addedFiles when given, for directories created (or moved in) after the
+// watcher started, as anything created in them before the watch has no event.
+void AddWatchRecursive(int inotifyFd, StringParam root, StringParam relativePath, WatchMap& watches,
+                       Array<DirectoryWatcher::FileOperationInfo>* addedFiles)
 {
+  String fullPath = relativePath.Empty() ? String(root) : CombineRelative(root, relativePath);
+
+  int watch = inotify_add_watch(inotifyFd, fullPath.c_str(), cWatchMask);
+  if(watch < 0)
+  {
+    DebugPrint("Failed to watch directory %s (error %d)", fullPath.c_str(), errno);
+    return;
+  }
+  watches[watch] = relativePath;
+
+  DIR* directory = opendir(fullPath.c_str());
+  if(directory == nullptr)
+    return;
 
+  while(dirent* entry = readdir(directory))
+  {
+    if(strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0)
+      continue;
+
+    String entryPath = CombineRelative(relativePath, entry->d_name);
+    if(entry->d_type == DT_DIR)
+    {
+      AddWatchRecursive(inotifyFd, root, entryPath, watches, addedFiles);
+    }
+    else if(addedFiles != nullptr)
+    {
+      // Files created after the watch was added are also reported by an event,
+      // coalescing merges the two adds
+      DirectoryWatcher::FileOperationInfo& info = addedFiles->PushBack();
+      info.Operation = DirectoryWatcher::Added;
+      info.FileName = entryPath;
+    }
+  }
+
+  closedir(directory);
 }
 
-void DirectoryWatcher::Shutdown()
+// Stops watching the directory and all of its sub directories
+void RemoveWatchRecursive(int inotifyFd, StringParam relativePath, WatchMap& watches)
 {
+  String prefix = CombineRelative(relativePath, String());
+  Array<int> removed;
+  forRange(auto& entry, watches.All())
+  {
+    if(entry.second == relativePath || entry.second.StartsWith(prefix))
+      removed.PushBack(entry.first);
+  }
 
+  forRange(int watch, removed.All())
+  {
+    inotify_rm_watch(inotifyFd, watch);
+    watches.Erase(watch);
+  }
 }
 
 OsInt DirectoryWatcher::RunThreadEntryPoint()
 {
+  int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if(inotifyFd < 0)
+  {
+    Error("Failed to initialize inotify (error %d).", errno);
+    return (OsInt)-1;
+  }
+
+  String root = mDirectoryToWatch;
+  WatchMap watches;
+  AddWatchRecursive(inotifyFd, root, String(), watches, nullptr);
+
+  // Read buffer aligned for inotify_event
+  const size_t cBufferSize = 16 * 1024;
+  char buffer[cBufferSize] __attribute__((aligned(__alignof__(inotify_event))));
+
+  Array<FileOperationInfo> pending;
+  // Pending move from events waiting for their matching move to (by cookie)
+  HashMap<u32, MovedFromInfo> movedFrom;
+  // Directories moved from (by cookie), unmatched ones were moved out of the watched directory
+  HashMap<u32, String> movedDirectories;
+  u64 batchStartTime = 0;
+
+  while(!mShutdown)
+  {
+    // Set when a change set is flushed because a burst went on too long, rather than
+    // because things quieted down
+    bool burstContinues = false;
+
+    // Wait for changes, waking up every coalesce interval to check for shutdown and
+    // to flush the change set once things have quieted down
+    pollfd pollInfo;
+    pollInfo.fd = inotifyFd;
+    pollInfo.events = POLLIN;
+    pollInfo.revents = 0;
+    int ready = poll(&pollInfo, 1, (int)cCoalesceIntervalMs);
+
+    if(ready > 0 && (pollInfo.revents & POLLIN))
+    {
+      for(;;)
+      {
+        ssize_t length = read(inotifyFd, buffer, cBufferSize);
+        if(length <= 0)
+          break;
+
+        for(char* current = buffer; current < buffer + length;)
+        {
+          inotify_event* event = (inotify_event*)current;
+          current += sizeof(inotify_event) + event->len;
+
+          String* directory = watches.FindPointer(event->wd);
+          if(directory == nullptr)
+            continue;
+
+          if(event->mask & IN_IGNORED)
+          {
+            watches.Erase(event->wd);
+            continue;
+          }
+
+          if(event->len == 0)
+            continue;
+
+          String fileName = CombineRelative(*directory, event->name);
+          bool isDirectory = (event->mask & IN_ISDIR) != 0;
+
+          if(isDirectory && (event->mask & IN_MOVED_FROM))
+            movedDirectories[event->cookie] = fileName;
+
+          // Start watching new directories and report the files already in them. A directory
+          // renamed within the watched directory only needs its watches updated.
+          if(isDirectory && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+          {
+            bool renamed = (event->mask & IN_MOVED_TO) && movedDirectories.ContainsKey(event->cookie);
+            if(renamed)
+            {
+              movedDirectories.Erase(event->cookie);
+              AddWatchRecursive(inotifyFd, root, fileName, watches, nullptr);
+            }
+            else
+            {
+              if(pending.Empty())
+                batchStartTime = GetTimeNanosecond();
+              AddWatchRecursive(inotifyFd, root, fileName, watches, &pending);
+            }
+          }
+
+          // Only files are reported, matching the Windows watcher
+          if(isDirectory)
+            continue;
+
+          FileOperationInfo info;
+          info.FileName = fileName;
+
+          if(event->mask & IN_CREATE)
+          {
+            info.Operation = Added;
+          }
+          else if(event->mask & (IN_MODIFY | IN_CLOSE_WRITE))
+          {
+            info.Operation = Modified;
+          }
+          else if(event->mask & IN_DELETE)
+          {
+            info.Operation = Removed;
+          }
+          else if(event->mask & IN_MOVED_FROM)
+          {
+            MovedFromInfo& moved = movedFrom[event->cookie];
+            moved.FileName = fileName;
+            moved.Carried = false;
+            continue;
+          }
+          else if(event->mask & IN_MOVED_TO)
+          {
+            MovedFromInfo* moved = movedFrom.FindPointer(event->cookie);
+            if(moved != nullptr)
+            {
+              info.Operation = Renamed;
+              info.OldFileName = moved->FileName;
+              movedFrom.Erase(event->cookie);
+            }
+            else
+            {
+              // Moved in from outside the watched directory
+              info.Operation = Added;
+            }
+          }
+          else
+          {
+            continue;
+          }
+
+          if(pending.Empty())
+            batchStartTime = GetTimeNanosecond();
+          pending.PushBack(info);
+        }
+      }
+
+      // Keep collecting until the burst is over, unless it has gone on too long
+      u64 elapsedMs = (GetTimeNanosecond() - batchStartTime) / 1000000;
+      if(pending.Empty() || elapsedMs < cMaxBatchLatencyMs)
+        continue;
+      burstContinues = true;
+    }
+
+    // Files moved out of the watched directory are never matched with a move to. In the
+    // middle of a burst the move to may just not have been read yet, so unmatched moves
+    // are carried into the next change set once before being reported as removed.
+    Array<u32> reportedMoves;
+    forRange(auto& entry, movedFrom.All())
+    {
+      MovedFromInfo& moved = entry.second;
+      if(burstContinues && !moved.Carried)
+      {
+        moved.Carried = true;
+        continue;
+      }
+
+      FileOperationInfo info;
+      info.Operation = Removed;
+      info.FileName = moved.FileName;
+      pending.PushBack(info);
+      reportedMoves.PushBack(entry.first);
+    }
+    forRange(u32 cookie, reportedMoves.All())
+      movedFrom.Erase(cookie);
+    // Directories moved out keep their watches (inotify follows the inode), stop
+    // watching them so their changes are not reported under the old path
+    if(!burstContinues)
+    {
+      forRange(auto& entry, movedDirectories.All())
+        RemoveWatchRecursive(inotifyFd, entry.second, watches);
+      movedDirectories.Clear();
+    }
+
+    if(pending.Empty())
+      continue;
+
+    CoalesceOperations(pending);
+    DispatchOperations(pending);
+    pending.Clear();
+  }
+
+  close(inotifyFd);
+  return 0;
+}
+
+#else
+
+OsInt DirectoryWatcher::RunThreadEntryPoint()
+{
+  // No file change notifications on this platform
   return 0;
 }
 
+#endif
+
 }//namespace Zero
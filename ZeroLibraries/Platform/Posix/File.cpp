@@ -10,6 +10,10 @@
 #include "Precompiled.hpp"
 #include "Platform/File.hpp"
 
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+
 #pragma warning(disable: 4996)
 
 namespace Zero
@@ -200,4 +204,103 @@ void File::Flush()
   fflush(self->mHandle);
 }
 
+//----------------------------------------------------------- Mapped File
+struct MappedFilePrivateData
+{
+  byte* mData;
+  size_t mSize;
+  bool mOpen;
+};
+
+MappedFile::MappedFile()
+{
+  ZeroConstructPrivateData(MappedFilePrivateData);
+  self->mData = nullptr;
+  self->mSize = 0;
+  self->mOpen = false;
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+  ZeroDestructPrivateData(MappedFilePrivateData);
+}
+
+bool MappedFile::Open(Status& status, StringParam filePath, FileAccessPattern::Enum accessPattern)
+{
+  Close();
+  ZeroGetPrivateData(MappedFilePrivateData);
+
+  int fd = open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+  if(fd == -1)
+  {
+    status.SetFailed(String::Format("Failed to open file '%s'. %s", filePath.c_str(), cBadFileMessage), errno);
+    return false;
+  }
+
+  struct stat st;
+  if(fstat(fd, &st) != 0)
+  {
+    int error = errno;
+    close(fd);
+    status.SetFailed(String::Format("Failed to get the size of file '%s'.", filePath.c_str()), error);
+    return false;
+  }
+
+  // Mapping zero bytes is an error, an empty file is just an empty block
+  size_t size = (size_t)st.st_size;
+  byte* data = nullptr;
+  if(size != 0)
+  {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(mapping == MAP_FAILED)
+    {
+      int error = errno;
+      close(fd);
+      status.SetFailed(String::Format("Failed to map file '%s'.", filePath.c_str()), error);
+      return false;
+    }
+
+    data = (byte*)mapping;
+    madvise(mapping, size, accessPattern == FileAccessPattern::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+  }
+
+  // The mapping keeps its own reference to the file
+  close(fd);
+
+  self->mData = data;
+  self->mSize = size;
+  self->mOpen = true;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  if(self->mData != nullptr)
+    munmap(self->mData, self->mSize);
+
+  self->mData = nullptr;
+  self->mSize = 0;
+  self->mOpen = false;
+}
+
+bool MappedFile::IsOpen()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  return self->mOpen;
+}
+
+DataBlock MappedFile::GetBlock()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  return DataBlock(self->mData, self->mSize);
+}
+
+size_t MappedFile::Size()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  return self->mSize;
+}
+
 }//namespace Zero
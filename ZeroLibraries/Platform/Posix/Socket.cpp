@@ -16,6 +16,12 @@
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <fcntl.h>
+#include <poll.h>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
 
 // Platform Conversion Types and Macros
 typedef int              SOCKET_TYPE;
@@ -32,6 +38,7 @@ typedef sockaddr_storage SOCKET_ADDRESS_STORAGE;
 
 #include "Platform/Socket.hpp"
 #include "Utility/Atomic.hpp"
+#include "Platform/ThreadSync.hpp"
 
 #define CAST_HANDLE_TO_SOCKET(value) (static_cast<SOCKET_TYPE>(reinterpret_cast<size_t>(value)))
 #define CAST_SOCKET_TO_HANDLE(value) (reinterpret_cast<OsHandle>(value))
@@ -1399,18 +1406,21 @@ bool Socket::Select(Status& status, SocketSelect::Enum selectMode, float timeout
   FD_ZERO(&socketSet);
   FD_SET(CAST_HANDLE_TO_SOCKET(mHandle), &socketSet);
 
+  // Unlike Winsock, POSIX select requires the highest descriptor plus one
+  int socketCount = CAST_HANDLE_TO_SOCKET(mHandle) + 1;
+
   // Query select for specified socket operability status
   int result = 0;
   switch(selectMode)
   {
   case SocketSelect::Read:
-    result = select(0, &socketSet, NULL, NULL, &timeout);
+    result = select(socketCount, &socketSet, NULL, NULL, &timeout);
     break;
   case SocketSelect::Write:
-    result = select(0, NULL, &socketSet, NULL, &timeout);
+    result = select(socketCount, NULL, &socketSet, NULL, &timeout);
     break;
   case SocketSelect::Error:
-    result = select(0, NULL, NULL, &socketSet, &timeout);
+    result = select(socketCount, NULL, NULL, &socketSet, &timeout);
     break;
 
   default:
@@ -1427,6 +1437,144 @@ bool Socket::Select(Status& status, SocketSelect::Enum selectMode, float timeout
   return (result != 0);
 }
 
+#if defined(__linux__)
+
+size_t Socket::SendToBatch(Status& status, const SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // Translate platform-specific enums as necessary
+  TRANSLATE_TO_PLATFORM_ENUM_OR_RETURN_FAILURE_VALUE(flags, 0);
+
+  // Send datagrams in chunks, one system call per chunk
+  mmsghdr messages[SocketBatchSize];
+  iovec   vectors[SocketBatchSize];
+  size_t  sentCount = 0;
+  while(sentCount < datagramCount)
+  {
+    size_t chunkCount = datagramCount - sentCount;
+    if(chunkCount > SocketBatchSize)
+      chunkCount = SocketBatchSize;
+    for(size_t i = 0; i < chunkCount; ++i)
+    {
+      const SocketDatagram& datagram = datagrams[sentCount + i];
+      vectors[i].iov_base = datagram.mData;
+      vectors[i].iov_len  = datagram.mLength;
+
+      memset(&messages[i], 0, sizeof(mmsghdr));
+      messages[i].msg_hdr.msg_name    = (SOCKET_ADDRESS_STORAGE*)datagram.mAddress.mPrivateData;
+      messages[i].msg_hdr.msg_namelen = sizeof(SOCKET_ADDRESS_STORAGE);
+      messages[i].msg_hdr.msg_iov     = &vectors[i];
+      messages[i].msg_hdr.msg_iovlen  = 1;
+    }
+
+    // Send datagrams over socket to their specified remote addresses
+    int result = sendmmsg(CAST_HANDLE_TO_SOCKET(mHandle), messages, (uint)chunkCount, (int)flags);
+    if(result == SOCKET_ERROR) // Unable?
+    {
+      FailOnLastError(status);
+      return sentCount;
+    }
+
+    sentCount += result;
+
+    // Not all datagrams sent? (The next send would fail with the reason)
+    if(size_t(result) < chunkCount)
+      break;
+  }
+
+  // Success
+  return sentCount;
+}
+
+size_t Socket::ReceiveFromBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // Translate platform-specific enums as necessary
+  TRANSLATE_TO_PLATFORM_ENUM_OR_RETURN_FAILURE_VALUE(flags, 0);
+
+  // Receive up to one chunk, the caller receives again for more
+  mmsghdr messages[SocketBatchSize];
+  iovec   vectors[SocketBatchSize];
+  size_t  chunkCount = datagramCount;
+  if(chunkCount > SocketBatchSize)
+    chunkCount = SocketBatchSize;
+  for(size_t i = 0; i < chunkCount; ++i)
+  {
+    SocketDatagram& datagram = datagrams[i];
+    vectors[i].iov_base = datagram.mData;
+    vectors[i].iov_len  = datagram.mCapacity;
+
+    memset(&messages[i], 0, sizeof(mmsghdr));
+    messages[i].msg_hdr.msg_name    = (SOCKET_ADDRESS_STORAGE*)datagram.mAddress.mPrivateData;
+    messages[i].msg_hdr.msg_namelen = sizeof(SOCKET_ADDRESS_STORAGE);
+    messages[i].msg_hdr.msg_iov     = &vectors[i];
+    messages[i].msg_hdr.msg_iovlen  = 1;
+  }
+
+  // Receive datagrams over socket from any remote address
+  // (Only blocks until the first datagram is received)
+  int result = recvmmsg(CAST_HANDLE_TO_SOCKET(mHandle), messages, (uint)chunkCount, (int)flags | MSG_WAITFORONE, nullptr);
+  if(result == SOCKET_ERROR) // Unable?
+  {
+    FailOnLastError(status);
+    return 0;
+  }
+
+  // Output received lengths
+  for(int i = 0; i < result; ++i)
+    datagrams[i].mLength = messages[i].msg_len;
+
+  // Success
+  return result;
+}
+
+#else
+
+size_t Socket::SendToBatch(Status& status, const SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // No batched datagram send on this platform, send each datagram individually
+  for(size_t i = 0; i < datagramCount; ++i)
+  {
+    const SocketDatagram& datagram = datagrams[i];
+    SendTo(status, datagram.mData, datagram.mLength, datagram.mAddress, flags);
+    if(status.Failed()) // Unable?
+      return i;
+  }
+
+  // Success
+  return datagramCount;
+}
+
+size_t Socket::ReceiveFromBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // No batched datagram receive on this platform, receive individually while data is immediately available
+  size_t receivedCount = 0;
+  while(receivedCount < datagramCount)
+  {
+    // Only the first receive may block
+    if(receivedCount != 0)
+    {
+      Status selectStatus;
+      if(!Select(selectStatus, SocketSelect::Read, 0.0f)) // Nothing more to receive?
+        break;
+    }
+
+    SocketDatagram& datagram = datagrams[receivedCount];
+    datagram.mLength = ReceiveFrom(status, datagram.mData, datagram.mCapacity, datagram.mAddress, flags);
+    if(status.Failed()) // Unable?
+    {
+      // Report the error only if nothing was received
+      if(receivedCount != 0)
+        status = Status();
+      break;
+    }
+
+    ++receivedCount;
+  }
+
+  return receivedCount;
+}
+
+#endif
+
 void Socket::GetSocketOption(Status& status, SocketOption::Enum option, void* value, size_t* valueLength) const
 {
   Assert(valueLength && *valueLength, "valueLength must contain the non-zero size of the value parameter");
@@ -1603,4 +1751,246 @@ SocketAddress QueryRemoteSocketAddress(Status& status, const Socket& socket)
   return address;
 }
 
+//---------------------------------------------------------------------------------//
+//                                 SocketPoller                                    //
+//---------------------------------------------------------------------------------//
+
+#if defined(__linux__)
+
+/// Maximum number of ready sockets queried per wait
+static const int EpollMaxEvents = 64;
+
+struct PosixSocketPoller
+{
+  /// Epoll instance descriptor
+  int mEpollFd;
+  /// Event descriptor used to wake the waiting thread
+  int mWakeFd;
+};
+
+SocketPoller::SocketPoller()
+{
+  ZeroConstructPrivateData(PosixSocketPoller);
+  self->mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+  self->mWakeFd  = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  ErrorIf(self->mEpollFd == SOCKET_ERROR || self->mWakeFd == SOCKET_ERROR, "Unable to create socket poller (error %d)", errno);
+
+  // Watch the wake event (identified by our own data)
+  epoll_event event = {};
+  event.events   = EPOLLIN;
+  event.data.ptr = self;
+  epoll_ctl(self->mEpollFd, EPOLL_CTL_ADD, self->mWakeFd, &event);
+}
+
+SocketPoller::~SocketPoller()
+{
+  ZeroGetPrivateData(PosixSocketPoller);
+  if(self->mWakeFd != SOCKET_ERROR)
+    close(self->mWakeFd);
+  if(self->mEpollFd != SOCKET_ERROR)
+    close(self->mEpollFd);
+  ZeroDestructPrivateData(PosixSocketPoller);
+}
+
+void SocketPoller::Add(Status& status, const Socket& socket, void* userData)
+{
+  ZeroGetPrivateData(PosixSocketPoller);
+
+  // Level triggered, a socket is reported until everything has been received
+  epoll_event event = {};
+  event.events   = EPOLLIN;
+  event.data.ptr = userData;
+  if(epoll_ctl(self->mEpollFd, EPOLL_CTL_ADD, CAST_HANDLE_TO_SOCKET(socket.mHandle), &event) == SOCKET_ERROR) // Unable?
+    FailOnLastError(status);
+}
+
+void SocketPoller::Remove(Status& status, const Socket& socket)
+{
+  ZeroGetPrivateData(PosixSocketPoller);
+
+  epoll_event event = {};
+  if(epoll_ctl(self->mEpollFd, EPOLL_CTL_DEL, CAST_HANDLE_TO_SOCKET(socket.mHandle), &event) == SOCKET_ERROR) // Unable?
+    FailOnLastError(status);
+}
+
+size_t SocketPoller::Wait(Status& status, void** readyUserDataOut, size_t maxReady, uint timeoutMs)
+{
+  ZeroGetPrivateData(PosixSocketPoller);
+
+  // Wait for incoming data on any watched socket
+  epoll_event events[EpollMaxEvents];
+  int maxEvents = maxReady < EpollMaxEvents ? (int)maxReady : EpollMaxEvents;
+  int result = epoll_wait(self->mEpollFd, events, maxEvents, (int)timeoutMs);
+  if(result == SOCKET_ERROR) // Unable?
+  {
+    // Interrupted by a signal?
+    if(errno == EINTR)
+      return 0;
+
+    FailOnLastError(status);
+    return 0;
+  }
+
+  // Output ready sockets
+  size_t readyCount = 0;
+  for(int i = 0; i < result; ++i)
+  {
+    // Woken up?
+    if(events[i].data.ptr == self)
+    {
+      // Reset the wake event
+      uint64_t value = 0;
+      ssize_t bytesRead = read(self->mWakeFd, &value, sizeof(value));
+      UnusedParameter(bytesRead);
+      continue;
+    }
+
+    readyUserDataOut[readyCount++] = events[i].data.ptr;
+  }
+
+  // Success
+  return readyCount;
+}
+
+void SocketPoller::Wake()
+{
+  ZeroGetPrivateData(PosixSocketPoller);
+
+  uint64_t value = 1;
+  ssize_t bytesWritten = write(self->mWakeFd, &value, sizeof(value));
+  UnusedParameter(bytesWritten);
+}
+
+#else
+
+struct PosixSocketPoller
+{
+  /// Poll descriptors, the first entry is always the wake pipe
+  Array<pollfd>  mPollFds;
+  /// User data of each poll descriptor
+  Array<void*>   mUserData;
+  /// Poll descriptors and user data thread lock
+  ThreadLock     mLock;
+  /// Pipe written to in order to wake the waiting thread
+  int            mWakePipe[2];
+};
+
+SocketPoller::SocketPoller()
+{
+  ZeroConstructPrivateData(PosixSocketPoller*);
+  *self = new PosixSocketPoller();
+  PosixSocketPoller* poller = *self;
+
+  int result = pipe(poller->mWakePipe);
+  ErrorIf(result == SOCKET_ERROR, "Unable to create socket poller (error %d)", errno);
+  fcntl(poller->mWakePipe[0], F_SETFL, O_NONBLOCK);
+  fcntl(poller->mWakePipe[1], F_SETFL, O_NONBLOCK);
+
+  pollfd wakeFd = {};
+  wakeFd.fd     = poller->mWakePipe[0];
+  wakeFd.events = POLLIN;
+  poller->mPollFds.PushBack(wakeFd);
+  poller->mUserData.PushBack(nullptr);
+}
+
+SocketPoller::~SocketPoller()
+{
+  ZeroGetPrivateData(PosixSocketPoller*);
+  close((*self)->mWakePipe[0]);
+  close((*self)->mWakePipe[1]);
+  delete *self;
+  ZeroDestructPrivateData(PosixSocketPoller*);
+}
+
+void SocketPoller::Add(Status& status, const Socket& socket, void* userData)
+{
+  ZeroGetPrivateData(PosixSocketPoller*);
+  PosixSocketPoller* poller = *self;
+
+  pollfd pollFd = {};
+  pollFd.fd     = CAST_HANDLE_TO_SOCKET(socket.mHandle);
+  pollFd.events = POLLIN;
+
+  poller->mLock.Lock();
+  poller->mPollFds.PushBack(pollFd);
+  poller->mUserData.PushBack(userData);
+  poller->mLock.Unlock();
+
+  // Wake the waiting thread so it polls the new socket
+  Wake();
+}
+
+void SocketPoller::Remove(Status& status, const Socket& socket)
+{
+  ZeroGetPrivateData(PosixSocketPoller*);
+  PosixSocketPoller* poller = *self;
+
+  poller->mLock.Lock();
+  for(size_t i = 1; i < poller->mPollFds.Size(); ++i)
+  {
+    if(poller->mPollFds[i].fd == CAST_HANDLE_TO_SOCKET(socket.mHandle))
+    {
+      poller->mPollFds.EraseAt(i);
+      poller->mUserData.EraseAt(i);
+      break;
+    }
+  }
+  poller->mLock.Unlock();
+}
+
+size_t SocketPoller::Wait(Status& status, void** readyUserDataOut, size_t maxReady, uint timeoutMs)
+{
+  ZeroGetPrivateData(PosixSocketPoller*);
+  PosixSocketPoller* poller = *self;
+
+  // Poll a copy so sockets can be added and removed while waiting
+  poller->mLock.Lock();
+  Array<pollfd> pollFds  = poller->mPollFds;
+  Array<void*>  userData = poller->mUserData;
+  poller->mLock.Unlock();
+
+  // Wait for incoming data on any watched socket
+  int result = poll(pollFds.Data(), (nfds_t)pollFds.Size(), (int)timeoutMs);
+  if(result == SOCKET_ERROR) // Unable?
+  {
+    // Interrupted by a signal?
+    if(errno == EINTR)
+      return 0;
+
+    FailOnLastError(status);
+    return 0;
+  }
+
+  // Woken up?
+  if(pollFds[0].revents != 0)
+  {
+    // Drain the wake pipe
+    byte buffer[16];
+    while(read(poller->mWakePipe[0], buffer, sizeof(buffer)) > 0)
+      continue;
+  }
+
+  // Output ready sockets
+  size_t readyCount = 0;
+  for(size_t i = 1; i < pollFds.Size() && readyCount < maxReady; ++i)
+  {
+    if(pollFds[i].revents != 0)
+      readyUserDataOut[readyCount++] = userData[i];
+  }
+
+  // Success
+  return readyCount;
+}
+
+void SocketPoller::Wake()
+{
+  ZeroGetPrivateData(PosixSocketPoller*);
+
+  byte wake = 1;
+  ssize_t bytesWritten = write((*self)->mWakePipe[1], &wake, sizeof(wake));
+  UnusedParameter(bytesWritten);
+}
+
+#endif
+
 } // namespace Zero
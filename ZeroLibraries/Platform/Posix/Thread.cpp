@@ -1,58 +1,329 @@
 ///////////////////////////////////////////////////////////////////////////////
 ///
 /// \file Thread.cpp
-/// Declaration of the Thread class.
-/// 
+/// Implementation of the Thread class.
+///
 /// Authors: Chris Peters
 /// Copyright 2010, DigiPen Institute of Technology
 ///
 ///////////////////////////////////////////////////////////////////////////////
 #include "Precompiled.hpp"
 #include "Platform/Thread.hpp"
+#include "Platform/Utilities.hpp"
+#include "Utility/Atomic.hpp"
+
+#include <pthread.h>
+#include <errno.h>
+#include <time.h>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
 
 namespace Zero
 {
 
-const bool ThreadingEnabled = false;
+const bool ThreadingEnabled = true;
+
+// Linux limits thread names to 16 characters including the null terminator
+const size_t cMaxPosixThreadName = 16;
+
+// Shared between the Thread object and the running thread. The running thread may
+// outlive the Thread object (after Close or Detach) so the state is reference counted.
+struct ThreadStartData
+{
+  Thread::EntryFunction mEntry;
+  void* mInstance;
+  char mName[cMaxPosixThreadName];
+  OsInt mExitCode;
+  Atomic<s32> mCompleted;
+  Atomic<s32> mReferences;
+};
+
+void ReleaseThreadStartData(ThreadStartData* startData)
+{
+  if(--startData->mReferences == 0)
+    delete startData;
+}
+
+void* PosixThreadEntry(void* data)
+{
+  ThreadStartData* startData = (ThreadStartData*)data;
+
+#if defined(__APPLE__)
+  // Apple only allows naming the calling thread
+  pthread_setname_np(startData->mName);
+#endif
+
+  startData->mExitCode = startData->mEntry(startData->mInstance);
+  Memory::ReleaseThreadMemory();
+  startData->mCompleted = 1;
+  ReleaseThreadStartData(startData);
+  return nullptr;
+}
+
+struct ThreadPrivateData
+{
+  pthread_t mHandle;
+  ThreadStartData* mStartData;
+  u64 mProcessorMask;
+  // The thread has been created with pthread_create (Resume was called)
+  bool mStarted;
+  // The thread has been joined or detached and the handle is no longer usable
+  bool mReleased;
+};
+
+bool ApplyProcessorAffinity(pthread_t handle, u64 processorMask)
+{
+#if defined(__linux__)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for(uint i = 0; i < 64 && i < CPU_SETSIZE; ++i)
+  {
+    if(processorMask & (u64(1) << i))
+      CPU_SET(i, &cpuSet);
+  }
+  return pthread_setaffinity_np(handle, sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
 
 Thread::Thread()
 {
+  ZeroConstructPrivateData(ThreadPrivateData);
+  self->mStartData = nullptr;
+  self->mProcessorMask = 0;
+  self->mStarted = false;
+  self->mReleased = false;
 }
 
 Thread::~Thread()
 {
+  Close();
+  ZeroDestructPrivateData(ThreadPrivateData);
 }
 
+OsHandle Thread::GetThreadHandle()
+{
+  ZeroGetPrivateData(ThreadPrivateData);
+  if(!self->mStarted || self->mReleased)
+    return nullptr;
+  return (OsHandle)self->mHandle;
+}
 
-bool Thread::IsValid()
+bool Thread::SetProcessorAffinity(u64 processorMask)
 {
-return true;  
+  ZeroGetPrivateData(ThreadPrivateData);
+  if(!IsValid())
+    return false;
+
+  // Posix threads cannot be created suspended, so the mask
+  // is applied when the thread actually starts running
+  self->mProcessorMask = processorMask;
+  if(self->mStarted && !self->mReleased)
+    return ApplyProcessorAffinity(self->mHandle, processorMask);
+  return true;
 }
 
-bool Thread::Initialize(EntryFunction entry, void* instance, cstr threadName)
+bool Thread::Initialize(EntryFunction entry, void* instance, StringParam threadName, ThreadConfig* config)
 {
-return true;  
+  ZeroGetPrivateData(ThreadPrivateData);
+
+  ErrorIf(IsValid(), "Thread %s was already initialized", threadName.c_str());
+  mThreadName = threadName;
+
+  ThreadStartData* startData = new ThreadStartData();
+  startData->mEntry = entry;
+  startData->mInstance = instance;
+  startData->mExitCode = 0;
+  startData->mCompleted = 0;
+  // One reference for this object and one for the running thread
+  startData->mReferences = 2;
+  size_t nameSize = threadName.SizeInBytes();
+  if(nameSize > cMaxPosixThreadName - 1)
+    nameSize = cMaxPosixThreadName - 1;
+  memset(startData->mName, 0, sizeof(startData->mName));
+  ZeroCStringCopy(startData->mName, cMaxPosixThreadName, threadName.c_str(), nameSize);
+
+  self->mStartData = startData;
+  self->mStarted = false;
+  self->mReleased = false;
+  return true;
 }
 
-void Thread::Resume()
+bool Thread::IsValid()
 {
+  ZeroGetPrivateData(ThreadPrivateData);
+  return self->mStartData != nullptr;
 }
 
+void Thread::Resume()
+{
+  ZeroGetPrivateData(ThreadPrivateData);
+  // Only the first resume starts the thread (Suspend is not supported on posix)
+  if(!IsValid() || self->mStarted)
+    return;
+
+  ThreadStartData* startData = self->mStartData;
+
+  pthread_attr_t attributes;
+  pthread_attr_init(&attributes);
+  pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_JOINABLE);
+
+  int result = pthread_create(&self->mHandle, &attributes, &PosixThreadEntry, startData);
+  pthread_attr_destroy(&attributes);
+
+  if(result != 0)
+  {
+    // The thread never ran, Close will release the reference it would have held
+    Error("Failed to create thread named %s (error %d)", mThreadName.c_str(), result);
+    return;
+  }
+
+  self->mStarted = true;
+
+#if defined(__linux__)
+  pthread_setname_np(self->mHandle, startData->mName);
+#endif
+
+  if(self->mProcessorMask != 0)
+    ApplyProcessorAffinity(self->mHandle, self->mProcessorMask);
+}
 
 void Thread::Suspend()
 {
+  // Posix threads cannot be suspended from another thread
+  Warn("Suspending a thread is not supported on this platform. Thread name: %s",
+       mThreadName.c_str());
 }
 
-
+// Close the thread handle.
 void Thread::Close()
 {
+  ZeroGetPrivateData(ThreadPrivateData);
+  if(!IsValid())
+    return;
+
+  ThreadStartData* startData = self->mStartData;
 
+  if(self->mStarted && !self->mReleased)
+  {
+    // The thread keeps running (like closing a handle on Windows) but is no longer joinable
+    pthread_detach(self->mHandle);
+  }
+  else if(!self->mStarted)
+  {
+    // The thread was never resumed so drop the reference it would have held
+    ReleaseThreadStartData(startData);
+  }
+
+  ReleaseThreadStartData(startData);
+  self->mStartData = nullptr;
+  self->mStarted = false;
+  self->mReleased = false;
+  self->mProcessorMask = 0;
 }
 
+OsHandle Thread::Detach()
+{
+  OsHandle handle = GetThreadHandle();
+  Close();
+  return handle;
+}
 
 OsInt Thread::WaitForCompletion()
 {
-  return 0;
+  ZeroGetPrivateData(ThreadPrivateData);
+  if(!IsValid() || !self->mStarted)
+    return (OsInt)-1;
+
+  if(!self->mReleased)
+  {
+    int result = pthread_join(self->mHandle, nullptr);
+    if(result != 0)
+    {
+      DebugPrint("Failed to wait on thread. Thread name: %s", mThreadName.c_str());
+      return (OsInt)-1;
+    }
+    self->mReleased = true;
+  }
+
+  return self->mStartData->mExitCode;
+}
+
+OsInt Thread::WaitForCompletion(unsigned long milliseconds)
+{
+  ZeroGetPrivateData(ThreadPrivateData);
+  if(!IsValid() || !self->mStarted)
+    return (OsInt)-1;
+
+  if(!self->mReleased)
+  {
+#if defined(__linux__)
+    timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += milliseconds / 1000;
+    deadline.tv_nsec += (long)(milliseconds % 1000) * 1000000;
+    if(deadline.tv_nsec >= 1000000000)
+    {
+      deadline.tv_sec += 1;
+      deadline.tv_nsec -= 1000000000;
+    }
+
+    int result = pthread_timedjoin_np(self->mHandle, nullptr, &deadline);
+    if(result != 0)
+    {
+      if(result != ETIMEDOUT)
+        DebugPrint("Failed to wait on thread. Thread name: %s", mThreadName.c_str());
+      return (OsInt)-1;
+    }
+#else
+    // No timed join, so poll the completion flag before joining
+    const uint cPollMs = 1;
+    unsigned long waited = 0;
+    while(!self->mStartData->mCompleted)
+    {
+      if(waited >= milliseconds)
+        return (OsInt)-1;
+      Os::Sleep(cPollMs);
+      waited += cPollMs;
+    }
+    pthread_join(self->mHandle, nullptr);
+#endif
+    self->mReleased = true;
+  }
+
+  return self->mStartData->mExitCode;
+}
+
+bool Thread::IsCompleted()
+{
+  ZeroGetPrivateData(ThreadPrivateData);
+  if(!IsValid() || !self->mStarted)
+    return true;
+
+  return self->mStartData->mCompleted != 0;
+}
+
+ThreadConfig::ThreadConfig()
+{
+
+}
+
+ThreadConfig::~ThreadConfig()
+{
+
+}
+
+void ThreadConfig::SetParameter(StringParam name, void* value)
+{
+  mConfigValues.Insert(name, value);
+}
+
+void* ThreadConfig::GetParameter(StringParam name)
+{
+  return mConfigValues.FindValue(name, nullptr);
 }
 
 }//namespace Zero
@@ -2,7 +2,7 @@
 ///
 /// \file ThreadSync.cpp
 /// Implementation of Thread synchronization classes.
-/// 
+///
 /// Authors: Chris Peters
 /// Copyright 2010, DigiPen Institute of Technology
 ///
@@ -10,90 +10,273 @@
 #include "Precompiled.hpp"
 #include "Platform/ThreadSync.hpp"
 
+#include <pthread.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
 namespace Zero
 {
 
+//----------------------------------------------------------- Thread Lock
 ThreadLock::ThreadLock()
 {
-
+  ZeroConstructPrivateData(pthread_mutex_t);
+
+  // Matches the critical section semantics on Windows (recursive locking is allowed)
+  pthread_mutexattr_t attributes;
+  pthread_mutexattr_init(&attributes);
+  pthread_mutexattr_settype(&attributes, PTHREAD_MUTEX_RECURSIVE);
+  int result = pthread_mutex_init(self, &attributes);
+  pthread_mutexattr_destroy(&attributes);
+  ErrorIf(result != 0, "Failed to create thread lock (error %d).", result);
 }
 
 ThreadLock::~ThreadLock()
 {
-
+  ZeroGetPrivateData(pthread_mutex_t);
+  pthread_mutex_destroy(self);
+  ZeroDestructPrivateData(pthread_mutex_t);
 }
 
 void ThreadLock::Lock()
 {
-
+  ZeroGetPrivateData(pthread_mutex_t);
+  pthread_mutex_lock(self);
 }
 
 void ThreadLock::Unlock()
 {
-
+  ZeroGetPrivateData(pthread_mutex_t);
+  pthread_mutex_unlock(self);
 }
 
+//----------------------------------------------------------- Os Event
+struct PosixEvent
+{
+  pthread_mutex_t mMutex;
+  pthread_cond_t mCondition;
+  bool mManualReset;
+  bool mSignaled;
+};
+
 OsEvent::OsEvent()
+  : mHandle(nullptr)
 {
 }
 
 OsEvent::~OsEvent()
 {
+  Close();
 }
 
 void OsEvent::Initialize(bool manualReset, bool startSignaled)
 {
-
+  Close();
+
+  PosixEvent* event = new PosixEvent();
+  pthread_mutex_init(&event->mMutex, nullptr);
+  pthread_cond_init(&event->mCondition, nullptr);
+  event->mManualReset = manualReset;
+  event->mSignaled = startSignaled;
+  mHandle = event;
 }
 
 void OsEvent::Close()
 {
-
+  if(mHandle != nullptr)
+  {
+    PosixEvent* event = (PosixEvent*)mHandle;
+    pthread_cond_destroy(&event->mCondition);
+    pthread_mutex_destroy(&event->mMutex);
+    delete event;
+    mHandle = nullptr;
+  }
 }
 
 void OsEvent::Signal()
 {
-
+  PosixEvent* event = (PosixEvent*)mHandle;
+  ErrorIf(event == nullptr, "Failed to Signal event.");
+
+  pthread_mutex_lock(&event->mMutex);
+  event->mSignaled = true;
+  // A manual reset event releases every waiter, an auto reset event releases one
+  if(event->mManualReset)
+    pthread_cond_broadcast(&event->mCondition);
+  else
+    pthread_cond_signal(&event->mCondition);
+  pthread_mutex_unlock(&event->mMutex);
 }
 
 void OsEvent::Reset()
 {
+  PosixEvent* event = (PosixEvent*)mHandle;
+  ErrorIf(event == nullptr, "Failed to Reset event.");
 
+  pthread_mutex_lock(&event->mMutex);
+  event->mSignaled = false;
+  pthread_mutex_unlock(&event->mMutex);
 }
 
 void OsEvent::Wait()
 {
+  PosixEvent* event = (PosixEvent*)mHandle;
+  ErrorIf(event == nullptr, "Failed to Wait on event.");
+
+  pthread_mutex_lock(&event->mMutex);
+  while(!event->mSignaled)
+    pthread_cond_wait(&event->mCondition, &event->mMutex);
 
+  if(!event->mManualReset)
+    event->mSignaled = false;
+  pthread_mutex_unlock(&event->mMutex);
 }
 
-Semaphore::Semaphore()
+//----------------------------------------------------------- Semaphore
+struct PosixSemaphore
 {
+  pthread_mutex_t mMutex;
+  pthread_cond_t mCondition;
+  int mCount;
+};
 
+Semaphore::Semaphore()
+{
+  PosixSemaphore* semaphore = new PosixSemaphore();
+  pthread_mutex_init(&semaphore->mMutex, nullptr);
+  pthread_cond_init(&semaphore->mCondition, nullptr);
+  semaphore->mCount = 0;
+  mHandle = semaphore;
 }
 
 Semaphore::~Semaphore()
 {
-
+  PosixSemaphore* semaphore = (PosixSemaphore*)mHandle;
+  pthread_cond_destroy(&semaphore->mCondition);
+  pthread_mutex_destroy(&semaphore->mMutex);
+  delete semaphore;
 }
 
 void Semaphore::Increment()
 {
-
+  PosixSemaphore* semaphore = (PosixSemaphore*)mHandle;
+  pthread_mutex_lock(&semaphore->mMutex);
+  if(semaphore->mCount < MaxSemaphoreCount)
+  {
+    ++semaphore->mCount;
+    pthread_cond_signal(&semaphore->mCondition);
+  }
+  else
+  {
+    Error("Failed to increment semaphore");
+  }
+  pthread_mutex_unlock(&semaphore->mMutex);
 }
 
 void Semaphore::Decrement()
 {
-
+  // Same as waiting with a zero timeout on Windows, only decrements if signaled
+  PosixSemaphore* semaphore = (PosixSemaphore*)mHandle;
+  pthread_mutex_lock(&semaphore->mMutex);
+  if(semaphore->mCount > 0)
+    --semaphore->mCount;
+  pthread_mutex_unlock(&semaphore->mMutex);
 }
 
 void Semaphore::Reset()
 {
-
+  PosixSemaphore* semaphore = (PosixSemaphore*)mHandle;
+  pthread_mutex_lock(&semaphore->mMutex);
+  semaphore->mCount = 0;
+  pthread_mutex_unlock(&semaphore->mMutex);
 }
 
 void Semaphore::WaitAndDecrement()
 {
+  PosixSemaphore* semaphore = (PosixSemaphore*)mHandle;
+  pthread_mutex_lock(&semaphore->mMutex);
+  while(semaphore->mCount == 0)
+    pthread_cond_wait(&semaphore->mCondition, &semaphore->mMutex);
+  --semaphore->mCount;
+  pthread_mutex_unlock(&semaphore->mMutex);
+}
 
+//----------------------------------------------------------- Mutex
+// Named interprocess mutexes are emulated with an advisory lock on a file in the
+// temporary directory. The lock is held for the lifetime of the Mutex object.
+Mutex::Mutex()
+{
+  ZeroConstructPrivateData(int);
+  *self = -1;
+}
+
+Mutex::~Mutex()
+{
+  ZeroGetPrivateData(int);
+  if(*self != -1)
+  {
+    flock(*self, LOCK_UN);
+    close(*self);
+  }
+
+  ZeroDestructPrivateData(int);
+}
+
+void Mutex::Initialize(Status& status, const char* mutexName, bool failIfAlreadyExists)
+{
+  ZeroGetPrivateData(int);
+
+  String lockPath = String::Format("/tmp/%s.lock", mutexName);
+  *self = open(lockPath.c_str(), O_RDWR | O_CREAT, 0666);
+  if(*self == -1)
+  {
+    status.SetFailed("Mutex initialization error.", errno);
+    return;
+  }
+
+  // Another process holding the lock is the equivalent of the mutex already existing
+  if(flock(*self, LOCK_EX | LOCK_NB) != 0 && failIfAlreadyExists)
+  {
+    int error = errno;
+    close(*self);
+    *self = -1;
+    status.SetFailed("The handle already existed", error);
+    return;
+  }
+}
+
+//----------------------------------------------------------- Countdown Event
+CountdownEvent::CountdownEvent()
+  : mCount(0)
+{
+  mWaitEvent.Initialize(true, true);
+}
+
+void CountdownEvent::IncrementCount()
+{
+  mThreadLock.Lock();
+  // If count is initially zero, reset event
+  if (mCount == 0)
+    mWaitEvent.Reset();
+  ++mCount;
+  mThreadLock.Unlock();
+}
+
+void CountdownEvent::DecrementCount()
+{
+  mThreadLock.Lock();
+  --mCount;
+  // If count is now zero, signal event
+  if (mCount == 0)
+    mWaitEvent.Signal();
+  mThreadLock.Unlock();
+}
+
+void CountdownEvent::Wait()
+{
+  mWaitEvent.Wait();
 }
 
 }//namespace Zero
@@ -185,6 +185,32 @@ ZeroShared SocketAddress StringToIpv4Address(StringParam address, ushort port);
 ZeroShared SocketAddress StringToIpv6Address(StringParam address);
 ZeroShared SocketAddress StringToIpv6Address(StringParam address, ushort port);
 
+//---------------------------------------------------------------------------------//
+//                                SocketDatagram                                   //
+//---------------------------------------------------------------------------------//
+
+/// Single datagram used by batched socket send and receive operations
+struct ZeroShared SocketDatagram
+{
+  /// Creates an empty datagram
+  SocketDatagram()
+    : mData(nullptr),
+      mCapacity(0),
+      mLength(0),
+      mAddress()
+  {
+  }
+
+  /// Datagram data buffer
+  byte*         mData;
+  /// Size of the data buffer (only used when receiving)
+  size_t        mCapacity;
+  /// Number of bytes to send, or number of bytes received
+  size_t        mLength;
+  /// Destination address when sending, source address when receiving
+  SocketAddress mAddress;
+};
+
 //---------------------------------------------------------------------------------//
 //                                    Socket                                       //
 //---------------------------------------------------------------------------------//
@@ -345,6 +371,19 @@ public:
   /// In a high efficiency situation, mechanisms other than select should be used
   bool Select(Status& status, SocketSelect::Enum selectMode, float timeoutSeconds) const;
 
+  /// Sends a batch of datagrams on the open socket, each to its own remote address
+  /// Uses as few system calls as the platform allows (sendmmsg on Linux)
+  /// Will block if the send buffer is full (unless the socket is set to non-blocking)
+  /// Returns the number of datagrams sent (stops at the first error, status will contain the error)
+  size_t SendToBatch(Status& status, const SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags = SocketFlags::None);
+
+  /// Receives a batch of datagrams on the open socket from any remote address
+  /// Each datagram must provide a data buffer and capacity, the received length and source address are written back
+  /// Uses as few system calls as the platform allows (recvmmsg on Linux)
+  /// Will block until one datagram is received (unless the socket is set to non-blocking), then only receives datagrams that are immediately available
+  /// Returns the number of datagrams received (0 if an error occurs, status will contain the error)
+  size_t ReceiveFromBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags = SocketFlags::None);
+
   /// Gets the current value of the specified socket option
   template <typename Option, typename T>
   void GetSocketOption(Status& status, Option option, T& value) const
@@ -426,6 +465,42 @@ struct ZeroShared MoveWithoutDestructionOperator<Socket>
   }
 };
 
+//---------------------------------------------------------------------------------//
+//                                 SocketPoller                                    //
+//---------------------------------------------------------------------------------//
+
+/// Waits on many sockets at once until they have incoming data
+/// (Uses epoll on Linux and WSAPoll on Windows)
+/// Sockets may be added and removed from any thread, only one thread may wait at a time
+class ZeroShared SocketPoller
+{
+public:
+  /// Creates a poller watching no sockets
+  SocketPoller();
+  /// Destroys the poller (sockets are not closed)
+  ~SocketPoller();
+
+  /// Starts watching the open socket for incoming data
+  /// The user data provided is output by Wait whenever the socket has data to receive
+  void Add(Status& status, const Socket& socket, void* userData);
+
+  /// Stops watching the socket
+  /// Note: A concurrent Wait call may still output the socket's user data
+  void Remove(Status& status, const Socket& socket);
+
+  /// Waits up to the specified timeout for any watched socket to have incoming data
+  /// Outputs the user data of every ready socket (up to the maximum specified)
+  /// Returns the number of ready sockets (0 if the wait timed out or was woken, or if an error occurs, status will contain the error)
+  size_t Wait(Status& status, void** readyUserDataOut, size_t maxReady, uint timeoutMs);
+
+  /// Wakes the thread currently blocked in Wait
+  /// Safe to call from other threads
+  void Wake();
+
+  /// Platform poller data
+  ZeroDeclarePrivateData(SocketPoller, 16);
+};
+
 /// Queries the socket library for the current local socket address associated with the specified socket
 /// Returns the local address the socket is bound to, else SocketAddress()
 /// (Named getsockname on most platforms)
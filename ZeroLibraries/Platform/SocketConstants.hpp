@@ -55,6 +55,9 @@ static const size_t EthernetMtuBytes = 1500;
 /// IPv4 minimum reassembly buffer size
 static const size_t Ipv4MinMtuBytes  = 576;
 
+/// Maximum number of datagrams moved per batched send or receive system call
+static const size_t SocketBatchSize = 64;
+
 // TODO: Add more IPv6 constants
 
 } // namespace Zero
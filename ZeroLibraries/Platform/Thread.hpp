@@ -77,6 +77,11 @@ public:
   // Get the OsHandle to the thread.
   OsHandle GetThreadHandle();
 
+  // Restrict the thread to run on the processors set in the mask
+  // (bit 0 is the first logical processor). May be called before Resume.
+  // Returns false if the platform does not support affinity.
+  bool SetProcessorAffinity(u64 processorMask);
+
   // Template Helper for creating Entry Functions
   // From member functions
   template<typename classType, OsInt (classType::*MemberFunction)()>
@@ -89,7 +94,7 @@ public:
 
 private:
   String mThreadName;
-  ZeroDeclarePrivateData(Thread, 20);
+  ZeroDeclarePrivateData(Thread, 48);
 };
 
 }//namespace Zero
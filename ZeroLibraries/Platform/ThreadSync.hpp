@@ -24,7 +24,7 @@ public:
   void Unlock();
 
 private:
-  ZeroDeclarePrivateData(ThreadLock, 48);
+  ZeroDeclarePrivateData(ThreadLock, 64);
 };
 
 //Wrapper around an unnamed event.
@@ -31,6 +31,9 @@ ZeroShared void Sleep(uint ms);
 // Set the Timer Frequency (How often the OS checks threads for sleep, etc)
 ZeroShared void SetTimerFrequency(uint ms);
 
+// Get the number of logical processors available to this process.
+ZeroShared uint GetProcessorCount();
+
 // Get the user name for the current profile
 ZeroShared String UserName();
 
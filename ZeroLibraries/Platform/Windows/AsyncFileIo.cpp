@@ -0,0 +1,19 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AsyncFileIo.cpp
+/// Platform backend for the asynchronous file io service.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "Platform/AsyncFileIo.hpp"
+
+namespace Zero
+{
+
+AsyncFileBackend* CreatePlatformAsyncFileBackend()
+{
+  // Use the thread pool
+  return nullptr;
+}
+
+}//namespace Zero
@@ -9,29 +9,6 @@
 namespace Zero
 {
 
-DirectoryWatcher::DirectoryWatcher(cstr directoryToWatch, CallbackFunction callback, void* callbackInstance)
-{
-  ZeroCStringCopy(mDirectoryToWatch, File::MaxPath, directoryToWatch, strlen(directoryToWatch));
-
-  mCallbackInstance = callbackInstance;
-  mCallback = callback;
-
-  mWorkThread.Initialize(Thread::ObjectEntryCreator<DirectoryWatcher, &DirectoryWatcher::RunThreadEntryPoint>, this, "DirectoryWatcherWorker");
-  mWorkThread.Resume();
-  mCancelEvent.Initialize(true, false);
-}
-
-DirectoryWatcher::~DirectoryWatcher()
-{
-  Shutdown();
-}
-
-void DirectoryWatcher::Shutdown()
-{
-  mCancelEvent.Signal();
-  mWorkThread.WaitForCompletion();
-}
-
 OsInt DirectoryWatcher::RunThreadEntryPoint()
 {
   //Do not prevent others from using the directory.
@@ -77,6 +54,7 @@ OsInt DirectoryWatcher::RunThreadEntryPoint()
       byte* buffer = (byte*)fileNotifyBuffer;
 
       String lastRename;
+      Array<FileOperationInfo> operations;
 
       for(;;)
       {
@@ -95,15 +73,15 @@ OsInt DirectoryWatcher::RunThreadEntryPoint()
         {
         case FILE_ACTION_ADDED:
           info.Operation = Added;
-          (*mCallback)(mCallbackInstance, info);
+          operations.PushBack(info);
           break;
         case FILE_ACTION_REMOVED:
           info.Operation = Removed;
-          (*mCallback)(mCallbackInstance, info);
+          operations.PushBack(info);
           break;
         case FILE_ACTION_MODIFIED:
           info.Operation = Modified;
-          (*mCallback)(mCallbackInstance, info);
+          operations.PushBack(info);
           break;
         case FILE_ACTION_RENAMED_OLD_NAME:
           lastRename = info.FileName;
@@ -112,13 +90,14 @@ OsInt DirectoryWatcher::RunThreadEntryPoint()
           ErrorIf(lastRename.Empty(), "We didn't get an old name event.");
           info.Operation = Modified;
           info.OldFileName = lastRename;
-          (*mCallback)(mCallbackInstance, info);
+          operations.PushBack(info);
           break;
         }
 
         if(notify.NextEntryOffset ==0)
         {
-          //No more entries in this read.
+          //No more entries in this read, send them as one change set.
+          DispatchOperations(operations);
           break;
         }
         else
@@ -402,4 +402,112 @@ void File::Duplicate(Status& status, File& destinationFile) const
     WinReturnIfStatus(status);
 }
 
+//----------------------------------------------------------- Mapped File
+struct MappedFilePrivateData
+{
+  MappedFilePrivateData()
+  {
+    mMapping = NULL;
+    mData = nullptr;
+    mSize = 0;
+    mOpen = false;
+  }
+
+  HANDLE mMapping;
+  byte* mData;
+  size_t mSize;
+  bool mOpen;
+};
+
+MappedFile::MappedFile()
+{
+  ZeroConstructPrivateData(MappedFilePrivateData);
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+  ZeroDestructPrivateData(MappedFilePrivateData);
+}
+
+bool MappedFile::Open(Status& status, StringParam filePath, FileAccessPattern::Enum accessPattern)
+{
+  Close();
+  ZeroGetPrivateData(MappedFilePrivateData);
+
+  DWORD flags = accessPattern == FileAccessPattern::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+  HANDLE fileHandle = ::CreateFileW(Widen(filePath).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                    NOSECURITY, OPEN_EXISTING, flags, NULL);
+  if(fileHandle == INVALID_HANDLE_VALUE)
+  {
+    FillWindowsErrorStatus(status);
+    return false;
+  }
+
+  LARGE_INTEGER fileSize;
+  if(!::GetFileSizeEx(fileHandle, &fileSize))
+  {
+    FillWindowsErrorStatus(status);
+    ::CloseHandle(fileHandle);
+    return false;
+  }
+
+  // Mapping an empty file fails, an empty file is just an empty block
+  if(fileSize.QuadPart != 0)
+  {
+    self->mMapping = ::CreateFileMappingW(fileHandle, NOSECURITY, PAGE_READONLY, 0, 0, NULL);
+    if(self->mMapping != NULL)
+      self->mData = (byte*)::MapViewOfFile(self->mMapping, FILE_MAP_READ, 0, 0, 0);
+
+    if(self->mData == nullptr)
+    {
+      FillWindowsErrorStatus(status);
+      if(self->mMapping != NULL)
+        ::CloseHandle(self->mMapping);
+      self->mMapping = NULL;
+      ::CloseHandle(fileHandle);
+      return false;
+    }
+  }
+
+  // The mapping keeps its own reference to the file
+  ::CloseHandle(fileHandle);
+
+  self->mSize = (size_t)fileSize.QuadPart;
+  self->mOpen = true;
+  return true;
+}
+
+void MappedFile::Close()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  if(self->mData != nullptr)
+    ::UnmapViewOfFile(self->mData);
+  if(self->mMapping != NULL)
+    ::CloseHandle(self->mMapping);
+
+  self->mMapping = NULL;
+  self->mData = nullptr;
+  self->mSize = 0;
+  self->mOpen = false;
+}
+
+bool MappedFile::IsOpen()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  return self->mOpen;
+}
+
+DataBlock MappedFile::GetBlock()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  return DataBlock(self->mData, self->mSize);
+}
+
+size_t MappedFile::Size()
+{
+  ZeroGetPrivateData(MappedFilePrivateData);
+  return self->mSize;
+}
+
 }//namespace Zero
@@ -1304,6 +1304,51 @@ bool Socket::Select(Status& status, SocketSelect::Enum selectMode, float timeout
   return (result != 0);
 }
 
+size_t Socket::SendToBatch(Status& status, const SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // Winsock has no batched datagram send, send each datagram individually
+  for(size_t i = 0; i < datagramCount; ++i)
+  {
+    const SocketDatagram& datagram = datagrams[i];
+    SendTo(status, datagram.mData, datagram.mLength, datagram.mAddress, flags);
+    if(status.Failed()) // Unable?
+      return i;
+  }
+
+  // Success
+  return datagramCount;
+}
+
+size_t Socket::ReceiveFromBatch(Status& status, SocketDatagram* datagrams, size_t datagramCount, SocketFlags::Enum flags)
+{
+  // Winsock has no batched datagram receive, receive individually while data is immediately available
+  size_t receivedCount = 0;
+  while(receivedCount < datagramCount)
+  {
+    // Only the first receive may block
+    if(receivedCount != 0)
+    {
+      Status selectStatus;
+      if(!Select(selectStatus, SocketSelect::Read, 0.0f)) // Nothing more to receive?
+        break;
+    }
+
+    SocketDatagram& datagram = datagrams[receivedCount];
+    datagram.mLength = ReceiveFrom(status, datagram.mData, datagram.mCapacity, datagram.mAddress, flags);
+    if(status.Failed()) // Unable?
+    {
+      // Report the error only if nothing was received
+      if(receivedCount != 0)
+        status = Status();
+      break;
+    }
+
+    ++receivedCount;
+  }
+
+  return receivedCount;
+}
+
 void Socket::GetSocketOption(Status& status, SocketOption::Enum option, void* value, size_t* valueLength) const
 {
   Assert(valueLength && *valueLength, "valueLength must contain the non-zero size of the value parameter");
@@ -1480,4 +1525,140 @@ SocketAddress QueryRemoteSocketAddress(Status& status, const Socket& socket)
   return address;
 }
 
+//---------------------------------------------------------------------------------//
+//                                 SocketPoller                                    //
+//---------------------------------------------------------------------------------//
+
+struct WindowsSocketPoller
+{
+  /// Poll descriptors, the first entry is always the wake socket
+  Array<WSAPOLLFD> mPollFds;
+  /// User data of each poll descriptor
+  Array<void*>     mUserData;
+  /// Poll descriptors and user data thread lock
+  ThreadLock       mLock;
+  /// Loopback socket a datagram is sent to in order to wake the waiting thread
+  Socket           mWakeSocket;
+  /// Local address of the wake socket
+  SocketAddress    mWakeAddress;
+};
+
+SocketPoller::SocketPoller()
+{
+  ZeroConstructPrivateData(WindowsSocketPoller*);
+  *self = new WindowsSocketPoller();
+  WindowsSocketPoller* poller = *self;
+
+  // Open the wake socket on loopback (Winsock cannot poll events)
+  Status status;
+  poller->mWakeSocket.Open(status, SocketAddressFamily::InternetworkV4, SocketType::Datagram, SocketProtocol::Udp);
+  if(status.Succeeded())
+    poller->mWakeSocket.Bind(status, StringToIpv4Address("127.0.0.1", AnyPort));
+  if(status.Succeeded())
+    poller->mWakeSocket.SetBlocking(status, false);
+  ErrorIf(status.Failed(), "Unable to create socket poller (%d : %s)", status.ExtendedErrorCode, status.Message.c_str());
+  poller->mWakeAddress = poller->mWakeSocket.GetBoundLocalAddress();
+
+  WSAPOLLFD wakeFd = {};
+  wakeFd.fd     = CAST_HANDLE_TO_SOCKET(poller->mWakeSocket.mHandle);
+  wakeFd.events = POLLRDNORM;
+  poller->mPollFds.PushBack(wakeFd);
+  poller->mUserData.PushBack(nullptr);
+}
+
+SocketPoller::~SocketPoller()
+{
+  ZeroGetPrivateData(WindowsSocketPoller*);
+  delete *self;
+  ZeroDestructPrivateData(WindowsSocketPoller*);
+}
+
+void SocketPoller::Add(Status& status, const Socket& socket, void* userData)
+{
+  ZeroGetPrivateData(WindowsSocketPoller*);
+  WindowsSocketPoller* poller = *self;
+
+  WSAPOLLFD pollFd = {};
+  pollFd.fd     = CAST_HANDLE_TO_SOCKET(socket.mHandle);
+  pollFd.events = POLLRDNORM;
+
+  poller->mLock.Lock();
+  poller->mPollFds.PushBack(pollFd);
+  poller->mUserData.PushBack(userData);
+  poller->mLock.Unlock();
+
+  // Wake the waiting thread so it polls the new socket
+  Wake();
+}
+
+void SocketPoller::Remove(Status& status, const Socket& socket)
+{
+  ZeroGetPrivateData(WindowsSocketPoller*);
+  WindowsSocketPoller* poller = *self;
+
+  poller->mLock.Lock();
+  for(size_t i = 1; i < poller->mPollFds.Size(); ++i)
+  {
+    if(poller->mPollFds[i].fd == CAST_HANDLE_TO_SOCKET(socket.mHandle))
+    {
+      poller->mPollFds.EraseAt(i);
+      poller->mUserData.EraseAt(i);
+      break;
+    }
+  }
+  poller->mLock.Unlock();
+}
+
+size_t SocketPoller::Wait(Status& status, void** readyUserDataOut, size_t maxReady, uint timeoutMs)
+{
+  ZeroGetPrivateData(WindowsSocketPoller*);
+  WindowsSocketPoller* poller = *self;
+
+  // Poll a copy so sockets can be added and removed while waiting
+  poller->mLock.Lock();
+  Array<WSAPOLLFD> pollFds = poller->mPollFds;
+  Array<void*>     userData = poller->mUserData;
+  poller->mLock.Unlock();
+
+  // Wait for incoming data on any watched socket
+  int result = WSAPoll(pollFds.Data(), (ULONG)pollFds.Size(), (INT)timeoutMs);
+  if(result == SOCKET_ERROR) // Unable?
+  {
+    FailOnLastError(status);
+    return 0;
+  }
+
+  // Woken up?
+  if(pollFds[0].revents != 0)
+  {
+    // Drain the wake socket
+    byte buffer[16];
+    SocketAddress from;
+    Status drainStatus;
+    while(poller->mWakeSocket.ReceiveFrom(drainStatus, buffer, sizeof(buffer), from) != 0)
+      continue;
+  }
+
+  // Output ready sockets
+  size_t readyCount = 0;
+  for(size_t i = 1; i < pollFds.Size() && readyCount < maxReady; ++i)
+  {
+    if(pollFds[i].revents != 0)
+      readyUserDataOut[readyCount++] = userData[i];
+  }
+
+  // Success
+  return readyCount;
+}
+
+void SocketPoller::Wake()
+{
+  ZeroGetPrivateData(WindowsSocketPoller*);
+  WindowsSocketPoller* poller = *self;
+
+  byte wake = 1;
+  Status status;
+  poller->mWakeSocket.SendTo(status, &wake, sizeof(wake), poller->mWakeAddress);
+}
+
 } // namespace Zero
@@ -55,6 +55,23 @@ namespace Zero
 {
 const bool ThreadingEnabled = true;
 
+// Passed to the thread so that per thread memory can be released after the entry returns
+struct ThreadStartData
+{
+  Thread::EntryFunction mEntry;
+  void* mInstance;
+};
+
+DWORD WINAPI WindowsThreadEntry(LPVOID data)
+{
+  ThreadStartData startData = *(ThreadStartData*)data;
+  delete (ThreadStartData*)data;
+
+  OsInt exitCode = startData.mEntry(startData.mInstance);
+  Memory::ReleaseThreadMemory();
+  return (DWORD)exitCode;
+}
+
 struct ThreadPrivateData
 {
   OsInt mThreadId;
@@ -81,17 +98,31 @@ OsHandle Thread::GetThreadHandle()
   return self->mHandle;
 }
 
+bool Thread::SetProcessorAffinity(u64 processorMask)
+{
+  ZeroGetPrivateData(ThreadPrivateData);
+  if(!IsValid())
+    return false;
+
+  DWORD_PTR previousMask = SetThreadAffinityMask(self->mHandle, (DWORD_PTR)processorMask);
+  return previousMask != 0;
+}
+
 bool Thread::Initialize(EntryFunction entry, void* instance, StringParam threadName, ThreadConfig* config)
 {
   ZeroGetPrivateData(ThreadPrivateData);
 
   mThreadName = threadName;
 
+  ThreadStartData* startData = new ThreadStartData();
+  startData->mEntry = entry;
+  startData->mInstance = instance;
+
   const int cStackSize = 65536;
   self->mHandle = ::CreateThread( NULL, //No Security
                            cStackSize,
-                           (LPTHREAD_START_ROUTINE)entry,
-                           (LPVOID)instance, 
+                           &WindowsThreadEntry,
+                           (LPVOID)startData, 
                            CREATE_SUSPENDED,
                            &self->mThreadId);
 
@@ -105,6 +136,7 @@ bool Thread::Initialize(EntryFunction entry, void* instance, StringParam threadN
   }
   else
   {
+    delete startData;
     self->mHandle = NULL;
     return false;
   }
@@ -33,6 +33,13 @@ void SetTimerFrequency(uint ms)
   ::timeBeginPeriod(ms);
 }
 
+uint GetProcessorCount()
+{
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  return (uint)systemInfo.dwNumberOfProcessors;
+}
+
 String UserName()
 {
   wchar_t buffer[UNLEN + 1];
@@ -78,6 +78,21 @@ void BinaryBufferLoader::SetBlock(DataBlock block)
   mBuffer = block.Data;
 }
 
+bool BinaryBufferLoader::OpenFile(Status& status, cstr filename)
+{
+  if(!mMappedFile.Open(status, filename, FileAccessPattern::Sequential))
+    return false;
+
+  SetBlock(mMappedFile.GetBlock());
+  return true;
+}
+
+void BinaryBufferLoader::Close()
+{
+  SetBuffer(nullptr, 0);
+  mMappedFile.Close();
+}
+
 bool BinaryBufferLoader::TestForObjectEnd(BoundType** data)
 {
   size_t bytesToRead = sizeof(*data);
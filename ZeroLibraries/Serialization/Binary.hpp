@@ -247,6 +247,10 @@ public:
   void SetBuffer(byte* data, uint size);
   void SetBlock(DataBlock block);
 
+  /// Maps the file and reads directly from the mapped pages (no copy into a buffer).
+  bool OpenFile(Status& status, cstr filename);
+  void Close();
+
   void Data(byte* data, uint size);
   bool TestForObjectEnd(BoundType** runtimeType);
 
@@ -254,6 +258,8 @@ private:
   uint mBufferSize;
   byte* mCurrentPosition;
   byte* mBuffer;
+  // Only open when loading through OpenFile
+  MappedFile mMappedFile;
 };
 
 }//namespace Zero
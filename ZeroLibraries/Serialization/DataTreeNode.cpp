@@ -15,7 +15,7 @@ namespace Zero
 DataNode* FindMatchingChildNode(DataNode* parent, DataNode* nodeToMatch, uint childIndex);
 
 //-------------------------------------------------------------------- Data Node
-Memory::Pool* DataNode::sPool = new Memory::Pool("DataTree", Memory::GetRoot(), sizeof(DataNode), 5000);
+Memory::ConcurrentPool* DataNode::sPool = new Memory::ConcurrentPool("DataTree", Memory::GetRoot(), sizeof(DataNode), 5000);
 
 //******************************************************************************
 void* DataNode::operator new(size_t size)
@@ -12,7 +12,7 @@
 namespace Zero
 {
 
-namespace Memory{class Pool;}
+namespace Memory{class ConcurrentPool;}
 
 // Forward Declarations
 class DataNode;
@@ -107,7 +107,7 @@ public:
   typedef InList<DataNode> DataNodeList;
 
   /// Custom memory allocation.
-  static Memory::Pool* sPool;
+  static Memory::ConcurrentPool* sPool;
   static void* operator new(size_t size);
   static void operator delete(void* pMem, size_t size);
 
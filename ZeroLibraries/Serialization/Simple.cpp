@@ -79,9 +79,14 @@ Serializer* GetLoaderStreamFile(Status& status, StringParam fileName, DataFileFo
     }
     else
     {
-      //Binary Data File load using BinaryFileLoader
-      BinaryFileLoader* loader = new BinaryFileLoader();
+      //Binary Data File load directly from the mapped file
+      BinaryBufferLoader* loader = new BinaryBufferLoader();
       loader->OpenFile(status, fileName.c_str());
+      if(status.Failed())
+      {
+        delete loader;
+        return NULL;
+      }
       return loader;
     }
   }
@@ -16,7 +16,7 @@
 namespace Zero
 {
 
-namespace Memory{class Pool;}
+namespace Memory{class ConcurrentPool;}
 
 ///Node used for the Avl balanced dynamic aabb tree. Different from the static
 ///tree node because we need a parent pointer. Different from the normal
@@ -27,7 +27,7 @@ struct AvlDynamicTreeNode
   AvlDynamicTreeNode();
   ~AvlDynamicTreeNode();
 
-  static Memory::Pool* sDynamicNodePool;
+  static Memory::ConcurrentPool* sDynamicNodePool;
   static void* operator new(size_t size);
   static void operator delete(void* pMem, size_t size);
 
@@ -35,9 +35,9 @@ AvlDynamicTreeNode<ClientDataType>::~AvlDynamicTreeNode()
 }
 
 template <typename ClientDataType>
-Memory::Pool* AvlDynamicTreeNode<ClientDataType>::sDynamicNodePool =
-  new Memory::Pool("DynamicNodes", Memory::GetNamedHeap("BroadPhase"),
-                    sizeof(AvlDynamicTreeNode<ClientDataType>), 200);
+Memory::ConcurrentPool* AvlDynamicTreeNode<ClientDataType>::sDynamicNodePool =
+  new Memory::ConcurrentPool("DynamicNodes", Memory::GetNamedHeap("BroadPhase"),
+                                     sizeof(AvlDynamicTreeNode<ClientDataType>), 200);
 
 template <typename ClientDataType>
 void* AvlDynamicTreeNode<ClientDataType>::operator new(size_t size)
@@ -189,7 +189,8 @@ typedef BaseBroadPhaseObject<void*> BroadPhaseObject;
 typedef BaseClientPair<void*> ClientPair;
 typedef BaseBroadPhaseDataPair<void*> BroadPhaseDataPair;
 
-typedef Array<BroadPhaseData> BroadPhaseDataArray;
+// Batch query input is rebuilt every frame
+typedef Array<BroadPhaseData, FrameAllocator> BroadPhaseDataArray;
 typedef Array<BroadPhaseProxy*> ProxyHandleArray;
 typedef Array<BroadPhaseObject> BroadPhaseObjectArray;
 typedef Array<ClientPair> ClientPairArray;
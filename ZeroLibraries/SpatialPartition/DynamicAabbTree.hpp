@@ -16,7 +16,7 @@
 namespace Zero
 {
 
-namespace Memory{class Pool;}
+namespace Memory{class ConcurrentPool;}
 
 ///Node used for the dynamic aabb tree. Different from the static
 ///tree node because we need a parent pointer.
@@ -26,7 +26,7 @@ struct DynamicTreeNode
   DynamicTreeNode();
   ~DynamicTreeNode();
 
-  static Memory::Pool* sDynamicNodePool;
+  static Memory::ConcurrentPool* sDynamicNodePool;
   static void* operator new(size_t size);
   static void operator delete(void* pMem, size_t size);
 
@@ -34,9 +34,9 @@ DynamicTreeNode<ClientDataType>::~DynamicTreeNode()
 }
 
 template <typename ClientDataType>
-Memory::Pool* DynamicTreeNode<ClientDataType>::sDynamicNodePool =
-  new Memory::Pool("DynamicNodes", Memory::GetNamedHeap("BroadPhase"),
-                   sizeof(DynamicTreeNode<ClientDataType>), 200);
+Memory::ConcurrentPool* DynamicTreeNode<ClientDataType>::sDynamicNodePool =
+  new Memory::ConcurrentPool("DynamicNodes", Memory::GetNamedHeap("BroadPhase"),
+                                     sizeof(DynamicTreeNode<ClientDataType>), 200);
 
 template <typename ClientDataType>
 void* DynamicTreeNode<ClientDataType>::operator new(size_t size)
@@ -0,0 +1,355 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AllocationProfiler.cpp
+/// Implementation of the sampling allocation profiler.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "AllocationProfiler.hpp"
+#include "Profiler.hpp"
+#include "Platform/DebugSymbolInformation.hpp"
+#include "Platform/File.hpp"
+
+// The memory graph calls the sampler on the allocating thread about once every
+// sample interval bytes. A sample captures the call stack without looking up
+// any symbols and adds it to the call site for that stack, graph node and
+// profile scope. Once a frame the sites sampled that frame are written out,
+// symbols are only looked up the first time a site is written.
+//
+// File format (text, one record per line):
+//   site <id> node <graph node> scope <profile scope>
+//     <address> <module> <symbol>        (one line per stack frame)
+//   frame <number> samples <count> bytes <bytes>
+//     <site id> <samples> <bytes>        (one line per site, most bytes first)
+//   total site <id> samples <count> bytes <bytes>  (written when stopped)
+// Bytes are estimates, each sample stands for the bytes allocated since the
+// previous sample on that thread.
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+// Stack frames kept for each sample
+const size_t cMaxAllocationSampleFrames = 24;
+// Frames for GetStackAddresses, the sampler, Graph::SampleAllocation and
+// Graph::AddAllocation (the allocator's own frame is kept to show the node type)
+const size_t cAllocationSamplerFrames = 4;
+
+struct AllocationSite
+{
+  void* Addresses[cMaxAllocationSampleFrames];
+  size_t FrameCount;
+  Memory::Graph* Node;
+  Record* Scope;
+  // Samples taken this frame
+  size_t FrameSamples;
+  u64 FrameBytes;
+  // Samples taken since the profiler was started
+  size_t TotalSamples;
+  u64 TotalBytes;
+  // Whether the site's call stack has been written to the file
+  bool Written;
+};
+
+// A copy of a site sampled this frame, taken so it can be written without the lock
+struct SampledAllocationSite
+{
+  uint Index;
+  AllocationSite Site;
+};
+
+struct AllocationProfilerState
+{
+  // Guards the sites, held by the sampler
+  SpinLock Lock;
+  // Guards the output and is held while writing, the sampler never takes it
+  SpinLock OutputLock;
+  bool Active;
+  File Output;
+  size_t SampleInterval;
+  u64 Frame;
+  // Index of each call site by the hash of its stack, node and scope
+  HashMap<u64, uint> SiteIndices;
+  Array<AllocationSite> Sites;
+  // Sites that were sampled this frame
+  Array<uint> FrameSites;
+  // Copies of the sites sampled in the frame being written
+  Array<SampledAllocationSite> WritingSites;
+};
+
+// Created the first time the profiler is started and never deleted, another
+// thread may still be in the sampler after the profiler is stopped
+AllocationProfilerState* gAllocationProfiler = nullptr;
+
+// Set while the profiler writes so its own allocations are not sampled
+ZeroThreadLocal bool tWritingAllocationProfile = false;
+
+u64 HashAllocationSite(void** addresses, size_t frameCount, Memory::Graph* node, Record* scope)
+{
+  // FNV-1a over the pointers
+  u64 hash = 14695981039346656037ull;
+  for(size_t i = 0; i < frameCount; ++i)
+    hash = (hash ^ u64(addresses[i])) * 1099511628211ull;
+  hash = (hash ^ u64(node)) * 1099511628211ull;
+  hash = (hash ^ u64(scope)) * 1099511628211ull;
+  return hash;
+}
+
+bool IsSameAllocationSite(AllocationSite& site, void** addresses, size_t frameCount, Memory::Graph* node, Record* scope)
+{
+  return site.Node == node && site.Scope == scope && site.FrameCount == frameCount &&
+         memcmp(site.Addresses, addresses, frameCount * sizeof(void*)) == 0;
+}
+
+// Must be called with the lock held
+uint FindOrAddAllocationSite(AllocationProfilerState* profiler, void** addresses, size_t frameCount,
+                             Memory::Graph* node, Record* scope)
+{
+  // Hash collisions move on to the next key
+  u64 key = HashAllocationSite(addresses, frameCount, node, scope);
+  for(;;)
+  {
+    uint* index = profiler->SiteIndices.FindPointer(key);
+    if(index == nullptr)
+      break;
+    if(IsSameAllocationSite(profiler->Sites[*index], addresses, frameCount, node, scope))
+      return *index;
+    ++key;
+  }
+
+  uint index = profiler->Sites.Size();
+  AllocationSite& site = profiler->Sites.PushBack();
+  memset(&site, 0, sizeof(site));
+  memcpy(site.Addresses, addresses, frameCount * sizeof(void*));
+  site.FrameCount = frameCount;
+  site.Node = node;
+  site.Scope = scope;
+  profiler->SiteIndices.Insert(key, index);
+  return index;
+}
+
+void SampleAllocation(Memory::Graph* node, size_t bytes, size_t sampledBytes)
+{
+  AllocationProfilerState* profiler = gAllocationProfiler;
+  if(profiler == nullptr || tWritingAllocationProfile)
+    return;
+
+  CallStackAddresses callStack;
+  GetStackAddresses(callStack, cMaxAllocationSampleFrames, cAllocationSamplerFrames);
+  Record* scope = GetActiveRecord();
+
+  profiler->Lock.Lock();
+  if(profiler->Active)
+  {
+    uint index = FindOrAddAllocationSite(profiler, callStack.mAddresses, callStack.mCaptureFrameCount, node, scope);
+    AllocationSite& site = profiler->Sites[index];
+    if(site.FrameSamples == 0)
+      profiler->FrameSites.PushBack(index);
+
+    ++site.FrameSamples;
+    site.FrameBytes += sampledBytes;
+    ++site.TotalSamples;
+    site.TotalBytes += sampledBytes;
+  }
+  profiler->Lock.Unlock();
+}
+
+void WriteAllocationProfile(AllocationProfilerState* profiler, StringBuilder& builder)
+{
+  String text = builder.ToString();
+  profiler->Output.Write((byte*)text.Data(), text.SizeInBytes());
+}
+
+// Appends the call stack of every copied site that had not been written yet
+void WriteNewAllocationSites(Array<SampledAllocationSite>& sampledSites, StringBuilder& builder)
+{
+  CallStackAddresses callStack;
+  CallStackSymbolInfos* symbols = nullptr;
+
+  for(uint i = 0; i < sampledSites.Size(); ++i)
+  {
+    uint index = sampledSites[i].Index;
+    AllocationSite& site = sampledSites[i].Site;
+    if(site.Written)
+      continue;
+
+    if(symbols == nullptr)
+      symbols = new CallStackSymbolInfos();
+
+    memcpy(callStack.mAddresses, site.Addresses, site.FrameCount * sizeof(void*));
+    callStack.mCaptureFrameCount = site.FrameCount;
+    GetStackInfo(callStack, *symbols);
+
+    cstr scopeName = site.Scope ? site.Scope->GetName() : "None";
+    builder.AppendFormat("site %u node %s scope %s\n", index, site.Node->GetName(), scopeName);
+    for(size_t frame = 0; frame < symbols->mCaptureSymbolCount; ++frame)
+    {
+      SymbolInfo& symbol = symbols->mSymbols[frame];
+      cstr moduleName = symbol.mModuleName.Empty() ? "?" : symbol.mModuleName.c_str();
+      cstr symbolName = symbol.mSymbolName.Empty() ? "?" : symbol.mSymbolName.c_str();
+      builder.AppendFormat("  %p %s %s\n", symbol.mAddress, moduleName, symbolName);
+    }
+  }
+
+  delete symbols;
+}
+
+struct SortAllocationSitesByFrameBytes
+{
+  bool operator()(const SampledAllocationSite& left, const SampledAllocationSite& right)
+  {
+    return left.Site.FrameBytes > right.Site.FrameBytes;
+  }
+};
+
+bool StartAllocationProfiler(StringParam fileName, size_t sampleInterval)
+{
+  if(gAllocationProfiler == nullptr)
+  {
+    gAllocationProfiler = new AllocationProfilerState();
+    gAllocationProfiler->Active = false;
+  }
+
+  AllocationProfilerState* profiler = gAllocationProfiler;
+  if(profiler->Active)
+    StopAllocationProfiler();
+
+  if(sampleInterval == 0)
+    sampleInterval = cDefaultAllocationSampleInterval;
+
+  tWritingAllocationProfile = true;
+  profiler->OutputLock.Lock();
+  profiler->Lock.Lock();
+
+  bool opened = profiler->Output.Open(fileName, FileMode::Write, FileAccessPattern::Sequential);
+  if(opened)
+  {
+    profiler->Active = true;
+    profiler->SampleInterval = sampleInterval;
+    profiler->Frame = 0;
+
+    StringBuilder builder;
+    builder.AppendFormat("# Allocation profile, one sample about every %u bytes\n", (uint)sampleInterval);
+    WriteAllocationProfile(profiler, builder);
+  }
+
+  profiler->Lock.Unlock();
+  profiler->OutputLock.Unlock();
+  tWritingAllocationProfile = false;
+
+  if(!opened)
+  {
+    ZPrint("Failed to open allocation profile '%s'.\n", fileName.c_str());
+    return false;
+  }
+
+  Memory::SetAllocationSampler(SampleAllocation, sampleInterval);
+  return true;
+}
+
+void StopAllocationProfiler()
+{
+  AllocationProfilerState* profiler = gAllocationProfiler;
+  if(profiler == nullptr || !profiler->Active)
+    return;
+
+  Memory::SetAllocationSampler(nullptr, 0);
+
+  // Samples from the last frame are written before the totals
+  EndAllocationProfilerFrame();
+
+  tWritingAllocationProfile = true;
+  profiler->OutputLock.Lock();
+  profiler->Lock.Lock();
+
+  StringBuilder builder;
+  for(uint i = 0; i < profiler->Sites.Size(); ++i)
+  {
+    AllocationSite& site = profiler->Sites[i];
+    builder.AppendFormat("total site %u samples %u bytes %llu\n", i, (uint)site.TotalSamples, (unsigned long long)site.TotalBytes);
+  }
+  WriteAllocationProfile(profiler, builder);
+
+  profiler->Output.Close();
+  profiler->Active = false;
+  profiler->SiteIndices.Clear();
+  profiler->Sites.Clear();
+  profiler->FrameSites.Clear();
+
+  profiler->Lock.Unlock();
+  profiler->OutputLock.Unlock();
+  tWritingAllocationProfile = false;
+}
+
+bool IsAllocationProfilerActive()
+{
+  return gAllocationProfiler != nullptr && gAllocationProfiler->Active;
+}
+
+void EndAllocationProfilerFrame()
+{
+  AllocationProfilerState* profiler = gAllocationProfiler;
+  if(profiler == nullptr || !profiler->Active)
+    return;
+
+  tWritingAllocationProfile = true;
+  profiler->OutputLock.Lock();
+
+  // Copy out the sites sampled this frame and reset them, the sampler only waits on the copy.
+  // Symbols are looked up and the frame is written after the lock is released.
+  Array<SampledAllocationSite>& sampledSites = profiler->WritingSites;
+  sampledSites.Clear();
+
+  profiler->Lock.Lock();
+  u64 frame = profiler->Frame++;
+  sampledSites.Resize(profiler->FrameSites.Size());
+  for(uint i = 0; i < profiler->FrameSites.Size(); ++i)
+  {
+    uint index = profiler->FrameSites[i];
+    AllocationSite& site = profiler->Sites[index];
+    sampledSites[i].Index = index;
+    sampledSites[i].Site = site;
+
+    site.FrameSamples = 0;
+    site.FrameBytes = 0;
+    site.Written = true;
+  }
+  profiler->FrameSites.Clear();
+  profiler->Lock.Unlock();
+
+  if(!sampledSites.Empty())
+  {
+    StringBuilder builder;
+    WriteNewAllocationSites(sampledSites, builder);
+
+    size_t frameSamples = 0;
+    u64 frameBytes = 0;
+    for(uint i = 0; i < sampledSites.Size(); ++i)
+    {
+      frameSamples += sampledSites[i].Site.FrameSamples;
+      frameBytes += sampledSites[i].Site.FrameBytes;
+    }
+
+    Sort(sampledSites.All(), SortAllocationSitesByFrameBytes());
+
+    builder.AppendFormat("frame %llu samples %u bytes %llu\n", (unsigned long long)frame,
+                         (uint)frameSamples, (unsigned long long)frameBytes);
+    for(uint i = 0; i < sampledSites.Size(); ++i)
+    {
+      AllocationSite& site = sampledSites[i].Site;
+      builder.AppendFormat("  %u %u %llu\n", sampledSites[i].Index, (uint)site.FrameSamples, (unsigned long long)site.FrameBytes);
+    }
+
+    WriteAllocationProfile(profiler, builder);
+    profiler->Output.Flush();
+  }
+
+  profiler->OutputLock.Unlock();
+  tWritingAllocationProfile = false;
+}
+
+}//namespace Profile
+
+}//namespace Zero
@@ -0,0 +1,38 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file AllocationProfiler.hpp
+/// Declaration of the sampling allocation profiler.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Utility/Typedefs.hpp"
+#include "String/String.hpp"
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+/// Bytes allocated between samples when no interval is given.
+const size_t cDefaultAllocationSampleInterval = 512 * 1024;
+
+/// Starts sampling allocations made through the memory graph. About once every
+/// sampleInterval bytes the call stack is captured along with the memory graph
+/// node being allocated from and the innermost ProfileScope on that thread.
+/// Samples are grouped by call site and appended to the file once per frame.
+/// Returns false if the file could not be opened.
+bool StartAllocationProfiler(StringParam fileName, size_t sampleInterval = cDefaultAllocationSampleInterval);
+
+/// Writes the totals for every call site and closes the file.
+void StopAllocationProfiler();
+
+bool IsAllocationProfilerActive();
+
+/// Writes out the samples taken since the last call as one frame (called once per engine update).
+void EndAllocationProfilerFrame();
+
+}//namespace Profile
+
+}//namespace Zero
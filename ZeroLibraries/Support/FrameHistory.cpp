@@ -0,0 +1,309 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file FrameHistory.cpp
+/// Implementation of the frame history that writes out frame spikes.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "FrameHistory.hpp"
+#include "TraceRecorder.hpp"
+#include "ProfileCounter.hpp"
+#include "Platform/File.hpp"
+#include "Platform/FilePath.hpp"
+#include "Platform/FileSystem.hpp"
+
+// The scopes come from the same per thread buffers as the trace recorder, which
+// hands them over as it drains the buffers on the main thread. Frames are kept
+// in a ring and a frame's scope array keeps its capacity when the slot is reused,
+// so recording a steady frame doesn't allocate. Everything here runs on the main
+// thread so nothing is locked. The time spent writing a spike file falls between
+// two frames rather than in either of them.
+//
+// A spike file is a Chrome trace with an extra "Frames" row (thread 0) that has a
+// bar for each frame with its memory counts in the args, followed by the frame's
+// profile counters (the same events the trace recorder writes):
+//   {"name":"Frame","ph":"X","ts":<us>,"dur":<us>,"pid":1,"tid":0,
+//    "args":{"frame":<number>,"allocations":<count>,"activeBytes":<bytes>}}
+//   {"name":"<counter>","ph":"C","ts":<us>,"pid":1,"args":{"value":<frame value>}}
+// Times are in microseconds from the start of the first frame in the file.
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+volatile bool gFrameHistoryActive = false;
+
+struct HistoryScope
+{
+  Record* Scope;
+  ProfileTime Start;
+  ProfileTime End;
+  uint ThreadId;
+};
+
+struct HistoryCounter
+{
+  CounterRecord* Counter;
+  s64 Value;
+};
+
+struct HistoryFrame
+{
+  u64 Number;
+  ProfileTime Start;
+  ProfileTime End;
+  // Allocations made during the frame
+  u64 Allocations;
+  // Bytes allocated at the end of the frame
+  u64 ActiveBytes;
+  Array<HistoryCounter> Counters;
+  Array<HistoryScope> Scopes;
+};
+
+struct FrameHistoryState
+{
+  String Directory;
+  float Budget;
+  uint Neighbors;
+  // Ring of the last frames, the frame being recorded is at Frame % Size
+  Array<HistoryFrame> Frames;
+  u64 Frame;
+  ProfileTime FrameStart;
+  MemCounterType LastAllocations;
+  // Slow frames waiting for the frames after them to be recorded
+  Array<u64> PendingSpikes;
+  // Later spikes up to this frame are already in a pending spike's file
+  bool HasSpike;
+  u64 CoveredThrough;
+  uint SpikeCount;
+};
+
+// Created the first time the history is started
+FrameHistoryState* gFrameHistory = nullptr;
+
+HistoryFrame& GetHistoryFrame(u64 number)
+{
+  return gFrameHistory->Frames[uint(number % gFrameHistory->Frames.Size())];
+}
+
+void BeginHistoryFrame(FrameHistoryState* history, ProfileTime startTime)
+{
+  HistoryFrame& frame = GetHistoryFrame(history->Frame);
+  frame.Number = history->Frame;
+  frame.Start = startTime;
+  frame.End = startTime;
+  frame.Allocations = 0;
+  frame.ActiveBytes = 0;
+  frame.Counters.Clear();
+  frame.Scopes.Clear();
+
+  history->FrameStart = startTime;
+}
+
+void AddFrameHistoryScope(Record* record, ProfileTime startTime, ProfileTime endTime, uint threadId)
+{
+  HistoryScope& scope = GetHistoryFrame(gFrameHistory->Frame).Scopes.PushBack();
+  scope.Scope = record;
+  scope.Start = startTime;
+  scope.End = endTime;
+  scope.ThreadId = threadId;
+}
+
+double GetHistoryTime(ProfileTime time, ProfileTime baseTime)
+{
+  if(time < baseTime)
+    return 0.0;
+  return ProfileSystem::Instance->GetTimeInMicroseconds(time - baseTime);
+}
+
+// Writes the spike frame and the neighbors on each side of it (as many as are still kept)
+void WriteFrameSpike(FrameHistoryState* history, u64 spike)
+{
+  u64 lastRecorded = history->Frame;
+  u64 kept = history->Frames.Size();
+  u64 oldest = lastRecorded + 1 > kept ? lastRecorded + 1 - kept : 0;
+
+  u64 first = spike > history->Neighbors ? spike - history->Neighbors : 0;
+  first = Math::Max(first, oldest);
+  u64 last = Math::Min(spike + history->Neighbors, lastRecorded);
+
+  ProfileTime baseTime = GetHistoryFrame(first).Start;
+
+  StringBuilder builder;
+  builder.Append("{\"traceEvents\":[\n");
+  builder.Append("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}},\n");
+  AppendTraceThreadNames(builder, ",\n");
+
+  for(u64 number = first; number <= last; ++number)
+  {
+    HistoryFrame& frame = GetHistoryFrame(number);
+    double start = GetHistoryTime(frame.Start, baseTime);
+    double end = GetHistoryTime(frame.End, baseTime);
+    builder.AppendFormat("{\"name\":\"Frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":0,"
+                         "\"args\":{\"frame\":%llu,\"allocations\":%llu,\"activeBytes\":%llu}}",
+                         start, end - start, (unsigned long long)frame.Number, (unsigned long long)frame.Allocations,
+                         (unsigned long long)frame.ActiveBytes);
+
+    forRange(HistoryCounter& counter, frame.Counters.All())
+    {
+      builder.Append(",\n");
+      AppendTraceCounter(builder, counter.Counter->GetName(), counter.Value, start);
+    }
+
+    forRange(HistoryScope& scope, frame.Scopes.All())
+    {
+      double scopeStart = GetHistoryTime(scope.Start, baseTime);
+      double scopeEnd = GetHistoryTime(scope.End, baseTime);
+      builder.Append(",\n");
+      AppendTraceScope(builder, scope.Scope, scopeStart, scopeEnd - scopeStart, scope.ThreadId);
+    }
+
+    if(number != last)
+      builder.Append(",\n");
+  }
+
+  HistoryFrame& spikeFrame = GetHistoryFrame(spike);
+  float spikeSeconds = ProfileSystem::Instance->GetTimeInSeconds(spikeFrame.End - spikeFrame.Start);
+  builder.AppendFormat("\n],\"otherData\":{\"spikeFrame\":\"%llu\",\"frameMs\":\"%.3f\",\"budgetMs\":\"%.3f\"}}\n",
+                       (unsigned long long)spike, spikeSeconds * 1000.0f, history->Budget * 1000.0f);
+
+  String fileName = String::Format("Spike%llu.json", (unsigned long long)spike);
+  String path = FilePath::Combine(history->Directory, fileName);
+
+  File file;
+  if(!file.Open(path, FileMode::Write, FileAccessPattern::Sequential))
+  {
+    ZPrint("Failed to write frame spike '%s'.\n", path.c_str());
+    return;
+  }
+
+  String text = builder.ToString();
+  file.Write((byte*)text.Data(), text.SizeInBytes());
+  file.Close();
+
+  ++history->SpikeCount;
+  ZPrint("Frame %llu took %.2fms (budget %.2fms), wrote '%s'.\n", (unsigned long long)spike,
+         spikeSeconds * 1000.0f, history->Budget * 1000.0f, path.c_str());
+}
+
+void EndFrameHistoryFrame(ProfileTime frameEndTime)
+{
+  FrameHistoryState* history = gFrameHistory;
+  HistoryFrame& frame = GetHistoryFrame(history->Frame);
+  frame.End = frameEndTime;
+
+  MemCounterType allocations;
+  MemCounterType bytesAllocated;
+  Memory::GetAllocationTotals(allocations, bytesAllocated);
+  frame.Allocations = allocations - history->LastAllocations;
+  frame.ActiveBytes = bytesAllocated;
+  history->LastAllocations = allocations;
+
+  // Counters were latched for this frame before the trace frame ended
+  for(CounterRecord* counter = GetFirstCounter(); counter != nullptr; counter = counter->GetNext())
+  {
+    HistoryCounter& sample = frame.Counters.PushBack();
+    sample.Counter = counter;
+    sample.Value = counter->GetFrameValue();
+  }
+
+  float seconds = ProfileSystem::Instance->GetTimeInSeconds(frame.End - frame.Start);
+  if(seconds > history->Budget && (!history->HasSpike || frame.Number > history->CoveredThrough))
+  {
+    history->PendingSpikes.PushBack(frame.Number);
+    history->HasSpike = true;
+    history->CoveredThrough = frame.Number + history->Neighbors;
+  }
+
+  // Write out the spikes that have all the frames after them
+  bool wroteSpike = false;
+  while(!history->PendingSpikes.Empty() && history->PendingSpikes.Front() + history->Neighbors <= frame.Number)
+  {
+    WriteFrameSpike(history, history->PendingSpikes.Front());
+    history->PendingSpikes.EraseAt(0);
+    wroteSpike = true;
+  }
+
+  // Writing a spike can take longer than the budget, the next frame starts after
+  // it so the write isn't counted against that frame (and reported as a spike)
+  ++history->Frame;
+  BeginHistoryFrame(history, wroteSpike ? ProfileSystem::Instance->GetTime() : frameEndTime);
+}
+
+void StartFrameHistory(StringParam directory, float budgetSeconds, uint historySize, uint neighbors)
+{
+  if(gFrameHistoryActive)
+    StopFrameHistory();
+
+  if(gFrameHistory == nullptr)
+    gFrameHistory = new FrameHistoryState();
+
+  FrameHistoryState* history = gFrameHistory;
+  history->Directory = directory;
+  history->Budget = budgetSeconds;
+  history->Neighbors = neighbors;
+  history->Frames.Resize(Math::Max(historySize, neighbors * 2 + 1));
+  history->Frame = 0;
+  history->PendingSpikes.Clear();
+  history->HasSpike = false;
+  history->CoveredThrough = 0;
+  history->SpikeCount = 0;
+
+  CreateDirectoryAndParents(directory);
+
+  MemCounterType bytesAllocated;
+  Memory::GetAllocationTotals(history->LastAllocations, bytesAllocated);
+
+  // A trace may already be draining the buffers
+  if(!gRecordScopes)
+    ResetTraceBuffers();
+  NameRecordingThread();
+
+  BeginHistoryFrame(history, ProfileSystem::Instance->GetTime());
+
+  gFrameHistoryActive = true;
+  UpdateScopeRecording();
+}
+
+void StopFrameHistory()
+{
+  if(!gFrameHistoryActive)
+    return;
+
+  // Spikes near the end are written with the frames that were recorded
+  FrameHistoryState* history = gFrameHistory;
+  if(!history->PendingSpikes.Empty())
+  {
+    // The frame being recorded is incomplete, only write up to the last finished one
+    --history->Frame;
+    forRange(u64 spike, history->PendingSpikes.All())
+      WriteFrameSpike(history, spike);
+    ++history->Frame;
+    history->PendingSpikes.Clear();
+  }
+
+  gFrameHistoryActive = false;
+  UpdateScopeRecording();
+}
+
+bool IsFrameHistoryActive()
+{
+  return gFrameHistoryActive;
+}
+
+void SetFrameHistoryBudget(float budgetSeconds)
+{
+  if(gFrameHistory)
+    gFrameHistory->Budget = budgetSeconds;
+}
+
+uint GetFrameHistorySpikeCount()
+{
+  return gFrameHistory ? gFrameHistory->SpikeCount : 0;
+}
+
+}//namespace Profile
+
+}//namespace Zero
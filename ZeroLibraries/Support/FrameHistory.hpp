@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file FrameHistory.hpp
+/// Declaration of the frame history that writes out frame spikes.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Utility/Typedefs.hpp"
+#include "String/String.hpp"
+#include "Profiler.hpp"
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+/// Frames kept when no size is given.
+const uint cDefaultFrameHistorySize = 300;
+/// Frames written on each side of a slow frame when no count is given.
+const uint cDefaultFrameHistoryNeighbors = 5;
+
+/// Set while the frame history is recording.
+extern volatile bool gFrameHistoryActive;
+
+/// Starts keeping every profile scope entered on any thread for the last historySize
+/// frames. A frame is measured from one engine update to the next, so on a fixed tick
+/// a frame over budget is a missed tick. When a frame takes longer than budgetSeconds,
+/// it and the neighbors frames on each side of it are written to the directory as
+/// Chrome trace json (Spike<frame>.json), along with the time, allocations and profile
+/// counters of every frame.
+void StartFrameHistory(StringParam directory, float budgetSeconds, uint historySize = cDefaultFrameHistorySize,
+                       uint neighbors = cDefaultFrameHistoryNeighbors);
+/// Stops recording, spikes that are still waiting on the frames after them are written out.
+void StopFrameHistory();
+bool IsFrameHistoryActive();
+void SetFrameHistoryBudget(float budgetSeconds);
+/// Number of spike files written since the history was started.
+uint GetFrameHistorySpikeCount();
+
+// Called by the trace recorder as it drains the thread buffers
+void AddFrameHistoryScope(Record* record, ProfileTime startTime, ProfileTime endTime, uint threadId);
+void EndFrameHistoryFrame(ProfileTime frameEndTime);
+
+}//namespace Profile
+
+}//namespace Zero
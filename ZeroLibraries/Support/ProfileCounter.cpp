@@ -0,0 +1,164 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file ProfileCounter.cpp
+/// Implementation of the named profile counters.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "ProfileCounter.hpp"
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+// Counters are constructed the first time their scope runs, which can be on any
+// thread and at any time, so they are pushed onto the front of a lock-free list.
+// Counters are never removed so the list can be walked while others are pushed.
+CounterRecord* volatile gFirstCounter = nullptr;
+
+// Every thread that calls AddLocal gets a block with a count for each sum counter.
+// Only the owning thread writes its counts, the thread ending the frame adds what
+// each count has grown by since the last frame to the counter. Blocks are never
+// freed (threads are few and they are small), so the walk needs no lock.
+const uint cMaxLocalCounters = 64;
+const uint cNoLocalIndex = uint(-1);
+
+struct ThreadCounters
+{
+  volatile s64 Values[cMaxLocalCounters];
+  // How much of each value has already been added to its counter
+  s64 Folded[cMaxLocalCounters];
+  ThreadCounters* Next;
+};
+
+ZeroThreadLocal ThreadCounters* tThreadCounters = nullptr;
+ThreadCounters* volatile gThreadCounters = nullptr;
+CounterRecord* volatile gLocalCounters[cMaxLocalCounters];
+volatile s32 gLocalCounterCount = 0;
+
+ThreadCounters* GetThreadCounters()
+{
+  ThreadCounters* counters = tThreadCounters;
+  if(counters != nullptr)
+    return counters;
+
+  // Allocated with calloc so counting doesn't show up as an allocation
+  counters = (ThreadCounters*)calloc(1, sizeof(ThreadCounters));
+  ErrorIf(counters == nullptr, "Failed to allocate profile counters for thread.");
+
+  ThreadCounters* first;
+  do
+  {
+    first = (ThreadCounters*)AtomicLoad((void* volatile*)&gThreadCounters);
+    counters->Next = first;
+  } while(!AtomicCompareExchangeBool((void* volatile*)&gThreadCounters, counters, first));
+
+  tThreadCounters = counters;
+  return counters;
+}
+
+// Adds what every thread has counted since the last frame to the counters
+void FoldThreadCounters()
+{
+  uint localCount = Math::Min((uint)AtomicLoad(&gLocalCounterCount), cMaxLocalCounters);
+
+  ThreadCounters* counters = (ThreadCounters*)AtomicLoad((void* volatile*)&gThreadCounters);
+  for(; counters != nullptr; counters = counters->Next)
+  {
+    for(uint i = 0; i < localCount; ++i)
+    {
+      // A counter still being constructed is folded next frame
+      CounterRecord* counter = (CounterRecord*)AtomicLoad((void* volatile*)&gLocalCounters[i]);
+      if(counter == nullptr)
+        continue;
+
+      s64 value = AtomicLoad(&counters->Values[i]);
+      if(value == counters->Folded[i])
+        continue;
+
+      counter->Add(value - counters->Folded[i]);
+      counters->Folded[i] = value;
+    }
+  }
+}
+
+CounterRecord::CounterRecord(cstr name, CounterMode::Enum mode)
+{
+  mName = name;
+  mMode = mode;
+  mLocalIndex = cNoLocalIndex;
+  mValue = 0;
+  mFrameValue = 0;
+  mMaxFrameValue = 0;
+
+  CounterRecord* first;
+  do
+  {
+    first = (CounterRecord*)AtomicLoad((void* volatile*)&gFirstCounter);
+    mNext = first;
+  } while(!AtomicCompareExchangeBool((void* volatile*)&gFirstCounter, this, first));
+
+  if(mode == CounterMode::Sum)
+  {
+    uint index = (uint)AtomicPreIncrement(&gLocalCounterCount) - 1;
+    if(index < cMaxLocalCounters)
+    {
+      mLocalIndex = index;
+      AtomicStore((void* volatile*)&gLocalCounters[index], this);
+    }
+  }
+}
+
+void CounterRecord::AddLocal(s64 amount)
+{
+  ErrorIf(mMode != CounterMode::Sum, "Only sum counters can be added to locally.");
+  if(mLocalIndex == cNoLocalIndex)
+  {
+    Add(amount);
+    return;
+  }
+
+  // Only this thread writes the value, the store just keeps it from tearing for the reader
+  volatile s64* value = &GetThreadCounters()->Values[mLocalIndex];
+  AtomicStore(value, *value + amount);
+}
+
+void CounterRecord::EndFrame()
+{
+  if(mMode == CounterMode::Sum)
+    mFrameValue = AtomicExchange(&mValue, 0);
+  else
+    mFrameValue = AtomicLoad(&mValue);
+
+  if(mFrameValue > mMaxFrameValue)
+    mMaxFrameValue = mFrameValue;
+}
+
+CounterRecord* GetFirstCounter()
+{
+  return (CounterRecord*)AtomicLoad((void* volatile*)&gFirstCounter);
+}
+
+CounterRecord* FindCounter(cstr name)
+{
+  for(CounterRecord* counter = GetFirstCounter(); counter != nullptr; counter = counter->GetNext())
+  {
+    if(strcmp(counter->GetName(), name) == 0)
+      return counter;
+  }
+  return nullptr;
+}
+
+void EndCounterFrame()
+{
+  FoldThreadCounters();
+
+  for(CounterRecord* counter = GetFirstCounter(); counter != nullptr; counter = counter->GetNext())
+    counter->EndFrame();
+}
+
+}//namespace Profile
+
+}//namespace Zero
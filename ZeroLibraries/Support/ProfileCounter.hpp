@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file ProfileCounter.hpp
+/// Declaration of the named profile counters.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Utility/Typedefs.hpp"
+#include "Utility/Atomic.hpp"
+#include "Utility/EnumDeclaration.hpp"
+#include "Profiler.hpp"
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+/// Sum counters total everything added during a frame and start the next frame
+/// at zero. Gauges keep the last value set until it is set again.
+DeclareEnum2(CounterMode, Sum, Gauge);
+
+/// A named count that is recorded once per frame next to the profile scopes.
+/// Adding or setting is a single atomic operation, so it is safe from any thread.
+/// AddLocal only writes to the calling thread's count, the counts of every thread
+/// are folded into the counter when the frame ends, so counters bumped on hot
+/// paths from many threads don't contend (ProfileCounter uses it).
+/// Counters register themselves on construction and are never unregistered
+/// (they are expected to be static).
+class CounterRecord
+{
+public:
+  CounterRecord(cstr name, CounterMode::Enum mode = CounterMode::Sum);
+
+  cstr GetName() { return mName; }
+  CounterMode::Enum GetMode() { return mMode; }
+
+  void Add(s64 amount) { AtomicFetchAdd(&mValue, amount); }
+  void Set(s64 value) { AtomicStore(&mValue, value); }
+  /// Adds to the calling thread's count, only for sum counters.
+  void AddLocal(s64 amount);
+
+  /// The value the counter ended the last frame with.
+  s64 GetFrameValue() { return mFrameValue; }
+  /// The largest frame value since the counter was created or cleared.
+  s64 GetMaxFrameValue() { return mMaxFrameValue; }
+  void ClearMax() { mMaxFrameValue = 0; }
+
+  /// Latches the frame value (and resets sum counters).
+  void EndFrame();
+
+  /// Next registered counter (null at the end of the list).
+  CounterRecord* GetNext() { return mNext; }
+
+private:
+  cstr mName;
+  CounterMode::Enum mMode;
+  /// Slot of the counter in each thread's counts (past the last slot AddLocal just adds).
+  uint mLocalIndex;
+  volatile s64 mValue;
+  s64 mFrameValue;
+  s64 mMaxFrameValue;
+  CounterRecord* mNext;
+
+  CounterRecord(const CounterRecord&);
+  void operator=(const CounterRecord&);
+};
+
+/// The most recently registered counter, walk the rest with GetNext.
+CounterRecord* GetFirstCounter();
+
+/// Finds a counter by name (returns null if nothing has registered it yet).
+CounterRecord* FindCounter(cstr name);
+
+/// Folds every thread's counts in and latches every counter's value for the frame that
+/// just ended (called once per engine update on the main thread, before the trace frame ends).
+void EndCounterFrame();
+
+}//namespace Profile
+
+}//namespace Zero
+
+#if ZPROFILE_ENABLED
+
+#define ProfileCounter(name, amount) \
+  do { \
+    static Zero::Profile::CounterRecord localProfileCounter(name); \
+    localProfileCounter.AddLocal((s64)(amount)); \
+  } while(0)
+
+#define ProfileGauge(name, value) \
+  do { \
+    static Zero::Profile::CounterRecord localProfileCounter(name, Zero::Profile::CounterMode::Gauge); \
+    localProfileCounter.Set((s64)(value)); \
+  } while(0)
+
+#else
+
+#define ProfileCounter(name, amount) do {} while(0)
+#define ProfileGauge(name, value) do {} while(0)
+
+#endif
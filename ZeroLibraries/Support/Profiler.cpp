@@ -9,6 +9,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 #include "Precompiled.hpp"
 #include "Profiler.hpp"
+#include "TraceRecorder.hpp"
 #include "Platform/Timer.hpp"
 #include "Utility/Misc.hpp"
 
@@ -35,6 +36,11 @@ float ProfileSystem::GetTimeInSeconds(ProfileTime time)
   return (float)mTimer.TicksToSeconds(time);
 }
 
+double ProfileSystem::GetTimeInMicroseconds(ProfileTime time)
+{
+  return mTimer.TicksToSeconds(time) * 1000000.0;
+}
+
 void ProfileSystem::Add(Record* record)
 {
   mRecordList.PushBack(record);
@@ -165,17 +171,25 @@ void Record::EnterRecord(ProfileTime time)
   ++mHits;
   mTotalTime+=time;
   //update the max time that was ever spent in this record.
-  if(time > mMaxTime)
-  {
-    mMaxTime = time;
-    //if(mInstantAvg != 0.0f && 3.0f * mInstantAvg < (float)time)
-    //  DebugPrint("%s has an average of %g and spike with %g\n",mName,mInstantAvg,(float)time);
-  }
+  ProfileTime maxTime = mMaxTime.Load();
+  while(time > maxTime && !mMaxTime.CompareExchangeBool(time, maxTime))
+    maxTime = mMaxTime.Load();
+  //if(mInstantAvg != 0.0f && 3.0f * mInstantAvg < (float)time)
+  //  DebugPrint("%s has an average of %g and spike with %g\n",mName,mInstantAvg,(float)time);
+}
+
+ZeroThreadLocal Record* tActiveRecord = nullptr;
+
+Record* GetActiveRecord()
+{
+  return tActiveRecord;
 }
 
 ScopeTimer::ScopeTimer(Record* data)
 {
   mData = data;
+  mParentScope = tActiveRecord;
+  tActiveRecord = data;
   mStartTime = ProfileSystem::Instance->GetTime();
 }
 
@@ -183,6 +197,10 @@ ScopeTimer::~ScopeTimer()
 {
   ProfileTime endTime = ProfileSystem::Instance->GetTime();
   mData->EnterRecord(endTime-mStartTime);
+  tActiveRecord = mParentScope;
+
+  if(gRecordScopes)
+    RecordTraceScope(mData, mStartTime, endTime);
 }
 
 
@@ -12,6 +12,7 @@
 #include "Utility/Typedefs.hpp"
 #include "Containers/Array.hpp"
 #include "Containers/InList.hpp"
+#include "Utility/Atomic.hpp"
 #include "Platform/Timer.hpp"
 
 namespace Zero
@@ -34,6 +35,7 @@ public:
   void Add(Record* record);
   void Add(cstr parentName, Record* record);
   float GetTimeInSeconds(ProfileTime time);
+  double GetTimeInMicroseconds(ProfileTime time);
   ProfileTime GetTime();
   Array<Record*>::range GetRecords(){ return mRecordList.All(); }
 private:
@@ -56,6 +58,7 @@ public:
   //Display information
   void SetName(cstr name);
   cstr GetName(){return mName;};
+  Record* GetParent(){return mParent;}
   u32 GetColor(){return mColor;}
   void SetColor(u32 newColor){mColor = newColor;};
 
@@ -70,6 +73,7 @@ public:
 
   /// Used when this record should be updated with a new elapsed entry.
   /// Updates the hit count, total time and max time of this record.
+  /// Safe to call from any thread.
   void EnterRecord(ProfileTime time);
   void Clear();
 
@@ -90,10 +94,10 @@ private:
   u32 mColor;
   cstr mName;
 
-  //General measurement
-  u32 mHits;
-  ProfileTime mTotalTime;
-  ProfileTime mMaxTime;
+  //General measurement, entered from every thread that runs the scope
+  Atomic<u32> mHits;
+  Atomic<ProfileTime> mTotalTime;
+  Atomic<ProfileTime> mMaxTime;
 
   //Running Average
   float mSmoothAvg;
@@ -115,8 +119,13 @@ public:
 
   Record* mData;
   ProfileTime mStartTime;
+  //The scope that was active on this thread when this one was entered
+  Record* mParentScope;
 };
 
+/// Returns the record of the innermost profile scope on the calling thread (or null).
+Record* GetActiveRecord();
+
 void PrintProfileGraph();
 
 }//namespace Profile
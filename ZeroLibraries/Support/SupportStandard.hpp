@@ -11,6 +11,10 @@
 
 #include "FileSupport.hpp"
 #include "Profiler.hpp"
+#include "ProfileCounter.hpp"
+#include "AllocationProfiler.hpp"
+#include "TraceRecorder.hpp"
+#include "FrameHistory.hpp"
 #include "Rect.hpp"
 #include "NameValidation.hpp"
 #include "ChunkReader.hpp"
@@ -0,0 +1,434 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file TraceRecorder.cpp
+/// Implementation of the multi-threaded profile trace recorder.
+///
+///////////////////////////////////////////////////////////////////////////////
+#include "Precompiled.hpp"
+#include "TraceRecorder.hpp"
+#include "FrameHistory.hpp"
+#include "ProfileCounter.hpp"
+#include "Platform/File.hpp"
+#include "Utility/Misc.hpp"
+
+// Every thread that records a scope while recording gets a ring buffer of
+// events that only it writes to. The main thread reads the buffers once a
+// frame, so a buffer only needs to hold one frame of scopes. The write index
+// is only advanced by the owning thread and the read index only by the main
+// thread, so neither side takes a lock. The recorder lock only guards the list
+// of buffers and their names, the buffers are drained and the trace is written
+// without it so a thread creating its buffer never waits on the file. A full
+// buffer drops the scope instead of waiting. Buffers are kept for the life of
+// the program (a thread may be in the middle of recording when a trace is
+// stopped) and reused by later traces, their size is set when the thread first
+// records. The scopes drained each frame are written to the trace and/or
+// handed to the frame history.
+//
+// The output is the Chrome trace event format:
+//   {"traceEvents":[
+//   {"name":"thread_name","ph":"M","pid":1,"tid":<thread>,"args":{"name":"<name>"}},
+//   {"name":"<scope>","cat":"<parent scope>","ph":"X","ts":<us>,"dur":<us>,"pid":1,"tid":<thread>},
+//   {"name":"Frame","ph":"i","s":"g","ts":<us>,"pid":1,"tid":<thread>,"args":{"frame":<number>}},
+//   {"name":"<counter>","ph":"C","ts":<us>,"pid":1,"args":{"value":<frame value>}},
+//   ],"otherData":{"droppedScopes":"<count>"}}
+// Times are in microseconds from the start of the trace.
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+volatile bool gTraceActive = false;
+volatile bool gRecordScopes = false;
+
+struct TraceEvent
+{
+  Record* Scope;
+  ProfileTime Start;
+  ProfileTime End;
+};
+
+struct TraceThreadBuffer
+{
+  TraceEvent* Events;
+  // Always a power of two
+  uint Capacity;
+  // Advanced by the owning thread
+  volatile s32 WriteIndex;
+  // Advanced by the thread writing out the trace
+  volatile s32 ReadIndex;
+  volatile s32 Dropped;
+  uint ThreadId;
+  // Only accessed with the lock held
+  String Name;
+  bool NameWritten;
+};
+
+struct TraceRecorderState
+{
+  // Guards the buffer list and the thread names
+  SpinLock Lock;
+  // Guards the output and the frame state, held while draining and writing
+  SpinLock OutputLock;
+  File Output;
+  uint EventsPerThread;
+  ProfileTime StartTime;
+  // Counters for a frame are written at the time it started
+  ProfileTime FrameStart;
+  u64 Frame;
+  uint DroppedScopes;
+  // No comma is written before the first event
+  bool FirstEvent;
+  Array<TraceThreadBuffer*> Buffers;
+  // Copied from the buffer list for the frame being drained, with the name
+  // of each buffer that still needs to be written (empty if it doesn't)
+  Array<TraceThreadBuffer*> DrainingBuffers;
+  Array<String> DrainingNames;
+};
+
+TraceRecorderState gTraceRecorder;
+
+ZeroThreadLocal TraceThreadBuffer* tTraceBuffer = nullptr;
+// Set while the thread's buffer is being created, so scopes
+// entered by the allocation don't try to create it again
+ZeroThreadLocal bool tCreatingTraceBuffer = false;
+// Threads are named before they record anything (the buffer isn't created until then)
+const uint cMaxTraceThreadName = 32;
+ZeroThreadLocal char tTraceThreadName[cMaxTraceThreadName];
+
+TraceThreadBuffer* GetTraceThreadBuffer()
+{
+  TraceThreadBuffer* buffer = tTraceBuffer;
+  if(buffer != nullptr || tCreatingTraceBuffer)
+    return buffer;
+
+  tCreatingTraceBuffer = true;
+
+  buffer = new TraceThreadBuffer();
+  buffer->WriteIndex = 0;
+  buffer->ReadIndex = 0;
+  buffer->Dropped = 0;
+  buffer->NameWritten = false;
+
+  gTraceRecorder.Lock.Lock();
+  uint eventsPerThread = gTraceRecorder.EventsPerThread;
+  if(eventsPerThread == 0)
+    eventsPerThread = cDefaultTraceEventsPerThread;
+  buffer->Capacity = NextPowerOfTwo(eventsPerThread - 1);
+  buffer->Events = new TraceEvent[buffer->Capacity];
+  buffer->ThreadId = gTraceRecorder.Buffers.Size() + 1;
+  buffer->Name = tTraceThreadName;
+  gTraceRecorder.Buffers.PushBack(buffer);
+  gTraceRecorder.Lock.Unlock();
+
+  tTraceBuffer = buffer;
+  tCreatingTraceBuffer = false;
+  return buffer;
+}
+
+void RecordTraceScope(Record* record, ProfileTime startTime, ProfileTime endTime)
+{
+  TraceThreadBuffer* buffer = GetTraceThreadBuffer();
+  if(buffer == nullptr)
+    return;
+
+  u32 writeIndex = (u32)buffer->WriteIndex;
+  u32 readIndex = (u32)AtomicLoad(&buffer->ReadIndex);
+  if(writeIndex - readIndex >= buffer->Capacity)
+  {
+    AtomicPreIncrement(&buffer->Dropped);
+    return;
+  }
+
+  TraceEvent& event = buffer->Events[writeIndex & (buffer->Capacity - 1)];
+  event.Scope = record;
+  event.Start = startTime;
+  event.End = endTime;
+
+  // Publish the event to the reader
+  AtomicStore(&buffer->WriteIndex, (s32)(writeIndex + 1));
+}
+
+void SetTraceThreadName(StringParam name)
+{
+  size_t length = Math::Min(name.SizeInBytes(), size_t(cMaxTraceThreadName - 1));
+  memcpy(tTraceThreadName, name.Data(), length);
+  tTraceThreadName[length] = '\0';
+
+  TraceThreadBuffer* buffer = tTraceBuffer;
+  if(buffer == nullptr)
+    return;
+
+  gTraceRecorder.Lock.Lock();
+  buffer->Name = tTraceThreadName;
+  buffer->NameWritten = false;
+  gTraceRecorder.Lock.Unlock();
+}
+
+// Microseconds from the start of the trace (scopes entered before the trace started are clamped)
+double GetTraceTime(ProfileTime time)
+{
+  ProfileTime startTime = gTraceRecorder.StartTime;
+  if(time < startTime)
+    return 0.0;
+  return ProfileSystem::Instance->GetTimeInMicroseconds(time - startTime);
+}
+
+void BeginTraceEvent(StringBuilder& builder)
+{
+  if(!gTraceRecorder.FirstEvent)
+    builder.Append(",\n");
+  gTraceRecorder.FirstEvent = false;
+}
+
+void AppendTraceThreadName(StringBuilder& builder, uint threadId, StringParam name)
+{
+  builder.AppendFormat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                       threadId, name.c_str());
+}
+
+void AppendTraceScope(StringBuilder& builder, Record* record, double start, double duration, uint threadId)
+{
+  Record* parent = record->GetParent();
+  cstr category = parent ? parent->GetName() : "None";
+  builder.AppendFormat("{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                       record->GetName(), category, start, duration, threadId);
+}
+
+void AppendTraceCounter(StringBuilder& builder, cstr name, s64 value, double time)
+{
+  builder.AppendFormat("{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{\"value\":%lld}}",
+                       name, time, (long long)value);
+}
+
+void AppendTraceThreadNames(StringBuilder& builder, cstr separator)
+{
+  gTraceRecorder.Lock.Lock();
+  forRange(TraceThreadBuffer* buffer, gTraceRecorder.Buffers.All())
+  {
+    if(buffer->Name.Empty())
+      continue;
+    AppendTraceThreadName(builder, buffer->ThreadId, buffer->Name);
+    builder.Append(separator);
+  }
+  gTraceRecorder.Lock.Unlock();
+}
+
+// Must be called with the output lock held
+void DrainTraceBuffer(TraceThreadBuffer* buffer, StringParam newName, StringBuilder& builder)
+{
+  if(!newName.Empty())
+  {
+    BeginTraceEvent(builder);
+    AppendTraceThreadName(builder, buffer->ThreadId, newName);
+  }
+
+  u32 readIndex = (u32)buffer->ReadIndex;
+  u32 writeIndex = (u32)AtomicLoad(&buffer->WriteIndex);
+  for(; readIndex != writeIndex; ++readIndex)
+  {
+    TraceEvent& event = buffer->Events[readIndex & (buffer->Capacity - 1)];
+
+    if(gFrameHistoryActive)
+      AddFrameHistoryScope(event.Scope, event.Start, event.End, buffer->ThreadId);
+
+    if(gTraceActive)
+    {
+      double start = GetTraceTime(event.Start);
+      double end = GetTraceTime(event.End);
+      BeginTraceEvent(builder);
+      AppendTraceScope(builder, event.Scope, start, end - start, buffer->ThreadId);
+    }
+  }
+
+  // Let the thread reuse the space
+  AtomicStore(&buffer->ReadIndex, (s32)writeIndex);
+  gTraceRecorder.DroppedScopes += (uint)AtomicExchange(&buffer->Dropped, 0);
+}
+
+// Throws out anything left over from before recording started
+void ResetTraceBuffers()
+{
+  gTraceRecorder.Lock.Lock();
+  forRange(TraceThreadBuffer* buffer, gTraceRecorder.Buffers.All())
+  {
+    AtomicStore(&buffer->ReadIndex, AtomicLoad(&buffer->WriteIndex));
+    AtomicStore(&buffer->Dropped, 0);
+  }
+  gTraceRecorder.Lock.Unlock();
+}
+
+void UpdateScopeRecording()
+{
+  gRecordScopes = gTraceActive || gFrameHistoryActive;
+}
+
+void WriteTrace(StringBuilder& builder)
+{
+  String text = builder.ToString();
+  gTraceRecorder.Output.Write((byte*)text.Data(), text.SizeInBytes());
+}
+
+void NameRecordingThread()
+{
+  // The thread that starts recording is expected to be the one draining the buffers
+  if(tTraceThreadName[0] == '\0')
+    SetTraceThreadName("Main");
+}
+
+void DrainTraceFrame(bool endHistoryFrame);
+
+bool StartTrace(StringParam fileName, uint eventsPerThread)
+{
+  if(gTraceActive)
+    StopTrace();
+
+  if(eventsPerThread == 0)
+    eventsPerThread = cDefaultTraceEventsPerThread;
+
+  // The frame history may already be draining the buffers
+  if(!gRecordScopes)
+    ResetTraceBuffers();
+
+  gTraceRecorder.OutputLock.Lock();
+
+  bool opened = gTraceRecorder.Output.Open(fileName, FileMode::Write, FileAccessPattern::Sequential);
+  if(opened)
+  {
+    gTraceRecorder.EventsPerThread = eventsPerThread;
+    gTraceRecorder.StartTime = ProfileSystem::Instance->GetTime();
+    gTraceRecorder.FrameStart = gTraceRecorder.StartTime;
+    gTraceRecorder.Frame = 0;
+    gTraceRecorder.DroppedScopes = 0;
+    gTraceRecorder.FirstEvent = true;
+
+    gTraceRecorder.Lock.Lock();
+    forRange(TraceThreadBuffer* buffer, gTraceRecorder.Buffers.All())
+      buffer->NameWritten = false;
+    gTraceRecorder.Lock.Unlock();
+
+    StringBuilder builder;
+    builder.Append("{\"traceEvents\":[\n");
+    WriteTrace(builder);
+  }
+
+  gTraceRecorder.OutputLock.Unlock();
+
+  if(!opened)
+  {
+    ZPrint("Failed to open trace '%s'.\n", fileName.c_str());
+    return false;
+  }
+
+  NameRecordingThread();
+
+  gTraceActive = true;
+  UpdateScopeRecording();
+  return true;
+}
+
+uint StopTrace()
+{
+  if(!gTraceActive)
+    return 0;
+
+  // Scopes from the last frame are written before the file is closed
+  DrainTraceFrame(false);
+  gTraceActive = false;
+  UpdateScopeRecording();
+
+  gTraceRecorder.OutputLock.Lock();
+
+  uint droppedScopes = gTraceRecorder.DroppedScopes;
+  StringBuilder builder;
+  builder.AppendFormat("\n],\"otherData\":{\"droppedScopes\":\"%u\"}}\n", droppedScopes);
+  WriteTrace(builder);
+  gTraceRecorder.Output.Close();
+
+  gTraceRecorder.OutputLock.Unlock();
+
+  if(droppedScopes != 0)
+    ZPrint("Trace dropped %u scopes, increase the events per thread.\n", droppedScopes);
+  return droppedScopes;
+}
+
+bool IsTraceActive()
+{
+  return gTraceActive;
+}
+
+// Scopes left in the buffers when a trace stops still belong to the history's current frame
+void DrainTraceFrame(bool endHistoryFrame)
+{
+  ProfileTime now = ProfileSystem::Instance->GetTime();
+
+  gTraceRecorder.OutputLock.Lock();
+
+  // Only the buffer list and names are copied with the lock held
+  Array<TraceThreadBuffer*>& buffers = gTraceRecorder.DrainingBuffers;
+  Array<String>& newNames = gTraceRecorder.DrainingNames;
+  gTraceRecorder.Lock.Lock();
+  buffers.Assign(gTraceRecorder.Buffers.All());
+  newNames.Resize(buffers.Size());
+  for(uint i = 0; i < buffers.Size(); ++i)
+  {
+    TraceThreadBuffer* buffer = buffers[i];
+    if(gTraceActive && !buffer->NameWritten && !buffer->Name.Empty())
+    {
+      newNames[i] = buffer->Name;
+      buffer->NameWritten = true;
+    }
+    else
+    {
+      newNames[i] = String();
+    }
+  }
+  gTraceRecorder.Lock.Unlock();
+
+  StringBuilder builder;
+  for(uint i = 0; i < buffers.Size(); ++i)
+    DrainTraceBuffer(buffers[i], newNames[i], builder);
+
+  if(gTraceActive)
+  {
+    uint threadId = tTraceBuffer ? tTraceBuffer->ThreadId : 0;
+    BeginTraceEvent(builder);
+    builder.AppendFormat("{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"frame\":%llu}}",
+                         GetTraceTime(now), threadId, (unsigned long long)gTraceRecorder.Frame);
+    ++gTraceRecorder.Frame;
+
+    // Counters were latched for the frame before this was called
+    if(endHistoryFrame)
+    {
+      double frameStart = GetTraceTime(gTraceRecorder.FrameStart);
+      for(CounterRecord* counter = GetFirstCounter(); counter != nullptr; counter = counter->GetNext())
+      {
+        BeginTraceEvent(builder);
+        AppendTraceCounter(builder, counter->GetName(), counter->GetFrameValue(), frameStart);
+      }
+      gTraceRecorder.FrameStart = now;
+    }
+
+    WriteTrace(builder);
+    gTraceRecorder.Output.Flush();
+  }
+
+  gTraceRecorder.OutputLock.Unlock();
+
+  // Every scope of the frame has been handed to the history
+  if(gFrameHistoryActive && endHistoryFrame)
+    EndFrameHistoryFrame(now);
+}
+
+void EndTraceFrame()
+{
+  if(!gRecordScopes)
+    return;
+
+  DrainTraceFrame(true);
+}
+
+}//namespace Profile
+
+}//namespace Zero
@@ -0,0 +1,66 @@
+///////////////////////////////////////////////////////////////////////////////
+///
+/// \file TraceRecorder.hpp
+/// Declaration of the multi-threaded profile trace recorder.
+///
+///////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Utility/Typedefs.hpp"
+#include "String/String.hpp"
+#include "String/StringBuilder.hpp"
+#include "Profiler.hpp"
+
+namespace Zero
+{
+
+namespace Profile
+{
+
+/// Scopes each thread can record between two frames when no size is given.
+const uint cDefaultTraceEventsPerThread = 64 * 1024;
+
+/// Set while a trace is being recorded.
+extern volatile bool gTraceActive;
+/// Set while scopes are recorded for a trace or the frame history (checked by every ScopeTimer).
+extern volatile bool gRecordScopes;
+
+/// Starts recording every ProfileScope entered on any thread, with the thread
+/// and start time. Each thread writes into its own ring buffer, and the buffers
+/// are written to the file once per frame as Chrome trace event json. The file
+/// can be opened in chrome://tracing or Perfetto. If a thread records more than
+/// eventsPerThread scopes in one frame, the extra scopes are dropped and counted.
+/// The thread that starts the trace is named Main in the trace.
+/// Returns false if the file could not be opened.
+bool StartTrace(StringParam fileName, uint eventsPerThread = cDefaultTraceEventsPerThread);
+
+/// Writes the remaining events, closes the file and returns the number of dropped scopes.
+uint StopTrace();
+
+bool IsTraceActive();
+
+/// Writes out the scopes recorded since the last call (to the trace and the frame
+/// history) along with the counters latched by EndCounterFrame, and marks the start
+/// of a new frame (called once per engine update on the main thread).
+void EndTraceFrame();
+
+/// Names the calling thread in traces (names are cut off at 31 bytes).
+void SetTraceThreadName(StringParam name);
+
+/// Adds a completed scope to the calling thread's buffer (called by ScopeTimer).
+void RecordTraceScope(Record* record, ProfileTime startTime, ProfileTime endTime);
+
+// Shared with the frame history
+void ResetTraceBuffers();
+void UpdateScopeRecording();
+void NameRecordingThread();
+/// Appends a scope as a Chrome trace complete event (times in microseconds).
+void AppendTraceScope(StringBuilder& builder, Record* record, double start, double duration, uint threadId);
+/// Appends a counter event that holds the value from the time on.
+void AppendTraceCounter(StringBuilder& builder, cstr name, s64 value, double time);
+/// Appends a thread name event for every named thread, each followed by the separator.
+void AppendTraceThreadNames(StringBuilder& builder, cstr separator);
+
+}//namespace Profile
+
+}//namespace Zero
@@ -336,6 +336,7 @@ namespace Zilch
     PatchId(0),
     EnableDebugEvents(false),
     DoNotAllowAllocation(0),
+    HeapAllocationCount(0),
     UniqueIdScopeCounter(1),
     AllocatingType(nullptr)
   {
@@ -1087,10 +1088,11 @@ namespace Zilch
         ZilchTodo("We MUST respect the HeapManagerExtraPatchSize to make sure we don't go outside! What do we do in that case though... fail patching?");
 
         // Loop through all heap objects and check if any of them are the old type
-        ZilchForEach(const byte* object, this->HeapObjects->LiveObjects)
+        for (ObjectHeader* liveHeader = this->HeapObjects->LiveObjects; liveHeader != nullptr; liveHeader = liveHeader->NextLive)
         {
-          // Just behind the allocated object is the header
-          ObjectHeader& header = *(ObjectHeader*)(object - sizeof(ObjectHeader));
+          // The object is just after the header
+          ObjectHeader& header = *liveHeader;
+          const byte* object = (const byte*)liveHeader + sizeof(ObjectHeader);
 
           // Remember, we only compare names, which means the oldHeapType can actually be different than oldType
           // This is especially true after we've patched multiple times (the object gets updated to a newer object, but still isn't the original!)
@@ -1504,6 +1506,7 @@ namespace Zilch
     handle.StoredType = type;
     handle.Manager = HandleManagers::GetInstance().GetManager(type->HandleManager, this);
     handle.Manager->Allocate(type, handle, flags);
+    ++this->HeapAllocationCount;
 
     //HACK (forces all handles to be direct pointers)
     //byte* obj = handle.Dereference();
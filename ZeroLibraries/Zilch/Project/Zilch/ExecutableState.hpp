@@ -580,6 +580,9 @@ namespace Zilch
     // Reserved space after the stack, this is only used when we reach a stack overflow
     const size_t OverflowStackSize;
 
+    // The number of heap objects this state has allocated (never reset, read it twice to count a period)
+    size_t HeapAllocationCount;
+
     // If this reference count is greater than 0, then we do not allow allocation
     // This is true when running any destructors (destructors must not allocate objects, or call any functions that allocate)
     size_t DoNotAllowAllocation;
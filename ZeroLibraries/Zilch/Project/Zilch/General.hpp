@@ -71,6 +71,12 @@ namespace Zilch
     #define ZilchSupportsThreadLocalStorage
   #endif
 
+  // GCC and Clang can take the address of a label ('labels as values'), which lets the
+  // virtual machine jump straight from one opcode's handler to the next opcode's handler
+  #if defined(__GNUC__) || defined(__clang__)
+    #define ZilchSupportsComputedGoto
+  #endif
+
   // If we're running 0x features in gcc, or the C++ version is defined, or we're in VS2010 or later...
   #if defined(__GXX_EXPERIMENTAL_CXX0X__) ||  __cplusplus >= 201103L || _MSC_VER >= 1600
     #define ZilchSupportsDecltypeAuto
@@ -211,14 +211,43 @@ namespace Zilch
     return true;
   }
 
+  //***************************************************************************
+  // Slots are grouped into four size classes per power of two (at most 25% of a slot is wasted)
+  // Every slot is at least the header plus the patch space, so the classes start at 256 bytes
+  static size_t GetHeapSlabClass(size_t slotSize)
+  {
+    size_t last = slotSize - 1;
+    size_t shift = 7;
+    while ((last >> (shift + 1)) != 0)
+      ++shift;
+
+    return (shift - 7) * 4 + (last >> (shift - 2)) - 4;
+  }
+
+  //***************************************************************************
+  static size_t GetHeapSlabClassSize(size_t slabClass)
+  {
+    size_t shift = slabClass / 4 + 7;
+    return (slabClass % 4 + 5) << (shift - 2);
+  }
+
   //***************************************************************************
   HeapManager::HeapManager(ExecutableState* state) :
-    HandleManager(state)
+    HandleManager(state),
+    LiveObjects(nullptr)
   {
     // Initialize the counter to zero
     this->UidCount = 0;
   }
 
+  //***************************************************************************
+  HeapManager::~HeapManager()
+  {
+    // All objects were deleted by DeleteAll, so we just have to return the slabs
+    for (size_t i = 0; i < this->Slabs.Size(); ++i)
+      Zero::zDeallocate(this->Slabs[i].Begin);
+  }
+
   //***************************************************************************
   String HeapManager::GetName()
   {
@@ -231,56 +260,134 @@ namespace Zilch
   {
     HeapHandleData& data = *(HeapHandleData*)handle.Data;
 
+    // The slab memory the header is in is never freed, so we can always read it
+    // If the unique-ids for that slot don't match (it was freed or reused)
+    // then we return null since this handle is no longer valid
+    if (data.UniqueId != data.Header->UniqueId)
+      return nullptr;
+
     // The pointer to the object is just after the header
-    byte* object = ((byte*)data.Header) + sizeof(ObjectHeader);
+    return ((byte*)data.Header) + sizeof(ObjectHeader);
+  }
 
-    // First check if the object is even live
-    if (this->LiveObjects.Contains(object) == false)
+  //***************************************************************************
+  ObjectHeader* HeapManager::FindLiveHeader(const byte* object)
+  {
+    const byte* memory = object - sizeof(ObjectHeader);
+
+    // Find the last slab that begins at or before the memory
+    size_t begin = 0;
+    size_t end = this->Slabs.Size();
+    while (begin < end)
+    {
+      size_t middle = (begin + end) / 2;
+      if (this->Slabs[middle].Begin <= memory)
+        begin = middle + 1;
+      else
+        end = middle;
+    }
+
+    if (begin == 0)
       return nullptr;
 
-    // If the unique-ids for that slot don't match (it was reused)
-    // then we return null since this handle is no longer valid
-    if (data.UniqueId != data.Header->UniqueId)
+    HeapSlab& slab = this->Slabs[begin - 1];
+    if (memory >= slab.End)
+      return nullptr;
+
+    // The pointer must be exactly where an object starts in one of the slots
+    if ((size_t)(memory - slab.Begin) % slab.SlotSize != 0)
       return nullptr;
 
-    // The object must be valid!
-    return object;
+    ObjectHeader* header = (ObjectHeader*)memory;
+    if (header->UniqueId == FreedObjectUid)
+      return nullptr;
+
+    return header;
+  }
+
+  //***************************************************************************
+  bool HeapManager::AllocateSlab(size_t slabClass)
+  {
+    // Large objects get a slab to themselves
+    size_t slotSize = GetHeapSlabClassSize(slabClass);
+    size_t slotCount = HeapManagerSlabSize / slotSize;
+    if (slotCount == 0)
+      slotCount = 1;
+
+    size_t slabSize = slotSize * slotCount;
+    byte* memory = (byte*)Zero::zAllocate(slabSize);
+    if (memory == nullptr)
+      return false;
+
+    // Keep the slabs sorted by address
+    size_t index = this->Slabs.Size();
+    while (index > 0 && this->Slabs[index - 1].Begin > memory)
+      --index;
+
+    HeapSlab slab;
+    slab.Begin = memory;
+    slab.End = memory + slabSize;
+    slab.SlotSize = slotSize;
+    this->Slabs.InsertAt(index, slab);
+
+    // Push the slots in reverse so they get handed out in address order
+    ObjectHeader*& freeSlots = this->FreeSlots[slabClass];
+    for (size_t i = slotCount; i > 0; --i)
+    {
+      ObjectHeader* header = (ObjectHeader*)(memory + (i - 1) * slotSize);
+      header->UniqueId = FreedObjectUid;
+      header->SlabClass = (unsigned)slabClass;
+      header->NextLive = freeSlots;
+      freeSlots = header;
+    }
+    return true;
   }
   
   //***************************************************************************
   void HeapManager::Allocate(BoundType* type, Handle& handleToInitialize, size_t customFlags)
   {
-    // Create a buffer that's the size of the object we'd like to allocate
-    // At the beginning of the buffer, we put the object slot pointer so that
-    // 'ObjectToHandle' can recreate a handle via the slot data pointer
+    // Every object lives in a slot that's big enough for the header, the object, and the patch space
+    // Behind the object we put a header so that 'ObjectToHandle' can recreate a handle
     size_t objectSize = type->GetAllocatedSize();
     size_t fullSize = sizeof(ObjectHeader) + objectSize + HeapManagerExtraPatchSize;
-    byte* memory = (byte*)Zero::zAllocate(fullSize);
+    size_t slabClass = GetHeapSlabClass(fullSize);
+
+    if (slabClass >= this->FreeSlots.Size())
+      this->FreeSlots.Resize(slabClass + 1, nullptr);
 
     // If the memory failed to allocate, early out
-    if (memory == nullptr)
+    if (this->FreeSlots[slabClass] == nullptr && this->AllocateSlab(slabClass) == false)
     {
       Error("Failed memory allocation within a Zilch heap object");
       handleToInitialize.Manager = nullptr;
       return;
     }
 
-    // Make sure we mark this as a live object
-    byte* object = memory + sizeof(ObjectHeader);
-    this->LiveObjects.Insert(object);
+    // Take the slot off the free list
+    ObjectHeader& header = *this->FreeSlots[slabClass];
+    this->FreeSlots[slabClass] = header.NextLive;
 
     // All primitives should support being zeroed out
-    memset(memory, 0, fullSize);
+    // The patch space is left alone, patching constructs any fields that it adds
+    byte* object = (byte*)&header + sizeof(ObjectHeader);
+    memset(object, 0, objectSize);
+
+    // Make sure we mark this as a live object
+    header.PreviousLive = nullptr;
+    header.NextLive = this->LiveObjects;
+    if (this->LiveObjects != nullptr)
+      this->LiveObjects->PreviousLive = &header;
+    this->LiveObjects = &header;
 
-    // Store a pointer back to the slot on the memory itself
-    ObjectHeader& header = *(ObjectHeader*)memory;
     header.Type = type;
     header.UniqueId = this->UidCount;
     header.ReferenceCount = 1;
     header.Flags = (HeapObjectFlags::Enum)customFlags;
 
-    // Increment the unique ID counter
+    // Increment the unique ID counter (skipping the id that marks free slots)
     ++this->UidCount;
+    if (this->UidCount == FreedObjectUid)
+      this->UidCount = 0;
 
     // If specified, we won't do reference counting on this handle
     // This means the only way to destroy the handle is via delete
@@ -304,7 +411,8 @@ namespace Zilch
     }
 
     // First, check if this object was even allocated through us
-    if (this->LiveObjects.Contains(object) == false)
+    ObjectHeader* foundHeader = this->FindLiveHeader(object);
+    if (foundHeader == nullptr)
     {
       // Since the object that was passed in isn't managed by us, the only valid way to get a handle to it is to use the pointer manager
       // Most likely this will be fine since we're passing through binding and not typically invoking user code
@@ -318,7 +426,7 @@ namespace Zilch
     }
 
     // Just behind the allocated object is the header
-    ObjectHeader& header = *(ObjectHeader*)(object - sizeof(ObjectHeader));
+    ObjectHeader& header = *foundHeader;
 
     // If specified, we won't do reference counting on this handle
     // This means the only way to destroy the handle is via delete
@@ -345,13 +453,11 @@ namespace Zilch
     // Leak detection includes the stack frame of who allocated it
     // as well as all those still referencing it
 
-    while (this->LiveObjects.Empty() == false)
+    while (this->LiveObjects != nullptr)
     {
       // Just get the first object and attempt to free it
-      const byte* object = this->LiveObjects.All().Front();
-
-      // Just behind the allocated object is the header
-      ObjectHeader& header = *(ObjectHeader*)(object - sizeof(ObjectHeader));
+      ObjectHeader& header = *this->LiveObjects;
+      const byte* object = (const byte*)&header + sizeof(ObjectHeader);
 
       // Create a temporary handle to point at the object
       Handle handle(object, header.Type, this);
@@ -368,9 +474,6 @@ namespace Zilch
       ErrorIf(deleted != true,
         "Delete on the handle returned that the object was not deleted (it always should be deletable)");
     }
-
-    ErrorIf(this->LiveObjects.Empty() == false,
-      "All objects should be cleared by this point");
   }
   
   //***************************************************************************
@@ -378,15 +481,21 @@ namespace Zilch
   {
     // Get the associated slot
     HeapHandleData& data = *(HeapHandleData*)handle.Data;
-
-    // The pointer to the object is just after the header
-    byte* object = ((byte*)data.Header) + sizeof(ObjectHeader);
+    ObjectHeader& header = *data.Header;
     
     // Remove the object from the list of live objects
-    this->LiveObjects.Erase(object);
+    if (header.PreviousLive != nullptr)
+      header.PreviousLive->NextLive = header.NextLive;
+    else
+      this->LiveObjects = header.NextLive;
+
+    if (header.NextLive != nullptr)
+      header.NextLive->PreviousLive = header.PreviousLive;
 
-    // Delete the data in the slot and null it out
-    Zero::zDeallocate(data.Header);
+    // Invalidate any handles that still point at the slot and give it back to its size class
+    header.UniqueId = FreedObjectUid;
+    header.NextLive = this->FreeSlots[header.SlabClass];
+    this->FreeSlots[header.SlabClass] = &header;
   }
 
   //***************************************************************************
@@ -240,8 +240,20 @@ namespace Zilch
     Uid                   UniqueId;
     unsigned              ReferenceCount;
     HeapObjectFlags::Enum Flags;
+
+    // The size class of the slab slot this object lives in (see HeapManager)
+    unsigned              SlabClass;
+
+    // Links in the heap manager's list of live objects
+    // When the slot is free, NextLive links it into the free list for its size class
+    ObjectHeader*         PreviousLive;
+    ObjectHeader*         NextLive;
   };
 
+  // The unique id stored in the header of a slot that is not holding a live object
+  // Handles never store this id, so checking the id also checks if the object is live
+  const Uid FreedObjectUid = (Uid)-1;
+
   // The structure of our heap handle's inner data
   class ZeroShared HeapHandleData
   {
@@ -266,6 +278,20 @@ namespace Zilch
   // We could implement this on a platform basis (such as HeapReAlloc on Windows with the flag of no moving)
   const size_t HeapManagerExtraPatchSize = 256;
 
+  // Objects are allocated out of slabs of equally sized slots (header, object, and patch space)
+  // Slabs are only freed when the heap manager is destroyed, so a header may always be read
+  // through a handle to check if the object it points at is still live
+  const size_t HeapManagerSlabSize = 64 * 1024;
+
+  // A block of slots that all belong to the same size class
+  class ZeroShared HeapSlab
+  {
+  public:
+    byte*  Begin;
+    byte*  End;
+    size_t SlotSize;
+  };
+
   // This manages heap objects allocated in the language (including references to heap members via offset)
   class ZeroShared HeapManager : public HandleManager
   {
@@ -273,6 +299,7 @@ namespace Zilch
 
     // HandleManager interface
     HeapManager(ExecutableState* state);
+    ~HeapManager();
     String GetName() override;
     void Allocate(BoundType* type, Handle& handleToInitialize, size_t customFlags) override;
     byte* HandleToObject(const Handle& handle) override;
@@ -288,12 +315,27 @@ namespace Zilch
     // A unique ID counter (so we can Assign objects unique IDs...)
     Uid UidCount;
 
-    // When we validate a handle, we first check if the object is live (this is NOT a pointer to the header)
-    // Because a completely different object could have been allocated in the exact same place (pointer)
-    // then we also have to check the version stored in the handle against the version in the object's header
-    // If the pointer given to 'ObjectToHandle' does not exist here, we implicitly allocate a new object and
+    // Returns the header of the live object if the pointer is an object we allocated, or null
+    // If the pointer given to 'ObjectToHandle' is not ours, we implicitly allocate a new object and
     // invoke the copy constructor on the object
-    HashSet<const byte*> LiveObjects;
+    ObjectHeader* FindLiveHeader(const byte* object);
+
+    // The first object in the intrusive list of all live objects (walk it with ObjectHeader::NextLive)
+    // When we validate a handle we compare the unique id it stores against the one in the header,
+    // because a completely different object could have been allocated in the exact same slot
+    // (freed slots have the FreedObjectUid)
+    ObjectHeader* LiveObjects;
+
+  private:
+
+    // Allocates a new slab for the size class and puts all of its slots on the free list
+    bool AllocateSlab(size_t slabClass);
+
+    // The head of the free slot list for each size class (indexed by ObjectHeader::SlabClass)
+    Array<ObjectHeader*> FreeSlots;
+
+    // All slabs we've allocated sorted by address (so we can find which slab a pointer is in)
+    Array<HeapSlab> Slabs;
   };
 
   // The structure of our stack handle's inner data
@@ -809,6 +809,7 @@ namespace Zilch
   //***************************************************************************
   BoundType::BoundType(BoundTypeAssertFn nativeBindingAssert) :
     BaseType(nullptr),
+    RuntimeIndex(0),
     BoundNativeVirtualCount(0),
     HandleManager(ZilchManagerId(HeapManager)),
     PostDestructor(nullptr),
@@ -863,6 +863,10 @@ namespace Zilch
     // The base type (or null if there is no base)
     BoundType* BaseType;
 
+    // A dense index the host may assign to this type for constant time lookups (zero until assigned)
+    // Zilch never reads this, the engine uses it to find components on an object
+    size_t RuntimeIndex;
+
     // The handles that need to be cleaned up
     Array<size_t> Handles;
 
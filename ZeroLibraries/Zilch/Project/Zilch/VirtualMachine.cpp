@@ -565,10 +565,13 @@ namespace Zilch
   typedef void (*VirtualInstructionFn)(ExecutableState* state, Call& call, ExceptionReport& report, size_t& programCounter, PerFrameData* ourFrame, const Opcode& opcode);
   VirtualInstructionFn InstructionTable[Instruction::Count] = {0};
   #define ZilchVirtualInstruction(Name) void VirtualMachine::Instruction##Name (ExecutableState* state, Call& call, ExceptionReport& report, size_t& programCounter, PerFrameData* ourFrame, const Opcode& opcode)
+
+  // The small instructions that make up most of a function are inlined into the threaded loop
+  #define ZilchInlineVirtualInstruction(Name) ZilchForceInline ZilchVirtualInstruction(Name)
   
   //*****************************************************************************
   #define ZilchCaseBinaryRValue2(argType1, argType2, resultType, operation, expression)                   \
-    ZilchVirtualInstruction(operation##argType1)                                                          \
+    ZilchInlineVirtualInstruction(operation##argType1)                                                    \
     {                                                                                                     \
       const BinaryRValueOpcode& op = (const BinaryRValueOpcode&) opcode;                                  \
       const argType1& left = GetOperand<argType1>(ourFrame, ourFrame, op.Left);                           \
@@ -580,7 +583,7 @@ namespace Zilch
 
   //*****************************************************************************
   #define ZilchCaseBinaryLValue2(argType1, argType2, operation, expression)                               \
-    ZilchVirtualInstruction(operation##argType1)                                                          \
+    ZilchInlineVirtualInstruction(operation##argType1)                                                    \
     {                                                                                                     \
       const BinaryLValueOpcode& op = (const BinaryLValueOpcode&) opcode;                                  \
       argType1& output = GetOperand<argType1>(ourFrame, ourFrame, op.Output);                             \
@@ -599,7 +602,7 @@ namespace Zilch
 
   //*****************************************************************************
   #define ZilchCaseUnaryRValue(argType, resultType, operation, expression)                                \
-    ZilchVirtualInstruction(operation##argType)                                                           \
+    ZilchInlineVirtualInstruction(operation##argType)                                                     \
     {                                                                                                     \
       const UnaryRValueOpcode& op = (const UnaryRValueOpcode&) opcode;                                    \
       const argType& operand = GetOperand<argType>(ourFrame, ourFrame, op.SingleOperand);                 \
@@ -610,7 +613,7 @@ namespace Zilch
 
   //*****************************************************************************
   #define ZilchCaseUnaryLValue(argType, operation, expression)                                            \
-    ZilchVirtualInstruction(operation##argType)                                                           \
+    ZilchInlineVirtualInstruction(operation##argType)                                                     \
     {                                                                                                     \
       const UnaryLValueOpcode& op = (const UnaryLValueOpcode&) opcode;                                    \
       argType& operand = GetOperand<argType>(ourFrame, ourFrame, op.SingleOperand);                       \
@@ -620,7 +623,7 @@ namespace Zilch
 
   //*****************************************************************************
   #define ZilchCaseConversion(fromType, toType, expression)                                               \
-    ZilchVirtualInstruction(Convert##fromType##To##toType)                                                \
+    ZilchInlineVirtualInstruction(Convert##fromType##To##toType)                                          \
     {                                                                                                     \
       const ConversionOpcode& op = (const ConversionOpcode&) opcode;                                      \
       const fromType& value = GetOperand<fromType>(ourFrame, ourFrame, op.ToConvert);                     \
@@ -631,7 +634,7 @@ namespace Zilch
 
   //*****************************************************************************
   #define ZilchCaseSimpleCopy(T)                                                                          \
-    ZilchVirtualInstruction(Copy##T)                                                                      \
+    ZilchInlineVirtualInstruction(Copy##T)                                                                \
     {                                                                                                     \
       PerFrameData* topFrame = state->StackFrames.Back();                                                 \
       T* source;                                                                                          \
@@ -648,7 +651,7 @@ namespace Zilch
 
   //*****************************************************************************
   #define ZilchCaseComplexCopy(T)                                                                         \
-    ZilchVirtualInstruction(Copy##T)                                                                      \
+    ZilchInlineVirtualInstruction(Copy##T)                                                                \
     {                                                                                                     \
       /* Grab the rest of the data */                                                                     \
       const CopyOpcode& op = (const CopyOpcode&) opcode;                                                  \
@@ -865,7 +868,7 @@ namespace Zilch
   }
 
   //***************************************************************************
-  ZilchVirtualInstruction(BeginScope)
+  ZilchInlineVirtualInstruction(BeginScope)
   {
     // Store a pointer to the newly created (or recycled) scope
     PerScopeData* newScope = state->AllocateScope();
@@ -879,7 +882,7 @@ namespace Zilch
   }
   
   //***************************************************************************
-  ZilchVirtualInstruction(EndScope)
+  ZilchInlineVirtualInstruction(EndScope)
   {
     // Get the latest scope
     PerScopeData* scope = ourFrame->Scopes.Back();
@@ -1016,21 +1019,21 @@ namespace Zilch
   }
   
   //***************************************************************************
-  ZilchVirtualInstruction(IfFalseRelativeGoTo)
+  ZilchInlineVirtualInstruction(IfFalseRelativeGoTo)
   {
     IfHandler<false>(ourFrame, opcode);
     return;
   }
   
   //***************************************************************************
-  ZilchVirtualInstruction(IfTrueRelativeGoTo)
+  ZilchInlineVirtualInstruction(IfTrueRelativeGoTo)
   {
     IfHandler<true>(ourFrame, opcode);
     return;
   }
 
   //***************************************************************************
-  ZilchVirtualInstruction(RelativeGoTo)
+  ZilchInlineVirtualInstruction(RelativeGoTo)
   {
     // Validate the timeout (this will throw an exception if we go beyond the time we need to)
     // This only really needs to be ran in jumps
@@ -1049,7 +1052,7 @@ namespace Zilch
   }
 
   //***************************************************************************
-  ZilchVirtualInstruction(Return)
+  ZilchInlineVirtualInstruction(Return)
   {
   }
 
@@ -1668,6 +1671,68 @@ namespace Zilch
     #undef ZilchEnumValue
   }
 
+  //***************************************************************************
+  // After each instruction in the threaded loop, a return leaves the function and a backwards
+  // jump (the end of every loop) checks if a debugger was attached while we were running
+  // The instruction comparisons are constant, so each handler only keeps the check it needs
+  #define ZilchThreadedInstructionEnd(Name)                                                              \
+    if (Instruction::Name == Instruction::Return)                                                       \
+      return true;                                                                                      \
+    if (Instruction::Name == Instruction::RelativeGoTo && state->EnableDebugEvents)                     \
+      return false;
+
+  //***************************************************************************
+  bool VirtualMachine::ExecuteThreaded(ExecutableState* state, Call& call, ExceptionReport& report, size_t& programCounter, PerFrameData* ourFrame, const byte* compactedOpcode)
+  {
+  #ifdef ZilchSupportsComputedGoto
+    // Every instruction has a label (in the same order as the enum) that runs its handler and
+    // then jumps straight to the label of the next opcode, rather than back to a single dispatch
+    static void* const InstructionLabels[Instruction::Count] =
+    {
+      #define ZilchEnumValue(Name) &&Label##Name,
+      #include "InstructionsEnum.inl"
+      #undef ZilchEnumValue
+    };
+
+    #define ZilchDispatchNext() goto *InstructionLabels[((const Opcode*)(compactedOpcode + programCounter))->Instruction]
+
+    ZilchDispatchNext();
+
+    #define ZilchEnumValue(Name)                                                                         \
+      Label##Name:                                                                                      \
+      {                                                                                                 \
+        const Opcode& opcode = *(const Opcode*)(compactedOpcode + programCounter);                      \
+        Instruction##Name(state, call, report, programCounter, ourFrame, opcode);                       \
+        ZilchThreadedInstructionEnd(Name)                                                               \
+        ZilchDispatchNext();                                                                            \
+      }
+    #include "InstructionsEnum.inl"
+    #undef ZilchEnumValue
+
+    #undef ZilchDispatchNext
+  #else
+    // Without computed goto we rely on the compiler turning the switch into a jump table
+    // (the handlers are still inlined into the cases and there are no opcode event checks)
+    ZilchLoop
+    {
+      const Opcode& opcode = *(const Opcode*)(compactedOpcode + programCounter);
+
+      switch (opcode.Instruction)
+      {
+        #define ZilchEnumValue(Name)                                                                     \
+          case Instruction::Name:                                                                       \
+          {                                                                                             \
+            Instruction##Name(state, call, report, programCounter, ourFrame, opcode);                   \
+            ZilchThreadedInstructionEnd(Name)                                                           \
+            break;                                                                                      \
+          }
+        #include "InstructionsEnum.inl"
+        #undef ZilchEnumValue
+      }
+    }
+  #endif
+  }
+
   //***************************************************************************
   void VirtualMachine::ExecuteNext(Call& call, ExceptionReport& report)
   {
@@ -1699,6 +1764,11 @@ namespace Zilch
     ZilchLastRunningFunction = ourFrame->CurrentFunction;
     ZilchLastRunningOpcodeLength = ourFrame->CurrentFunction->CompactedOpcode.Size();
 
+    // Opcode events are only sent when debug events are enabled (a debugger or opcode listener is attached)
+    // Otherwise we run the threaded loop, which never checks for them
+    if (state->EnableDebugEvents == false && ExecuteThreaded(state, call, report, programCounter, ourFrame, compactedOpcode))
+      return;
+
     // Loop through all the opcodes in the function
     // We don't need to check for the end since the return opcode will exit this function
     ZilchLoop
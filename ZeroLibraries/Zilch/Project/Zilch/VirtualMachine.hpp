@@ -19,6 +19,11 @@ namespace Zilch
     // Execute a function, starting from a given stack frame
     static void ExecuteNext(Call& call, ExceptionReport& report);
 
+    // Runs the current frame's opcodes without sending opcode events (used when debug events are off)
+    // Returns false if debug events were turned on part way through, leaving the program counter
+    // on the next opcode so the instrumented loop in ExecuteNext can carry on from there
+    static bool ExecuteThreaded(ExecutableState* state, Call& call, ExceptionReport& report, size_t& programCounter, PerFrameData* ourFrame, const byte* compactedOpcode);
+
     // Return the value of an enum property (the user data Contains the value)
     static void EnumerationProperty(Call& call, ExceptionReport& report);
 